@@ -10,16 +10,94 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #include "dom/core/document.hh"
 #include "dom/core/element.hh"
 
 #include "html/elements.hh"
 #include "html_parser/parser.hh"
+#include "html_parser/tokenize.hh"
+#include "html_parser/tree_events.hh"
+
+
+enum parse_mode {
+  PARSE_SERIAL,
+  PARSE_PIPELINED,
+  PARSE_CHUNKED,
+  /* no tree at all */
+  PARSE_TOKENIZE,
+  PARSE_EVENTS,
+};
+
+
+/*
+ * Counts nodes, and how deep elements nest
+ */
+class TreeEventCounter final : public TreeEventHandler {
+  public:
+    size_t n_elements = 0;
+    size_t n_texts    = 0;
+    size_t n_comments = 0;
+
+    size_t depth     = 0;
+    size_t max_depth = 0;
+
+
+  public:
+    void doctype([[maybe_unused]] struct doctype_token const *doctype) override { }
+
+    void
+    open_element([[maybe_unused]] DOM::Element const *element,
+                 [[maybe_unused]] DOM::Node const *parent,
+                 [[maybe_unused]] struct tag_token const *tag) override
+    {
+      this->n_elements++;
+      this->max_depth = std::max(this->max_depth, ++this->depth);
+    }
+
+    void close_element([[maybe_unused]] DOM::Element const *element) override { this->depth--; }
+
+    void
+    text([[maybe_unused]] DOM::Node const *parent,
+         [[maybe_unused]] std::string_view data) override
+    {
+      this->n_texts++;
+    }
+
+    void
+    comment([[maybe_unused]] DOM::Node const *parent,
+            [[maybe_unused]] std::string_view data) override
+    {
+      this->n_comments++;
+    }
+
+    void
+    move_element([[maybe_unused]] DOM::Element const *element,
+                 [[maybe_unused]] DOM::Node const *new_parent) override { }
+
+    void
+    move_children([[maybe_unused]] DOM::Element const *from,
+                  [[maybe_unused]] DOM::Element const *to) override { }
+};
 
 
 [[noreturn]] static void die(char const *errstr, ...);
 [[noreturn]] static void usage(char const *argv0);
+static unsigned parse_workers(char const *arg, char const *argv0);
+static std::shared_ptr< DOM::Document> new_document(void);
+static int parse_file(std::shared_ptr< DOM::Document> document, char const *file_path,
+                      ParseErrorSink *errors, enum parse_mode mode = PARSE_SERIAL,
+                      unsigned n_workers = 0);
+static void parse_stdin(std::shared_ptr< DOM::Document> document, ParseErrorSink *errors);
+static void parse_files(char *const *file_paths, size_t n_files, unsigned n_workers);
+static void print_parse_errors(ParseErrorSink const *errors);
+static void print_token_counts(TokenCounter const *counter);
 
 
 [[noreturn]]
@@ -40,42 +118,250 @@ die(char const *errstr, ...)
 static void
 usage(char const *argv0)
 {
-  die("usage: %s [file]\n", argv0);
+  die("usage: %s [file | -]\n"
+      "       %s -p file\n"
+      "       %s -c workers file\n"
+      "       %s -t file\n"
+      "       %s -e file\n"
+      "       %s -j workers file...\n", argv0, argv0, argv0, argv0, argv0, argv0);
 }
 
 
-int
-main(int argc, char *argv[])
+static unsigned
+parse_workers(char const *arg, char const *argv0)
 {
-  if (argc != 2)
-    usage(argv[0]);
+  char *end;
+  long n_workers = strtol(arg, &end, 10);
+
+  if (*end != '\0' || n_workers < 1)
+    usage(argv0);
+
+  return static_cast<unsigned>(n_workers);
+}
+
+
+static std::shared_ptr< DOM::Document>
+new_document(void)
+{
+  std::shared_ptr< DOM::Document> document =
+   std::make_shared<DOM::Document>(DOM_DOCUMENT_FORMAT_HTML, DOM_NODE_ALLOCATION_ARENA);
+  document->node_document = std::static_pointer_cast<DOM::Document>(document->shared_from_this());
+
+  return document;
+}
 
-  char const *file_path = argv[1];
 
+/*
+ * Returns -1 (having said why) if the file couldn't be read; n_workers only
+ * matters to PARSE_CHUNKED
+ */
+static int
+parse_file(std::shared_ptr< DOM::Document> document, char const *file_path,
+           ParseErrorSink *errors, enum parse_mode mode, unsigned n_workers)
+{
   int fd = open(file_path, O_RDONLY);
-  if (fd == -1)
-    die("error: couldn't open file '%s'\n", file_path);
+  if (fd == -1) {
+    fprintf(stderr, "error: couldn't open file '%s'\n", file_path);
+    return -1;
+  }
 
   struct stat st;
-  if (fstat(fd, &st) == -1)
-    die("error: couldn't stat file '%s'\n", file_path);
+  if (fstat(fd, &st) == -1) {
+    fprintf(stderr, "error: couldn't stat file '%s'\n", file_path);
+    close(fd);
+    return -1;
+  }
 
   size_t file_size = st.st_size;
-  char *file_data = static_cast<char *>(mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
 
-  if (file_data == static_cast<char *>(MAP_FAILED))
-    die("error: couldn't map file '%s'\n", file_path);
+  /* can't map nothing */
+  if (file_size == 0) {
+    close(fd);
+    html_parse_document(document, "", 0, errors);
+    return 0;
+  }
 
+  char *file_data = static_cast<char *>(mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0));
   close(fd);
+
+  if (file_data == static_cast<char *>(MAP_FAILED)) {
+    fprintf(stderr, "error: couldn't map file '%s'\n", file_path);
+    return -1;
+  }
+
   madvise(file_data, file_size, MADV_SEQUENTIAL);
 
-  std::shared_ptr< DOM::Document> document = std::make_shared<DOM::Document>(DOM_DOCUMENT_FORMAT_HTML);
-  document->node_document = std::static_pointer_cast<DOM::Document>(document->shared_from_this());
+  switch (mode) {
+    case PARSE_SERIAL:
+      html_parse_document(document, file_data, file_size, errors);
+      break;
+
+    case PARSE_PIPELINED:
+      html_parse_document_pipelined(document, file_data, file_size, errors);
+      break;
+
+    case PARSE_CHUNKED:
+      html_parse_document_chunked(document, file_data, file_size, n_workers, errors);
+      break;
 
-  html_parse_document(document, file_data, file_size);
+    case PARSE_TOKENIZE: {
+      TokenCounter counter;
+      html_tokenize(&counter, file_data, file_size, errors);
+      print_token_counts(&counter);
+      break;
+    }
 
-  if (munmap(file_data, file_size) == -1)
-    die("error: couldn't unmap file '%s'\n", file_path);
+    case PARSE_EVENTS: {
+      TreeEventCounter counter;
+      html_parse_events(&counter, file_data, file_size, errors);
+      printf("elements: %zu\ntext events: %zu\ncomments: %zu\nmax depth: %zu\n",
+             counter.n_elements, counter.n_texts, counter.n_comments, counter.max_depth);
+      break;
+    }
+  }
+
+  if (munmap(file_data, file_size) == -1) {
+    fprintf(stderr, "error: couldn't unmap file '%s'\n", file_path);
+    return -1;
+  }
+
+  return 0;
+}
+
+
+/*
+ * Pipes and sockets can't be mapped, so stream them into the parser instead
+ */
+static void
+parse_stdin(std::shared_ptr< DOM::Document> document, ParseErrorSink *errors)
+{
+  char chunk[65536];
+  ssize_t chunk_len;
+  HTMLParser *parser = html_parser_open(document, errors);
+
+  while ((chunk_len = read(STDIN_FILENO, chunk, sizeof (chunk))) != 0) {
+    if (chunk_len == -1)
+      die("error: couldn't read from stdin\n");
+
+    html_parser_feed(parser, chunk, static_cast<size_t>(chunk_len));
+  }
+
+  html_parser_finish(parser);
+}
+
+
+/*
+ * Each worker takes the next file off the list until there are none left,
+ * parsing every one of them into a document of its own. Results are printed
+ * in the order of the list once all the workers are done.
+ */
+static void
+parse_files(char *const *file_paths, size_t n_files, unsigned n_workers)
+{
+  struct result {
+    int status = -1;
+    size_t n_parse_errors = 0;
+  };
+
+  std::vector< struct result> results(n_files);
+  std::atomic< size_t> next_file = 0;
+
+  auto work = [&](void) {
+    size_t i;
+
+    while ((i = next_file.fetch_add(1, std::memory_order_relaxed)) < n_files) {
+      ParseErrorSink errors(PARSE_ERRORS_COUNT);
+
+      results[i].status = parse_file(new_document(), file_paths[i], &errors);
+      results[i].n_parse_errors = errors.total();
+    }
+  };
+
+  std::vector< std::thread> workers;
+  workers.reserve(n_workers);
+
+  for (unsigned w = 0; w < n_workers; w++)
+    workers.emplace_back(work);
+
+  for (std::thread& worker : workers)
+    worker.join();
+
+  for (size_t i = 0; i < n_files; i++) {
+    if (results[i].status == 0)
+      printf("%s: %zu parse errors\n", file_paths[i], results[i].n_parse_errors);
+    else
+      printf("%s: failed\n", file_paths[i]);
+  }
+}
+
+
+static void
+print_parse_errors(ParseErrorSink const *errors)
+{
+  for (auto const& error : errors->errors())
+    fprintf(stderr, "%zu: %s\n", error.offset, parse_error_name(error.code));
+
+  if (errors->total() > errors->errors().size())
+    fprintf(stderr, "(%zu more parse errors)\n", errors->total() - errors->errors().size());
+}
+
+
+static void
+print_token_counts(TokenCounter const *counter)
+{
+  /* in the order of enum token_type */
+  static char const *const token_type_names[NUM_TOKEN_TYPES] = {
+    "character",
+    "whitespace",
+    "character run",
+    "doctype",
+    "start tag",
+    "end tag",
+    "comment",
+    "EOF",
+  };
+
+  for (size_t type = 0; type < NUM_TOKEN_TYPES; type++)
+    printf("%s tokens: %zu\n", token_type_names[type], counter->counts[type]);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  enum parse_mode mode = PARSE_SERIAL;
+  unsigned n_workers = 0;
+
+  if (argc >= 4 && !strcmp(argv[1], "-j")) {
+    parse_files(argv + 3, argc - 3, parse_workers(argv[2], argv[0]));
+    return 0;
+  } else if (argc == 4 && !strcmp(argv[1], "-c")) {
+    mode = PARSE_CHUNKED;
+    n_workers = parse_workers(argv[2], argv[0]);
+  } else if (argc == 3 && !strcmp(argv[1], "-p")) {
+    mode = PARSE_PIPELINED;
+  } else if (argc == 3 && !strcmp(argv[1], "-t")) {
+    mode = PARSE_TOKENIZE;
+  } else if (argc == 3 && !strcmp(argv[1], "-e")) {
+    mode = PARSE_EVENTS;
+  } else if (argc != 2) {
+    usage(argv[0]);
+  }
+
+  char const *file_path = argv[argc - 1];
+  ParseErrorSink errors(PARSE_ERRORS_COLLECT);
+  std::shared_ptr< DOM::Document> document = new_document();
+
+  if (!strcmp(file_path, "-") && mode == PARSE_SERIAL) {
+    parse_stdin(document, &errors);
+    print_parse_errors(&errors);
+    return 0;
+  }
+
+  if (parse_file(document, file_path, &errors, mode, n_workers) == -1)
+    exit(1);
+
+  print_parse_errors(&errors);
 
 
   printf("Document instance size: %zu\n", sizeof (DOM::Document));
@@ -85,4 +371,3 @@ main(int argc, char *argv[])
 
   return 0;
 }
-
@@ -1,11 +1,16 @@
 # Customize below to fit your system
 
 CXX      =  g++
+PYTHON   =  python3
 CXXFLAGS =
 CXXFLAGS += -std=c++20
 CXXFLAGS += -Wall -Wextra -pedantic -O2
 CXXFLAGS += -ggdb3
 CXXFLAGS += -march=native -ftree-vectorize
+# tokenizer engine: computed goto (GCC/Clang) instead of the handler table
+CXXFLAGS += -DTOKENIZER_THREADED_DISPATCH
+# parser tracing on stderr (one line per token and insertion mode, at least)
+# CXXFLAGS += -DHTML_PARSER_DEBUG
 # CXXFLAGS += $(shell pkg-config --cflags libgrapheme)
 # CXXFLAGS += --coverage
 # LDFLAGS = --coverage -lgcov
@@ -16,5 +21,7 @@ CXXFLAGS += -march=native -ftree-vectorize
 # CFLAGS_GRAPHEME =
 LIBS_GRAPHEME = -lgrapheme
 LIBS_INFRA = -linfra
-LIBS = $(LIBS_INFRA) $(LIBS_GRAPHEME)
+# worker pool of browser/main.cc
+LIBS_THREADS = -pthread
+LIBS = $(LIBS_INFRA) $(LIBS_GRAPHEME) $(LIBS_THREADS)
 
@@ -1,11 +1,14 @@
 #ifndef _queequeg_dom_character_data_hh_
 #define _queequeg_dom_character_data_hh_
 
-#include <string>
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 
 
 #include "dom/core/node.hh"
+#include "dom/core/document.hh"
 
 
 namespace DOM {
@@ -18,16 +21,16 @@ class CharacterData : public DOM::Node {
   protected:
     CharacterData(std::shared_ptr< DOM::Document> node_document,
                   enum dom_node_type node_type,
-                  std::string data = "")
-  : DOM::Node(node_document, node_type)
-  {
-    this->data = data;
-  }
+                  std::string_view data = { })
+  : DOM::Node(node_document, node_type),
+    data(data, (node_document != nullptr) ? node_document->node_memory_resource()
+                                          : std::pmr::get_default_resource()) { }
   public:
     virtual ~CharacterData() = default;
 
   public:
-    std::string data;
+    /* allocated alongside the node, see Document::node_memory_resource() */
+    std::pmr::string data;
 };
 
 
@@ -2,8 +2,8 @@
 #define _queequeg_dom_comment_hh_
 
 
-#include <string>
 #include <memory>
+#include <string_view>
 
 
 #include "dom/core/character_data.hh"
@@ -18,7 +18,7 @@ class Document;
 class Comment : public DOM::CharacterData {
   public:
     Comment(std::shared_ptr< DOM::Document> node_document,
-            std::string data = "")
+            std::string_view data = { })
   : DOM::CharacterData(node_document, DOM_NODETYPE_COMMENT, data) { }
     virtual ~Comment() = default;
 };
@@ -15,9 +15,13 @@
 namespace DOM {
 
 
-Document::Document(enum dom_document_format format)
+Document::Document(enum dom_document_format format,
+                   enum dom_node_allocation node_allocation)
 : DOM::Node(nullptr, DOM_NODETYPE_DOCUMENT)
 {
+  if (node_allocation == DOM_NODE_ALLOCATION_ARENA)
+    this->node_arena_ = std::make_shared<NodeArena>();
+
   // this->node_document = std::static_pointer_cast<DOM_Document>(this->shared_from_this());
   /*
    * can't be called in constructor...
@@ -53,8 +57,7 @@ DOM::Document::create_element(uint16_t local_name,
      std::dynamic_pointer_cast<DOM::Document>(this->shared_from_this());
 
     /* XXX: element interface */
-    result = std::dynamic_pointer_cast<DOM::Element>(std::shared_ptr<DOM::HTMLElement>(
-              HTML::new_element_with_index(document, local_name)));
+    result = HTML::new_element_with_index(document, local_name);
 
     result->custom_state = DOM_CESTATE_UNCUSTOMIZED;
     result->custom_definition = nullptr;
@@ -67,5 +70,43 @@ DOM::Document::create_element(uint16_t local_name,
 }
 
 
-} /* namespace DOM */
+[[nodiscard]]
+uint16_t
+DOM::Document::intern_local_name(std::string_view name)
+{
+  auto it = this->custom_local_names_.find(std::string(name));
+
+  if (it != this->custom_local_names_.end())
+    return it->second;
+
+  size_t index = HTML_ELEMENT_CUSTOM_RANGE_BEGIN_ + this->custom_local_names_by_index_.size();
+
+  /* out of indices: the last one stands for all the names that didn't get one */
+  if (index > HTML_ELEMENT_CUSTOM_RANGE_END_)
+    return HTML_ELEMENT_CUSTOM_RANGE_END_;
+
+  it = this->custom_local_names_.emplace(std::string(name), static_cast<uint16_t>(index)).first;
+  this->custom_local_names_by_index_.push_back(it->first);
+
+  return it->second;
+}
 
+
+[[nodiscard]]
+std::string_view
+DOM::Document::local_name_string(uint16_t local_name) const
+{
+  if (local_name > HTML_ELEMENT_NONE_ && local_name < NUM_HTML_BUILTIN_ELEMENTS)
+    return HTML::k_local_names[local_name];
+
+  size_t i = local_name - HTML_ELEMENT_CUSTOM_RANGE_BEGIN_;
+
+  if (local_name >= HTML_ELEMENT_CUSTOM_RANGE_BEGIN_
+   && i < this->custom_local_names_by_index_.size())
+    return this->custom_local_names_by_index_[i];
+
+  return { };
+}
+
+
+} /* namespace DOM */
@@ -8,10 +8,17 @@
  */
 
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <infra/namespace.h>
 
 #include "dom/core/node.hh"
+#include "dom/core/node_arena.hh"
 
 
 enum dom_document_format {
@@ -42,6 +49,18 @@ enum dom_document_parser_status {
 };
 
 
+/*
+ * Queequeg extension; where the document's nodes get allocated. With an arena,
+ * they are all freed at once when the document and the last of its nodes
+ * are gone, which is much cheaper for documents that are parsed and then
+ * thrown away as a whole.
+ */
+enum dom_node_allocation {
+  DOM_NODE_ALLOCATION_HEAP,
+  DOM_NODE_ALLOCATION_ARENA,
+};
+
+
 namespace DOM {
 
 
@@ -51,7 +70,8 @@ class Element;
 
 class Document : public DOM::Node {
   public:
-    Document(enum dom_document_format format = DOM_DOCUMENT_FORMAT_HTML);
+    Document(enum dom_document_format format = DOM_DOCUMENT_FORMAT_HTML,
+             enum dom_node_allocation node_allocation = DOM_NODE_ALLOCATION_HEAP);
     virtual ~Document() = default;
 
   public:
@@ -68,6 +88,52 @@ class Document : public DOM::Node {
                                                                 void *prefix = nullptr,
                                                                 void *is = nullptr,
                                                                 bool sync_custom_elements = false);
+
+    /*
+     * Queequeg extension; names that aren't those of a built-in element get an
+     * index of their own in HTML_ELEMENT_CUSTOM_RANGE_BEGIN_ and up, the same
+     * for every element of this document with that name.
+     */
+    [[nodiscard]] uint16_t intern_local_name(std::string_view name);
+    [[nodiscard]] std::string_view local_name_string(uint16_t local_name) const;
+
+
+    /*
+     * Allocates a node of this document (args are T's constructor's) along
+     * with its shared_ptr control block
+     */
+    template< typename T, typename... Args>
+    [[nodiscard]]
+    inline std::shared_ptr< T>
+    create_node(Args&&... args)
+    {
+      if (this->node_arena_ != nullptr)
+        return std::allocate_shared<T>(NodeArenaAllocator<T>(this->node_arena_),
+                                       std::forward<Args>(args)...);
+
+      return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+    /*
+     * For the nodes' own buffers (e.g. character data)
+     */
+    [[nodiscard]]
+    inline std::pmr::memory_resource *
+    node_memory_resource(void) const
+    {
+      if (this->node_arena_ != nullptr)
+        return this->node_arena_.get();
+
+      return std::pmr::get_default_resource();
+    }
+
+
+  private:
+    std::shared_ptr< NodeArena> node_arena_ = nullptr;
+
+    std::unordered_map< std::string, uint16_t> custom_local_names_ = { };
+    /* by index - HTML_ELEMENT_CUSTOM_RANGE_BEGIN_; views of the keys above */
+    std::vector< std::string_view> custom_local_names_by_index_ = { };
 };
 
 
@@ -39,6 +39,17 @@ class Element : public DOM::Node {
     void *custom_definition;
     enum dom_custom_element_state custom_state = DOM_CESTATE_UNDEFINED;
 
+    /*
+     * Where the HTML parser has this element on its stack of open elements
+     * and in its list of active formatting elements (-1 if it hasn't), so it
+     * doesn't have to search either of them. Only the parser's own bookkeeping
+     * should write to these.
+     */
+    struct {
+      int32_t open_element = -1;
+      int32_t formatting   = -1;
+    } parser_index;
+
 
   public:
     inline bool
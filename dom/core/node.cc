@@ -5,6 +5,7 @@
  */
 #include <memory>
 #include <algorithm>
+#include <vector>
 
 #include "dom/core/node.hh"
 
@@ -20,39 +21,87 @@ Node::Node(std::shared_ptr< DOM::Document> node_document,
 }
 
 
-std::shared_ptr< DOM::Node>
-Node::get_previous_sibling(void)
+/*
+ * Tears the subtree down with a worklist instead of letting every node's
+ * destructor release its children, which would recurse as deep as the tree
+ * (and as long as the sibling chains). Every node we take off the list has
+ * its links cut before it goes, so that its own destructor has nothing left
+ * to do. Nodes that somebody else still holds keep their children.
+ */
+Node::~Node()
 {
-  if (this->parent_node.lock() == nullptr)
-    return nullptr;
-
-  for (std::shared_ptr< Node> cur_node =
-        std::dynamic_pointer_cast<Node>(this->shared_from_this());
-       cur_node->parent_node.lock() != nullptr;
-       cur_node = cur_node->parent_node.lock())
-  {
-    std::shared_ptr< Node> cur_parent = cur_node->parent_node.lock();
-
-    if (cur_parent->child_nodes.front() == cur_node) {
-      /*
-       * No other node precedes the current one in the parent's list of children
-       */
-      continue;
+  if (this->first_child_ == nullptr)
+    return;
+
+  std::vector< std::shared_ptr< Node>> worklist;
+
+  worklist.push_back(std::move(this->first_child_));
+  this->last_child_ = nullptr;
+
+  while (! worklist.empty()) {
+    std::shared_ptr< Node> node = std::move(worklist.back());
+    worklist.pop_back();
+
+    if (node->next_sibling_ != nullptr)
+      worklist.push_back(std::move(node->next_sibling_));
+
+    node->previous_sibling_ = nullptr;
+
+    if (node.use_count() == 1 && node->first_child_ != nullptr) {
+      worklist.push_back(std::move(node->first_child_));
+      node->last_child_ = nullptr;
     }
+  }
+}
 
 
-    /* XXX: ugly; also kinda hacky */
+size_t
+Node::get_index(void) const
+{
+  std::shared_ptr< Node> parent = this->parent_node.lock();
 
-    int i;
+  if (parent == nullptr)
+    return 0;
 
-    for (i = 0; i < static_cast<long int>(cur_parent->child_nodes.size()); i++)
-      if (cur_parent->child_nodes[i] == cur_node)
-        break;
+  if (this->index_epoch_ != parent->children_epoch_) {
+    size_t index = 0;
 
-    return cur_parent->child_nodes[i - 1];
+    for (Node *child = parent->get_first_child(); child != nullptr; child = child->get_next_sibling()) {
+      child->index_ = index++;
+      child->index_epoch_ = parent->children_epoch_;
+    }
   }
 
-  return nullptr;
+  return this->index_;
+}
+
+
+/*
+ * Unlinks child and hands back the reference its previous sibling (or we)
+ * held to it.
+ */
+std::shared_ptr< Node>
+Node::remove_child_(Node *child)
+{
+  Node *prev = child->previous_sibling_;
+  std::shared_ptr< Node>& link = (prev != nullptr) ? prev->next_sibling_ : this->first_child_;
+  std::shared_ptr< Node> removed = std::move(link);
+
+  if (child->next_sibling_ != nullptr)
+    child->next_sibling_->previous_sibling_ = prev;
+  else
+    this->last_child_ = prev;
+
+  link = std::move(child->next_sibling_);
+  child->previous_sibling_ = nullptr;
+  child->parent_node.reset();
+  child->index_epoch_ = 0;
+
+  /* only the following siblings moved */
+  if (link != nullptr && ++this->children_epoch_ == 0)
+    this->children_epoch_ = 1;
+
+  return removed;
 }
 
 
@@ -63,17 +112,36 @@ Node::insert_node(std::shared_ptr< Node> node,
 {
   (void) supp_observers_flag;
 
-  std::shared_ptr< Node> parent = std::static_pointer_cast<Node>(this->shared_from_this());
+  /* XXX: the rest of "adopt" */
+  if (std::shared_ptr< Node> old_parent = node->parent_node.lock(); old_parent != nullptr)
+    old_parent->remove_child_(node.get());
+
+  node->parent_node = this->share_node();
 
   if (child == nullptr) {
-    parent->child_nodes.push_back(node);
+    Node *last = this->last_child_;
+
+    node->previous_sibling_ = last;
+
+    /* appending doesn't move anybody, so the cached indices stay valid */
+    if (last != nullptr && last->index_epoch_ == this->children_epoch_) {
+      node->index_ = last->index_ + 1;
+      node->index_epoch_ = this->children_epoch_;
+    }
+
+    this->last_child_ = node.get();
+    ((last != nullptr) ? last->next_sibling_ : this->first_child_) = std::move(node);
   } else {
-    auto it =
-     std::find(parent->child_nodes.begin(), parent->child_nodes.end(), child);
+    Node *prev = child->previous_sibling_;
+
+    node->previous_sibling_ = prev;
+    child->previous_sibling_ = node.get();
+    node->next_sibling_ = std::move(child);
+    ((prev != nullptr) ? prev->next_sibling_ : this->first_child_) = std::move(node);
 
-    parent->child_nodes.insert(it, node);
+    if (++this->children_epoch_ == 0)
+      this->children_epoch_ = 1;
   }
-  node->parent_node = parent;
 
   /* ... */
 }
@@ -2,9 +2,10 @@
 #define _queequeg_dom_node_hh_
 
 #include <cstddef>
-#include <vector>
 #include <memory>
 
+#include <stdint.h>
+
 #include "dom/events/event_target.hh"
 
 #include "qglib/iterator.hh"
@@ -40,27 +41,68 @@ class Node : public DOM::EventTarget {
     Node(std::shared_ptr< Document> node_document,
          enum dom_node_type node_type);
   public:
-    virtual ~Node() = default;
+    virtual ~Node();
 
   public:
     std::weak_ptr< Document> node_document;
     enum dom_node_type node_type;
 
     std::weak_ptr< Node> parent_node;
-    std::vector< std::shared_ptr< Node>> child_nodes;
 
     inline bool is_element(void) const;
     inline bool is_text(void) const;
     inline bool is_document(void) const;
 
 
-    std::shared_ptr< Node> get_previous_sibling(void);
+    /*
+     * Children are kept in a doubly-linked list; a node owns its first child
+     * and its next sibling, the other two links are plain pointers.
+     */
+    [[nodiscard]] inline Node *get_first_child(void) const { return this->first_child_.get(); }
+    [[nodiscard]] inline Node *get_last_child(void) const { return this->last_child_; }
+    [[nodiscard]] inline Node *get_next_sibling(void) const { return this->next_sibling_.get(); }
+    [[nodiscard]] inline Node *get_previous_sibling(void) const { return this->previous_sibling_; }
+    [[nodiscard]] inline bool has_child_nodes(void) const { return (this->first_child_ != nullptr); }
+
+    /*
+     * Position among the parent's children. Cached, and only recomputed (for
+     * all siblings at once) after a child got inserted before others or
+     * removed.
+     */
+    [[nodiscard]] size_t get_index(void) const;
+
+    [[nodiscard]]
+    inline std::shared_ptr< Node>
+    share_node(void)
+    {
+      return std::static_pointer_cast<Node>(this->shared_from_this());
+    }
 
     void insert_node(std::shared_ptr< Node> node,
                      std::shared_ptr< Node> child,
                      bool supp_observers = false);
 
     void append_node(std::shared_ptr< Node> node, bool supp_observers = false);
+
+
+  private:
+    std::shared_ptr< Node> remove_child_(Node *child);
+
+
+  private:
+    std::shared_ptr< Node> first_child_ = nullptr;
+    Node *last_child_ = nullptr;
+
+    std::shared_ptr< Node> next_sibling_ = nullptr;
+    Node *previous_sibling_ = nullptr;
+
+    /*
+     * A child's cached index is valid while its index_epoch_ matches its
+     * parent's children_epoch_; 0 means never.
+     */
+    uint32_t children_epoch_ = 1;
+    mutable uint32_t index_epoch_ = 0;
+    mutable size_t index_ = 0;
 };
 
 
@@ -90,7 +132,7 @@ struct TreeNodeDFSIterator {
 
 
   TreeNodeDFSIterator(void) = default;
-  TreeNodeDFSIterator(const TreeNodeDFSIterator& it);
+  TreeNodeDFSIterator(const TreeNodeDFSIterator& it) = default;
 
   ~TreeNodeDFSIterator() = default;
 
@@ -108,15 +150,14 @@ struct TreeNodeDFSIterator {
 
 
   private:
-    void fall_through_branch_(void);
-
-    using ChainLink_ = struct {
-      std::vector< std::shared_ptr< DOM::Node>>::iterator cur;
-      std::vector< std::shared_ptr< DOM::Node>>::iterator end;
-    };
-
-    std::vector< std::shared_ptr< DOM::Node>> root_vec_;
-    std::vector< ChainLink_> chain_ = { };
+    static DOM::Node *first_leaf_(DOM::Node *node);
+
+    /*
+     * Children come before their parent; the root is the last node visited
+     * and nullptr stands for the end.
+     */
+    std::shared_ptr< DOM::Node> root_ = nullptr;
+    DOM::Node *cur_ = nullptr;
 };
 
 static_assert(std::forward_iterator<TreeNodeDFSIterator>);
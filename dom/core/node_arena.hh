@@ -0,0 +1,118 @@
+#ifndef _queequeg_dom_node_arena_hh_
+#define _queequeg_dom_node_arena_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ */
+
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+#include <stddef.h>
+
+
+namespace DOM {
+
+
+/*
+ * Bump allocator for the nodes of a document and their character data.
+ * Nothing is given back before the arena itself goes away; every node
+ * allocated in it holds a reference to it, so that happens once the last of
+ * them is gone.
+ *
+ * Not thread-safe, just like the document it belongs to.
+ */
+class NodeArena final : public std::pmr::memory_resource {
+  public:
+    static constexpr size_t k_default_initial_size = 64 * 1024;
+
+    explicit NodeArena(size_t initial_size = k_default_initial_size)
+    : buffer_(initial_size) { }
+
+    NodeArena(NodeArena const& other) = delete;
+    NodeArena& operator=(NodeArena const& other) = delete;
+
+    ~NodeArena() = default;
+
+
+  private:
+    void *
+    do_allocate(size_t bytes, size_t alignment) override
+    {
+      return this->buffer_.allocate(bytes, alignment);
+    }
+
+    void
+    do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+      (void) p;
+      (void) bytes;
+      (void) alignment;
+    }
+
+    bool
+    do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+      return (this == &other);
+    }
+
+
+  private:
+    std::pmr::monotonic_buffer_resource buffer_;
+};
+
+
+/*
+ * For std::allocate_shared(); the control block keeps a copy, and with it the
+ * arena, alive until the node is deallocated.
+ */
+template< typename T>
+class NodeArenaAllocator final {
+  public:
+    using value_type = T;
+
+    explicit NodeArenaAllocator(std::shared_ptr< NodeArena> arena) noexcept
+    : arena_(std::move(arena)) { }
+
+    template< typename U>
+    NodeArenaAllocator(NodeArenaAllocator< U> const& other) noexcept
+    : arena_(other.arena()) { }
+
+
+  public:
+    [[nodiscard]]
+    inline T *
+    allocate(size_t n)
+    {
+      return static_cast<T *>(this->arena_->allocate(n * sizeof (T), alignof (T)));
+    }
+
+    inline void
+    deallocate(T *p, size_t n) noexcept
+    {
+      this->arena_->deallocate(p, n * sizeof (T), alignof (T));
+    }
+
+    [[nodiscard]] inline std::shared_ptr< NodeArena> const& arena(void) const { return this->arena_; }
+
+
+    template< typename U>
+    friend inline bool
+    operator==(NodeArenaAllocator const& lhs, NodeArenaAllocator< U> const& rhs) noexcept
+    {
+      return (lhs.arena() == rhs.arena());
+    }
+
+
+  private:
+    std::shared_ptr< NodeArena> arena_;
+};
+
+
+} /* namespace DOM */
+
+
+#endif /* !defined(_queequeg_dom_node_arena_hh_) */
@@ -2,8 +2,8 @@
 #define _queequeg_dom_text_hh_
 
 
-#include <string>
 #include <memory>
+#include <string_view>
 
 
 #include "dom/core/character_data.hh"
@@ -18,7 +18,7 @@ class Document;
 class Text : public DOM::CharacterData {
   public:
     Text(std::shared_ptr< DOM::Document> document,
-         std::string data = "")
+         std::string_view data = { })
   : DOM::CharacterData(document, DOM_NODETYPE_TEXT, data) { }
     virtual ~Text() = default;
 };
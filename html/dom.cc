@@ -1,8 +1,10 @@
+#include "dom/core/document.hh"
 #include "dom/html/html_element.hh"
 
 #include "dom/html/html_html_element.hh"
 #include "dom/html/html_head_element.hh"
 #include "dom/html/html_script_element.hh"
+#include "dom/html/html_unknown_element.hh"
 
 #include "html/elements.hh"
 
@@ -10,12 +12,10 @@
 namespace HTML {
 
 
-DOM::HTMLElement *
+std::shared_ptr< DOM::HTMLElement>
 new_element_with_index(std::shared_ptr< DOM::Document> document,
                        uint16_t local_name)
 {
-  (void) document;
-
   if (local_name > 0 && local_name < NUM_HTML_BUILTIN_ELEMENTS)
   {
     switch (local_name)
@@ -34,7 +34,7 @@ new_element_with_index(std::shared_ptr< DOM::Document> document,
       case HTML_ELEMENT_CENTER:   case HTML_ELEMENT_NOBR:      case HTML_ELEMENT_NOEMBED:
       case HTML_ELEMENT_NOFRAMES: case HTML_ELEMENT_PLAINTEXT: case HTML_ELEMENT_RB:
       case HTML_ELEMENT_RTC:      case HTML_ELEMENT_STRIKE:    case HTML_ELEMENT_TT: {
-        return new DOM::HTMLElement(document, INFRA_NAMESPACE_HTML, local_name);
+        return document->create_node<DOM::HTMLElement>(document, INFRA_NAMESPACE_HTML, local_name);
       }
 
 
@@ -51,19 +51,19 @@ new_element_with_index(std::shared_ptr< DOM::Document> document,
        * section.
        */
       case HTML_ELEMENT_HTML: {
-        return new DOM::HTMLHtmlElement(document, INFRA_NAMESPACE_HTML, local_name);
+        return document->create_node<DOM::HTMLHtmlElement>(document, INFRA_NAMESPACE_HTML, local_name);
       }
 
 
       case HTML_ELEMENT_HEAD: {
-        return new DOM::HTMLHeadElement(document, INFRA_NAMESPACE_HTML, local_name);
+        return document->create_node<DOM::HTMLHeadElement>(document, INFRA_NAMESPACE_HTML, local_name);
       }
 
 
       /* ... */
 
       case HTML_ELEMENT_SCRIPT: {
-        return new DOM::HTMLScriptElement(document, INFRA_NAMESPACE_HTML, local_name);
+        return document->create_node<DOM::HTMLScriptElement>(document, INFRA_NAMESPACE_HTML, local_name);
       }
 
 
@@ -71,11 +71,15 @@ new_element_with_index(std::shared_ptr< DOM::Document> document,
 
 
       default:
-        return new DOM::HTMLElement(document, INFRA_NAMESPACE_HTML, local_name);
+        return document->create_node<DOM::HTMLElement>(document, INFRA_NAMESPACE_HTML, local_name);
     }
   }
 
-  return nullptr;
+  /*
+   * Names without a built-in element (see DOM::Document::intern_local_name), or
+   * indices nothing was ever interned as
+   */
+  return document->create_node<DOM::HTMLUnknownElement>(document, INFRA_NAMESPACE_HTML, local_name);
 }
 
 
@@ -4,8 +4,10 @@
  * See LICENSE for details
  */
 
-#include <unordered_map>
-#include <string>
+#include <array>
+#include <string_view>
+
+#include "qglib/perfect_hash.hh"
 
 #include "html/elements.hh"
 
@@ -20,7 +22,10 @@ namespace HTML {
  * XXX: for now, we just look things up right here.
  */
 
-const std::unordered_map< std::string, uint16_t> k_local_names_table = {
+static constexpr struct {
+  std::string_view name;
+  uint16_t local_name;
+} k_local_names_table_[] = {
   /* 4.1 The document element */
   { "html", HTML_ELEMENT_HTML },
 
@@ -60,6 +65,7 @@ const std::unordered_map< std::string, uint16_t> k_local_names_table = {
   { "menu", HTML_ELEMENT_MENU },
   { "li", HTML_ELEMENT_LI },
   { "dl", HTML_ELEMENT_DL },
+  { "dt", HTML_ELEMENT_DT },
   { "dd", HTML_ELEMENT_DD },
   { "figure", HTML_ELEMENT_FIGURE },
   { "figcaption", HTML_ELEMENT_FIGCAPTION },
@@ -188,5 +194,49 @@ const std::unordered_map< std::string, uint16_t> k_local_names_table = {
 };
 
 
+static constexpr std::array< std::string_view, NUM_HTML_BUILTIN_ELEMENTS>
+make_local_names(void)
+{
+  std::array< std::string_view, NUM_HTML_BUILTIN_ELEMENTS> names;
+
+  /* not "= { }": GCC 12 then refuses to read the result in constant expressions */
+  names.fill("");
+
+  for (auto const& entry : k_local_names_table_) {
+    if (! names[entry.local_name].empty())
+      throw "k_local_names_table_: duplicate element index";
+
+    names[entry.local_name] = entry.name;
+  }
+
+  for (size_t i = HTML_ELEMENT_NONE_ + 1; i < NUM_HTML_BUILTIN_ELEMENTS; i++)
+    if (names[i].empty())
+      throw "k_local_names_table_: element index without a name";
+
+  return names;
+}
+
+
+constexpr std::array< std::string_view, NUM_HTML_BUILTIN_ELEMENTS> k_local_names = make_local_names();
+
+/*
+ * 141 names over 256 slots
+ */
+static constexpr auto k_local_names_hash_ = QueequegLib::make_perfect_hash<64, 256>(k_local_names);
+
+
+[[nodiscard]]
+uint16_t
+lookup_local_name(uint32_t name_hash, std::string_view name)
+{
+  int i = k_local_names_hash_.find(name_hash);
+
+  if (i <= HTML_ELEMENT_NONE_ || k_local_names[i] != name)
+    return HTML_ELEMENT_NONE_;
+
+  return static_cast<uint16_t>(i);
+}
+
+
 } /* namespace HTML */
 
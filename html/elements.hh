@@ -1,11 +1,15 @@
 #ifndef _queequeg_html_elements_hh_
 #define _queequeg_html_elements_hh_
 
+#include <array>
 #include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <memory>
 
+#include "qglib/perfect_hash.hh"
+
 /*
  * This enumeration is used to address built-in and custom HTML elements by
  * their local index.
@@ -199,15 +203,27 @@ class HTMLElement;
 namespace HTML {
 
 
+std::shared_ptr< DOM::HTMLElement> new_element_with_index(std::shared_ptr< DOM::Document> document,
+                                                          uint16_t local_name);
+
 /*
- * The main purpose of this table is to translate tag names to element indices during
- * parsing.
- * XXX: 2-way map for later
+ * The main purpose of these is to translate tag names to element indices during
+ * parsing, and back.
  */
-DOM::HTMLElement *new_element_with_index(std::shared_ptr< DOM::Document> document,
-                                         uint16_t local_name);
+extern const std::array< std::string_view, NUM_HTML_BUILTIN_ELEMENTS> k_local_names;
 
-extern const std::unordered_map< std::string, uint16_t> k_local_names_table;
+/*
+ * Returns the index of the built-in element called name, or HTML_ELEMENT_NONE_.
+ * name_hash is QueequegLib::fnv1a(name), which callers can compute on the fly.
+ */
+[[nodiscard]] uint16_t lookup_local_name(uint32_t name_hash, std::string_view name);
+
+[[nodiscard]]
+inline uint16_t
+lookup_local_name(std::string_view name)
+{
+  return lookup_local_name(QueequegLib::fnv1a(name), name);
+}
 
 
 } /* namespace HTML */
@@ -0,0 +1,262 @@
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ */
+#include <algorithm>
+
+#include <string.h>
+
+#include <infra/ascii.h>
+
+#include "html_parser/chunked.hh"
+
+
+/*
+ * Queues a worker's tokens into its chunk
+ */
+class ChunkQueue final : public TokenQueue {
+  public:
+    ChunkQueue(BasicTokenizer< TokenQueue> *tokenizer, bool scripting,
+               std::vector< struct queued_token> *entries)
+    : TokenQueue(tokenizer, scripting), entries_(entries) { }
+
+
+  private:
+    [[nodiscard]]
+    struct queued_token *
+    reserve_(void) override
+    {
+      return &this->entries_->emplace_back();
+    }
+
+    void commit_(void) override { }
+
+
+  private:
+    std::vector< struct queued_token> *entries_;
+};
+
+
+/*
+ * The first '<' at or after p that opens a tag name right after the end of
+ * something else (most likely a tag, or a line of text); end if none.
+ * Whatever the guess, a wrong one only costs tokenizing the chunk again.
+ */
+static char const *
+chunk_boundary(char const *p, char const *begin, char const *end)
+{
+  while ((p = static_cast<char const *>(memchr(p, '<', end - p))) != nullptr) {
+    if (p > begin && end - p >= 2 && infra_ascii_is_alpha(static_cast<unsigned char>(p[1]))) {
+      switch (p[-1]) {
+        case '>': case '\n': case '\t': case ' ':
+          return p;
+        default:
+          break;
+      }
+    }
+
+    p++;
+  }
+
+  return end;
+}
+
+
+ChunkedTokenizer::ChunkedTokenizer(Tokenizer *tokenizer, TreeBuilder *treebuilder,
+                                   unsigned n_workers)
+: TokenReplay(treebuilder, tokenizer->errors)
+{
+  this->tokenizer_   = tokenizer;
+  this->input_begin_ = tokenizer->input.p;
+  this->input_end_   = tokenizer->input.end;
+  this->scripting_   = treebuilder->flags.scripting;
+  this->window_      = 2 * n_workers;
+
+  /* nobody to hand chunks to */
+  if (n_workers == 0)
+    this->chunks_.push_back({ .begin = this->input_begin_, .end = this->input_end_ });
+  else
+    this->split_();
+
+  n_workers = std::min< size_t>(n_workers, this->chunks_.size() - 1);
+  this->workers_.reserve(n_workers);
+
+  for (unsigned w = 0; w < n_workers; w++)
+    this->workers_.emplace_back([this](void){ this->work_(); });
+}
+
+
+ChunkedTokenizer::~ChunkedTokenizer()
+{
+  {
+    std::lock_guard< std::mutex> lock(this->mutex_);
+    this->stop_ = true;
+  }
+
+  this->cond_.notify_all();
+
+  for (std::thread& worker : this->workers_)
+    worker.join();
+}
+
+
+void
+ChunkedTokenizer::run(void)
+{
+  Tokenizer *tokenizer = this->tokenizer_;
+
+  tokenizer->run_until(this->chunks_[0].end, this->chunks_.size() == 1);
+
+  for (size_t i = 1; i < this->chunks_.size(); i++) {
+    struct queued_chunk *chunk = this->wait_for_(i);
+
+    if (tokenizer->state == DATA_STATE && tokenizer->input.p == chunk->begin
+     && this->replay_chunk_(chunk))
+      break;
+
+    tokenizer->run_until(chunk->end, chunk->end == this->input_end_);
+
+    /* don't keep the tokens around any longer */
+    chunk->entries = { };
+  }
+
+}
+
+
+void
+ChunkedTokenizer::split_(void)
+{
+  char const *p = this->input_begin_;
+
+  /* the last chunk gets what is left, so it is never tiny */
+  while (static_cast<size_t>(this->input_end_ - p) >= 2 * ChunkedTokenizer::k_chunk_size_) {
+    char const *boundary = chunk_boundary(p + ChunkedTokenizer::k_chunk_size_,
+                                          this->input_begin_, this->input_end_);
+
+    if (boundary == this->input_end_)
+      break;
+
+    this->chunks_.push_back({ .begin = p, .end = boundary });
+    p = boundary;
+  }
+
+  this->chunks_.push_back({ .begin = p, .end = this->input_end_ });
+}
+
+
+void
+ChunkedTokenizer::work_(void)
+{
+  std::unique_lock< std::mutex> lock(this->mutex_);
+
+  while (true)
+  {
+    this->cond_.wait(lock, [this](void) {
+      return (this->stop_
+           || this->next_chunk_ == this->chunks_.size()
+           || this->next_chunk_ <= this->current_chunk_ + this->window_);
+    });
+
+    if (this->stop_ || this->next_chunk_ == this->chunks_.size())
+      return;
+
+    struct queued_chunk *chunk = &this->chunks_[this->next_chunk_++];
+
+    lock.unlock();
+    this->tokenize_(chunk);
+    lock.lock();
+
+    chunk->ready = true;
+    this->cond_.notify_all();
+  }
+
+}
+
+
+/*
+ * If the tokenizer stops in between two tokens, which it normally does right
+ * in front of the next chunk's start tag, it goes on from there; otherwise
+ * from the last start tag, forgetting what it queued since.
+ */
+void
+ChunkedTokenizer::tokenize_(struct queued_chunk *chunk)
+{
+  bool final = (chunk->end == this->input_end_);
+  BasicTokenizer< TokenQueue> tokenizer(chunk->begin, chunk->end - chunk->begin,
+                                        chunk->begin - this->input_begin_);
+
+  /* only looked at to tell whether errors are wanted; they are queued */
+  tokenizer.errors = this->tokenizer_->errors;
+
+  {
+    ChunkQueue queue(&tokenizer, this->scripting_, &chunk->entries);
+    tokenizer.run_until(chunk->end, final);
+  }
+
+  if (final)
+    return;
+
+  if (tokenizer.state <= PLAINTEXT_STATE) {
+    chunk->resume = tokenizer.checkpoint(tokenizer.state);
+    return;
+  }
+
+  auto last_start_tag = std::find_if(chunk->entries.rbegin(), chunk->entries.rend(),
+    [](struct queued_token const& entry) {
+      return (entry.kind == QUEUED_TOKEN && entry.type == TOKEN_START_TAG);
+    });
+
+  if (last_start_tag == chunk->entries.rend()) {
+    chunk->entries.clear();
+    return;
+  }
+
+  chunk->resume = last_start_tag->checkpoint;
+  chunk->resume->state = last_start_tag->speculated_state;
+
+  chunk->entries.erase(last_start_tag.base(), chunk->entries.end());
+}
+
+
+[[nodiscard]]
+struct queued_chunk *
+ChunkedTokenizer::wait_for_(size_t index)
+{
+  std::unique_lock< std::mutex> lock(this->mutex_);
+
+  this->current_chunk_ = index;
+  this->cond_.notify_all();
+
+  this->cond_.wait(lock, [this, index](void) { return this->chunks_[index].ready; });
+
+  return &this->chunks_[index];
+}
+
+
+/*
+ * Returns whether that was it up to EOF; if not, leaves the tokenizer where
+ * it has to go on from within the chunk
+ */
+[[nodiscard]]
+bool
+ChunkedTokenizer::replay_chunk_(struct queued_chunk *chunk)
+{
+  struct tokenizer_checkpoint restart;
+
+  for (struct queued_token& entry : chunk->entries) {
+    if (this->replay_(&entry, &restart) != REPLAY_OK) {
+      this->tokenizer_->rewind(restart, chunk->end);
+      return false;
+    }
+  }
+
+  if (chunk->resume.has_value()) {
+    this->tokenizer_->rewind(*chunk->resume, chunk->end);
+    return false;
+  }
+
+  return (! chunk->entries.empty()
+       && chunk->entries.back().kind == QUEUED_TOKEN
+       && chunk->entries.back().type == TOKEN_EOF);
+}
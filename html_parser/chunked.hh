@@ -0,0 +1,113 @@
+#ifndef _queequeg_html_parser_chunked_hh_
+#define _queequeg_html_parser_chunked_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/chunked.hh
+ *
+ * Description:
+ * Tokenizes a large document on several threads at once. The input is cut
+ * into chunks right in front of what looks like a start tag, and workers
+ * tokenize each chunk on its own as though it began in the data state,
+ * queueing the tokens (see html_parser/pipeline.hh) until tree construction
+ * gets there. If the tokenizer really is in the data state at the start of
+ * the chunk by then, the chunk is replayed; otherwise it is tokenized again,
+ * and so is the rest of a chunk from its first wrong guess on.
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <stddef.h>
+
+#include "html_parser/internal.hh"
+#include "html_parser/pipeline.hh"
+
+
+struct queued_chunk {
+  char const *begin;
+  char const *end;
+
+  std::vector< struct queued_token> entries = { };
+  /*
+   * Where the tokenizer goes on from after the entries; unset for the last
+   * chunk, which ends with EOF, and for one that has to be tokenized again
+   * as a whole
+   */
+  std::optional< struct tokenizer_checkpoint> resume = { };
+
+  bool ready = false;
+};
+
+
+/*
+ * The tokenizer must have been constructed on the whole input, which must
+ * outlive this.
+ */
+class ChunkedTokenizer final : private TokenReplay {
+  public:
+    ChunkedTokenizer(Tokenizer *tokenizer, TreeBuilder *treebuilder, unsigned n_workers);
+    ~ChunkedTokenizer();
+
+
+  public:
+    /*
+     * Tokenizes and builds the tree up to EOF
+     */
+    void run(void);
+
+
+  private:
+    static constexpr size_t k_chunk_size_ = 256 * 1024;
+
+    void split_(void);
+
+    /*
+     * Worker threads
+     */
+    void work_(void);
+    void tokenize_(struct queued_chunk *chunk);
+
+    /*
+     * Tree builder thread
+     */
+    [[nodiscard]] struct queued_chunk *wait_for_(size_t index);
+    [[nodiscard]] bool replay_chunk_(struct queued_chunk *chunk);
+
+
+  private:
+    Tokenizer *tokenizer_;
+    char const *input_begin_;
+    char const *input_end_;
+
+    /* the tree builder's, which doesn't change while parsing */
+    bool scripting_;
+
+    std::vector< struct queued_chunk> chunks_;
+
+    std::vector< std::thread> workers_;
+    /*
+     * Workers stay at most this many chunks ahead of tree construction, which
+     * bounds how many tokens are queued at a time
+     */
+    size_t window_;
+
+    /*
+     * Guard the chunks' ready flags and the following
+     */
+    std::mutex mutex_;
+    std::condition_variable cond_;
+
+    size_t next_chunk_ = 1;
+    size_t current_chunk_ = 0;
+    bool stop_ = false;
+};
+
+
+#endif /* !defined(_queequeg_html_parser_chunked_hh_) */
@@ -0,0 +1,296 @@
+#ifndef _queequeg_html_parser_element_categories_hh_
+#define _queequeg_html_parser_element_categories_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/element_categories.hh
+ *
+ * Description:
+ * The element categories the tree builder keeps asking about ("special",
+ * "formatting", what ends which scope, ...), as bitflags in constexpr tables
+ * indexed by local name, one table per namespace.
+ */
+
+#include <array>
+#include <initializer_list>
+
+#include <stdint.h>
+
+#include <infra/namespace.h>
+
+#include "html/elements.hh"
+
+
+/*
+ * Only the MathML and SVG elements some category applies to; every other one
+ * has HTML_ELEMENT_NONE_'s categories.
+ */
+enum mathml_element_index : uint16_t {
+  MATHML_ELEMENT_NONE_ = 0,
+
+  MATHML_ELEMENT_MI,
+  MATHML_ELEMENT_MO,
+  MATHML_ELEMENT_MN,
+  MATHML_ELEMENT_MS,
+  MATHML_ELEMENT_MTEXT,
+  MATHML_ELEMENT_ANNOTATION_XML,
+
+  NUM_MATHML_BUILTIN_ELEMENTS,
+};
+
+enum svg_element_index : uint16_t {
+  SVG_ELEMENT_NONE_ = 0,
+
+  SVG_ELEMENT_FOREIGN_OBJECT,
+  SVG_ELEMENT_DESC,
+  SVG_ELEMENT_TITLE,
+
+  NUM_SVG_BUILTIN_ELEMENTS,
+};
+
+
+/*
+ * Element scopes, as used by the "have an element in ... scope" algorithms.
+ * The order matches the ELEMENT_ENDS_*_SCOPE flags below.
+ */
+enum scope_kind : uint8_t {
+  SCOPE_PARTICULAR,
+  SCOPE_LIST_ITEM,
+  SCOPE_BUTTON,
+  SCOPE_TABLE,
+  SCOPE_SELECT,
+
+  NUM_SCOPE_KINDS,
+};
+
+
+enum element_category : uint16_t {
+  ELEMENT_SPECIAL                    = 1 << 0,
+  ELEMENT_FORMATTING                 = 1 << 1,
+  /* "generate implied end tags" */
+  ELEMENT_IMPLIED_END_TAG            = 1 << 2,
+  /* "generate all implied end tags thoroughly" */
+  ELEMENT_THOROUGHLY_IMPLIED_END_TAG = 1 << 3,
+  /* may still be open at the end of the body without a parse error */
+  ELEMENT_OPEN_AT_BODY_END           = 1 << 4,
+  ELEMENT_VOID                       = 1 << 5,
+  ELEMENT_RAW_TEXT                   = 1 << 6,
+  /* "escapable raw text" */
+  ELEMENT_RCDATA                     = 1 << 7,
+
+  ELEMENT_ENDS_PARTICULAR_SCOPE      = 1 << 8,
+  ELEMENT_ENDS_LIST_ITEM_SCOPE       = 1 << 9,
+  ELEMENT_ENDS_BUTTON_SCOPE          = 1 << 10,
+  ELEMENT_ENDS_TABLE_SCOPE           = 1 << 11,
+  ELEMENT_ENDS_SELECT_SCOPE          = 1 << 12,
+};
+
+
+[[nodiscard]]
+constexpr uint16_t
+scope_boundary_category(enum scope_kind kind)
+{
+  return static_cast<uint16_t>(ELEMENT_ENDS_PARTICULAR_SCOPE << kind);
+}
+
+static_assert(scope_boundary_category(SCOPE_SELECT) == ELEMENT_ENDS_SELECT_SCOPE);
+
+
+/*
+ * Everything but optgroup and option ends select scope, including elements
+ * we know nothing about.
+ */
+inline constexpr uint16_t k_default_element_categories = ELEMENT_ENDS_SELECT_SCOPE;
+
+inline constexpr uint16_t k_ends_particular_scope = ELEMENT_ENDS_PARTICULAR_SCOPE
+                                                  | ELEMENT_ENDS_LIST_ITEM_SCOPE
+                                                  | ELEMENT_ENDS_BUTTON_SCOPE;
+
+
+template< typename Index, size_t N>
+class ElementCategoryTable final {
+  public:
+    constexpr ElementCategoryTable(void) { this->table_.fill(k_default_element_categories); }
+
+
+  public:
+    constexpr void
+    add(uint16_t categories, std::initializer_list< Index> local_names)
+    {
+      for (Index local_name : local_names)
+        this->table_[local_name] |= categories;
+    }
+
+    constexpr void
+    remove(uint16_t categories, std::initializer_list< Index> local_names)
+    {
+      for (Index local_name : local_names)
+        this->table_[local_name] &= static_cast<uint16_t>(~categories);
+    }
+
+    [[nodiscard]]
+    constexpr uint16_t
+    operator[](uint16_t local_name) const
+    {
+      return (local_name < N) ? this->table_[local_name] : k_default_element_categories;
+    }
+
+
+  private:
+    std::array< uint16_t, N> table_ = { };
+};
+
+
+[[nodiscard]]
+consteval ElementCategoryTable< enum html_element_index, NUM_HTML_BUILTIN_ELEMENTS>
+make_html_element_categories_(void)
+{
+  ElementCategoryTable< enum html_element_index, NUM_HTML_BUILTIN_ELEMENTS> table;
+
+  table.add(ELEMENT_SPECIAL, {
+    HTML_ELEMENT_ADDRESS,    HTML_ELEMENT_APPLET,     HTML_ELEMENT_AREA,
+    HTML_ELEMENT_ARTICLE,    HTML_ELEMENT_ASIDE,      HTML_ELEMENT_BASE,
+    HTML_ELEMENT_BASEFONT,   HTML_ELEMENT_BGSOUND,    HTML_ELEMENT_BLOCKQUOTE,
+    HTML_ELEMENT_BODY,       HTML_ELEMENT_BR,         HTML_ELEMENT_BUTTON,
+    HTML_ELEMENT_CAPTION,    HTML_ELEMENT_CENTER,     HTML_ELEMENT_COL,
+    HTML_ELEMENT_COLGROUP,   HTML_ELEMENT_DD,         HTML_ELEMENT_DETAILS,
+    HTML_ELEMENT_DIR,        HTML_ELEMENT_DIV,        HTML_ELEMENT_DL,
+    HTML_ELEMENT_DT,         HTML_ELEMENT_EMBED,      HTML_ELEMENT_FIELDSET,
+    HTML_ELEMENT_FIGCAPTION, HTML_ELEMENT_FIGURE,     HTML_ELEMENT_FOOTER,
+    HTML_ELEMENT_FORM,       HTML_ELEMENT_FRAME,      HTML_ELEMENT_FRAMESET,
+    HTML_ELEMENT_H1,         HTML_ELEMENT_H2,         HTML_ELEMENT_H3,
+    HTML_ELEMENT_H4,         HTML_ELEMENT_H5,         HTML_ELEMENT_H6,
+    HTML_ELEMENT_HEAD,       HTML_ELEMENT_HEADER,     HTML_ELEMENT_HGROUP,
+    HTML_ELEMENT_HR,         HTML_ELEMENT_HTML,       HTML_ELEMENT_IFRAME,
+    HTML_ELEMENT_IMG,        HTML_ELEMENT_INPUT,      HTML_ELEMENT_KEYGEN,
+    HTML_ELEMENT_LI,         HTML_ELEMENT_LINK,       HTML_ELEMENT_LISTING,
+    HTML_ELEMENT_MAIN,       HTML_ELEMENT_MARQUEE,    HTML_ELEMENT_MENU,
+    HTML_ELEMENT_META,       HTML_ELEMENT_NAV,        HTML_ELEMENT_NOEMBED,
+    HTML_ELEMENT_NOFRAMES,   HTML_ELEMENT_NOSCRIPT,   HTML_ELEMENT_OBJECT,
+    HTML_ELEMENT_OL,         HTML_ELEMENT_P,          HTML_ELEMENT_PARAM,
+    HTML_ELEMENT_PLAINTEXT,  HTML_ELEMENT_PRE,        HTML_ELEMENT_SCRIPT,
+    HTML_ELEMENT_SEARCH,     HTML_ELEMENT_SECTION,    HTML_ELEMENT_SELECT,
+    HTML_ELEMENT_SOURCE,     HTML_ELEMENT_STYLE,      HTML_ELEMENT_SUMMARY,
+    HTML_ELEMENT_TABLE,      HTML_ELEMENT_TBODY,      HTML_ELEMENT_TD,
+    HTML_ELEMENT_TEMPLATE,   HTML_ELEMENT_TEXTAREA,   HTML_ELEMENT_TFOOT,
+    HTML_ELEMENT_TH,         HTML_ELEMENT_THEAD,      HTML_ELEMENT_TITLE,
+    HTML_ELEMENT_TR,         HTML_ELEMENT_TRACK,      HTML_ELEMENT_UL,
+    HTML_ELEMENT_WBR,        HTML_ELEMENT_XMP,
+  });
+
+  table.add(ELEMENT_FORMATTING, {
+    HTML_ELEMENT_A,     HTML_ELEMENT_B,      HTML_ELEMENT_BIG,
+    HTML_ELEMENT_CODE,  HTML_ELEMENT_EM,     HTML_ELEMENT_FONT,
+    HTML_ELEMENT_I,     HTML_ELEMENT_NOBR,   HTML_ELEMENT_S,
+    HTML_ELEMENT_SMALL, HTML_ELEMENT_STRIKE, HTML_ELEMENT_STRONG,
+    HTML_ELEMENT_TT,    HTML_ELEMENT_U,
+  });
+
+  table.add(ELEMENT_IMPLIED_END_TAG | ELEMENT_THOROUGHLY_IMPLIED_END_TAG | ELEMENT_OPEN_AT_BODY_END, {
+    HTML_ELEMENT_DD, HTML_ELEMENT_DT, HTML_ELEMENT_LI, HTML_ELEMENT_OPTGROUP,
+    HTML_ELEMENT_OPTION, HTML_ELEMENT_P, HTML_ELEMENT_RB, HTML_ELEMENT_RP,
+    HTML_ELEMENT_RT, HTML_ELEMENT_RTC,
+  });
+
+  table.add(ELEMENT_THOROUGHLY_IMPLIED_END_TAG | ELEMENT_OPEN_AT_BODY_END, {
+    HTML_ELEMENT_TBODY, HTML_ELEMENT_TD, HTML_ELEMENT_TFOOT, HTML_ELEMENT_TH,
+    HTML_ELEMENT_THEAD, HTML_ELEMENT_TR,
+  });
+
+  table.add(ELEMENT_THOROUGHLY_IMPLIED_END_TAG, { HTML_ELEMENT_CAPTION, HTML_ELEMENT_COLGROUP });
+
+  table.add(ELEMENT_OPEN_AT_BODY_END, { HTML_ELEMENT_BODY, HTML_ELEMENT_HTML });
+
+  table.add(ELEMENT_VOID, {
+    HTML_ELEMENT_AREA,  HTML_ELEMENT_BASE,   HTML_ELEMENT_BR,    HTML_ELEMENT_COL,
+    HTML_ELEMENT_EMBED, HTML_ELEMENT_HR,     HTML_ELEMENT_IMG,   HTML_ELEMENT_INPUT,
+    HTML_ELEMENT_LINK,  HTML_ELEMENT_META,   HTML_ELEMENT_SOURCE, HTML_ELEMENT_TRACK,
+    HTML_ELEMENT_WBR,
+  });
+
+  table.add(ELEMENT_RAW_TEXT, { HTML_ELEMENT_SCRIPT, HTML_ELEMENT_STYLE });
+  table.add(ELEMENT_RCDATA, { HTML_ELEMENT_TEXTAREA, HTML_ELEMENT_TITLE });
+
+  table.add(k_ends_particular_scope, {
+    HTML_ELEMENT_APPLET, HTML_ELEMENT_CAPTION,  HTML_ELEMENT_HTML,
+    HTML_ELEMENT_TABLE,  HTML_ELEMENT_TD,       HTML_ELEMENT_TH,
+    HTML_ELEMENT_MARQUEE, HTML_ELEMENT_OBJECT,  HTML_ELEMENT_TEMPLATE,
+  });
+
+  table.add(ELEMENT_ENDS_LIST_ITEM_SCOPE, { HTML_ELEMENT_OL, HTML_ELEMENT_UL });
+  table.add(ELEMENT_ENDS_BUTTON_SCOPE, { HTML_ELEMENT_BUTTON });
+  table.add(ELEMENT_ENDS_TABLE_SCOPE, { HTML_ELEMENT_HTML, HTML_ELEMENT_TABLE, HTML_ELEMENT_TEMPLATE });
+  table.remove(ELEMENT_ENDS_SELECT_SCOPE, { HTML_ELEMENT_OPTGROUP, HTML_ELEMENT_OPTION });
+
+  return table;
+}
+
+
+[[nodiscard]]
+consteval ElementCategoryTable< enum mathml_element_index, NUM_MATHML_BUILTIN_ELEMENTS>
+make_mathml_element_categories_(void)
+{
+  ElementCategoryTable< enum mathml_element_index, NUM_MATHML_BUILTIN_ELEMENTS> table;
+
+  table.add(ELEMENT_SPECIAL | k_ends_particular_scope, {
+    MATHML_ELEMENT_MI, MATHML_ELEMENT_MO, MATHML_ELEMENT_MN,
+    MATHML_ELEMENT_MS, MATHML_ELEMENT_MTEXT, MATHML_ELEMENT_ANNOTATION_XML,
+  });
+
+  return table;
+}
+
+
+[[nodiscard]]
+consteval ElementCategoryTable< enum svg_element_index, NUM_SVG_BUILTIN_ELEMENTS>
+make_svg_element_categories_(void)
+{
+  ElementCategoryTable< enum svg_element_index, NUM_SVG_BUILTIN_ELEMENTS> table;
+
+  table.add(ELEMENT_SPECIAL | k_ends_particular_scope, {
+    SVG_ELEMENT_FOREIGN_OBJECT, SVG_ELEMENT_DESC, SVG_ELEMENT_TITLE,
+  });
+
+  return table;
+}
+
+
+inline constexpr auto k_html_element_categories   = make_html_element_categories_();
+inline constexpr auto k_mathml_element_categories = make_mathml_element_categories_();
+inline constexpr auto k_svg_element_categories    = make_svg_element_categories_();
+
+
+[[nodiscard]]
+constexpr uint16_t
+element_categories(enum InfraNamespace name_space, uint16_t local_name)
+{
+  switch (name_space)
+  {
+    case INFRA_NAMESPACE_HTML:
+      return k_html_element_categories[local_name];
+
+    case INFRA_NAMESPACE_MATHML:
+      return k_mathml_element_categories[local_name];
+
+    case INFRA_NAMESPACE_SVG:
+      return k_svg_element_categories[local_name];
+
+    default:
+      return k_default_element_categories;
+  }
+}
+
+
+[[nodiscard]]
+constexpr bool
+element_has_category(enum InfraNamespace name_space, uint16_t local_name,
+                     uint16_t categories)
+{
+  return (element_categories(name_space, local_name) & categories) != 0;
+}
+
+
+#endif /* !defined(_queequeg_html_parser_element_categories_hh_) */
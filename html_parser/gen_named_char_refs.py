@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 Adrien Ricciardi
+# This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+# See LICENSE for details
+#
+# File: html_parser/gen_named_char_refs.py
+#
+# Description:
+# Turns the WHATWG named character references table (entities.json, as found
+# at https://html.spec.whatwg.org/entities.json) into a C++ header holding a
+# trie over the reference names, for html_parser/tokenizer_states.hh.
+#
+# The trie is laid out breadth-first so that the children of every node are
+# contiguous and sorted by their byte, which lets the tokenizer binary-search
+# them. Node 0 is the root; names are stored without their leading '&'.
+#
+# Usage: gen_named_char_refs.py entities.json > named_char_refs.hh
+#
+
+import json
+import sys
+
+
+class TrieNode:
+    def __init__(self):
+        self.children = {}
+        self.value = None
+
+
+def build_trie(entities):
+    root = TrieNode()
+
+    for name, entity in entities.items():
+        if not name.startswith("&"):
+            sys.exit(f"bad entity name: {name!r}")
+
+        node = root
+        for byte in name[1:].encode("ascii"):
+            node = node.children.setdefault(byte, TrieNode())
+
+        characters = "".join(chr(cp) for cp in entity["codepoints"])
+        node.value = characters.encode("utf-8")
+
+    return root
+
+
+def flatten(root):
+    # (byte, node) in breadth-first order
+    order = [(0, root)]
+    first_child = []
+    i = 0
+
+    while i < len(order):
+        _, node = order[i]
+        first_child.append(len(order))
+        order.extend(sorted(node.children.items()))
+        i += 1
+
+    return order, first_child
+
+
+def c_string(data):
+    return '"' + "".join(f"\\x{byte:02X}" for byte in data) + '"'
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(f"usage: {sys.argv[0]} entities.json")
+
+    with open(sys.argv[1], encoding="utf-8") as f:
+        entities = json.load(f)
+
+    order, first_child = flatten(build_trie(entities))
+
+    if len(order) > 0xFFFF:
+        sys.exit("trie too large for 16-bit node indices")
+
+    utf8 = bytearray()
+    offsets = {}
+    rows = []
+
+    for index, (byte, node) in enumerate(order):
+        offset, length = 0, 0
+
+        if node.value is not None:
+            # "&amp" and "&amp;" share their replacement text
+            if node.value not in offsets:
+                offsets[node.value] = len(utf8)
+                utf8 += node.value
+
+            offset, length = offsets[node.value], len(node.value)
+
+        rows.append((byte, len(node.children), first_child[index], offset, length))
+
+    if len(utf8) > 0xFFFF:
+        sys.exit("replacement text too large for 16-bit offsets")
+
+    out = sys.stdout
+    out.write(
+        "/*\n"
+        " * Generated by html_parser/gen_named_char_refs.py from html_parser/entities.json,\n"
+        " * do not edit. It gets included by \"html_parser/tokenizer_states.hh\"\n"
+        " */\n"
+        "#ifndef _queequeg_html_parser_named_char_refs_hh_\n"
+        "#define _queequeg_html_parser_named_char_refs_hh_\n"
+        "\n"
+        "#include <stdint.h>\n"
+        "\n"
+        "\n"
+        "struct named_char_ref_node {\n"
+        "  char     byte;\n"
+        "  uint8_t  num_children;\n"
+        "  uint16_t first_child;\n"
+        "  /*\n"
+        "   * replacement text in k_named_char_ref_utf8_, if a name ends here\n"
+        "   */\n"
+        "  uint16_t utf8_offset;\n"
+        "  uint8_t  utf8_len;\n"
+        "};\n"
+        "\n"
+        "\n"
+        f"/* {len(entities)} names, {len(rows)} nodes */\n"
+        "static constexpr struct named_char_ref_node k_named_char_ref_nodes_[] = {\n")
+
+    for byte, num_children, first, offset, length in rows:
+        out.write(f"  {{ {byte:#04x}, {num_children}, {first}, {offset}, {length} }},\n")
+
+    out.write(
+        "};\n"
+        "\n"
+        "\n"
+        "static constexpr char k_named_char_ref_utf8_[] =\n")
+
+    for i in range(0, len(utf8), 16):
+        out.write(f"  {c_string(utf8[i:i + 16])}\n")
+
+    out.write(
+        "  ;\n"
+        "\n"
+        "\n"
+        "#endif /* !defined(_queequeg_html_parser_named_char_refs_hh_) */\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -13,6 +13,8 @@
 #include <utility>
 #include <ranges>
 #include <algorithm>
+#include <iterator>
+#include <string_view>
 
 #include <stdio.h>
 
@@ -22,9 +24,11 @@
 #include "dom/html/html_script_element.hh"
 #include "html/elements.hh"
 
+#include "qglib/unicode.hh"
+
 #include "html_parser/internal.hh"
 
-#if !defined NDEBUG
+#if defined(HTML_PARSER_DEBUG)
 # define LOGF(...) \
   fprintf(stderr, __VA_ARGS__)
 #else
@@ -33,36 +37,119 @@
 #endif
 
 
-static enum treebuilder_status initial_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status before_html_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status before_head_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_head_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_head_noscript_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status after_head_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_body_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status text_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_table_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_table_text_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_caption_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_column_group_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_table_body_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_row_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_cell_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_select_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_select_in_table_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_template_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status after_body_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_frameset_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status after_frameset_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status after_after_body_mode(TreeBuilder *, union token_data *, enum token_type);
-static enum treebuilder_status in_foreign_content_mode(TreeBuilder *, union token_data *, enum token_type);
+template< enum token_type token_type> static enum treebuilder_status initial_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status before_html_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status before_head_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_head_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_head_noscript_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status after_head_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_body_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status text_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_table_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_table_text_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_caption_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_column_group_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_table_body_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_row_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_cell_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_select_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_select_in_table_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_template_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status after_body_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_frameset_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status after_frameset_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status after_after_body_mode(TreeBuilder *, union token_data *);
+template< enum token_type token_type> static enum treebuilder_status in_foreign_content_mode(TreeBuilder *, union token_data *);
+
+
+static inline bool
+is_whitespace_char(char c)
+{
+  return (c == '\t' || c == '\n' || c == '\f' || c == ' ');
+}
+
+
+/*
+ * Character runs freely mix whitespace with other characters. Modes that
+ * treat both differently handle the leading whitespace first and then process
+ * whatever is left of the run as "anything else"; this returns the former
+ * and leaves the latter in the token.
+ */
+static std::string_view
+split_leading_whitespace(union token_data *token_data)
+{
+  std::string_view *chars = &token_data->chars;
+  size_t n = 0;
+
+  while (n < chars->size() && is_whitespace_char((*chars)[n]))
+    n++;
+
+  std::string_view whitespace = chars->substr(0, n);
+  chars->remove_prefix(n);
+
+  return whitespace;
+}
+
+
+static bool
+has_non_whitespace(std::string_view chars)
+{
+  return ! std::all_of(chars.begin(), chars.end(), is_whitespace_char);
+}
 
 
+/*
+ * A run stands for one character token per code point, each of them an error
+ * where it lies in the input
+ */
+static void
+error_per_code_point(TreeBuilder *treebuilder, std::string_view chars)
+{
+  for (size_t i = 0; i < chars.size(); ++i)
+    /* continuation bytes belong to a code point reported already */
+    if ((chars[i] & 0xC0) != 0x80)
+      treebuilder->error(treebuilder->run_offset_of(&chars[i]));
+}
+
 
+/*
+ * For the modes which only keep whitespace and drop anything else, one
+ * character at a time: each stretch of whitespace goes to insert() where it
+ * lies in the run, and every other code point is an error of its own.
+ */
+template< typename Insert>
+static void
+keep_whitespace(TreeBuilder *treebuilder, std::string_view chars,
+                Insert insert)
+{
+  size_t start = 0;
+
+  for (size_t i = 0; i < chars.size(); ++i) {
+    unsigned char c = chars[i];
+
+    if (is_whitespace_char(c))
+      continue;
+
+    if (i > start)
+      insert(chars.substr(start, i - start));
+
+    start = i + 1;
+
+    /* continuation bytes belong to a code point reported already */
+    if ((c & 0xC0) != 0x80)
+      treebuilder->error(treebuilder->run_offset_of(&chars[i]));
+  }
+
+  if (start < chars.size())
+    insert(chars.substr(start));
+}
+
+
+
+template< enum token_type token_type>
 static enum treebuilder_status
 initial_mode(TreeBuilder *treebuilder,
-             union token_data *token_data,
-             enum token_type token_type)
+             union token_data *token_data)
 {
   LOGF("initial mode\n");
   
@@ -71,6 +158,16 @@ initial_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    (void) split_leading_whitespace(token_data);
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_IGNORE;
+
+    goto anything_else;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment,
      InsertionLocation{std::dynamic_pointer_cast<DOM::Node>(treebuilder->document), nullptr});
@@ -82,26 +179,15 @@ initial_mode(TreeBuilder *treebuilder,
   if (token_type == TOKEN_DOCTYPE) {
     struct doctype_token *token = &token_data->doctype;
 
-    if ((token->name.compare("html") != 0)
+    if (token->name != "html"
      || ! token->public_id_missing
      || (! token->system_id_missing
-      && (token->system_id.compare("about:legacy-compat"))) != 0)
+      && token->system_id != "about:legacy-compat"))
       treebuilder->error();
 
-    std::shared_ptr< DOM::DocumentType> doctype = std::make_shared<DOM::DocumentType>(treebuilder->document);
-
-    doctype->name = token->name;
-
-    if (! token->public_id_missing)
-      doctype->public_id = token->public_id;
-
-    if (! token->system_id_missing)
-      doctype->system_id = token->system_id;
-
-    treebuilder->document->append_node(doctype);
+    treebuilder->insert_doctype(token);
 
     /* XXX: ... */
-    LOGF("doctype node_document: %p\n", static_cast<void *>(doctype->node_document.lock().get()));
 
     treebuilder->mode = BEFORE_HTML_MODE;
 
@@ -109,7 +195,7 @@ initial_mode(TreeBuilder *treebuilder,
   }
 
 
-  {
+  anything_else: {
     /* ... */
     treebuilder->mode = BEFORE_HTML_MODE;
     return TREEBUILDER_STATUS_REPROCESS;
@@ -118,10 +204,10 @@ initial_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 before_html_mode(TreeBuilder *treebuilder,
-                 union token_data *token_data,
-                 enum token_type token_type)
+                 union token_data *token_data)
 {
   LOGF("before html mode\n");
 
@@ -145,6 +231,16 @@ before_html_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    (void) split_leading_whitespace(token_data);
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_IGNORE;
+
+    goto anything_else;
+  }
+
+
   if (token_type == TOKEN_START_TAG) {
     struct tag_token *tag = &token_data->tag;
 
@@ -152,12 +248,14 @@ before_html_mode(TreeBuilder *treebuilder,
     {
       case HTML_ELEMENT_HTML: {
         std::shared_ptr< DOM::HTMLHtmlElement> html_el =
-         std::make_shared< DOM::HTMLHtmlElement>(treebuilder->document,
+         treebuilder->document->create_node<DOM::HTMLHtmlElement>(treebuilder->document,
           INFRA_NAMESPACE_HTML, HTML_ELEMENT_HTML);
 
-        treebuilder->document->append_node(html_el);
+        treebuilder->insert_element_at_location(
+         InsertionLocation{std::dynamic_pointer_cast<DOM::Node>(treebuilder->document), nullptr},
+         html_el, tag);
 
-        treebuilder->open_elements.push_back(html_el);
+        treebuilder->open_elements.push_back(html_el.get());
 
         treebuilder->mode = BEFORE_HEAD_MODE;
         return TREEBUILDER_STATUS_OK;
@@ -191,13 +289,23 @@ before_html_mode(TreeBuilder *treebuilder,
 
 
   anything_else: {
+    static const struct tag_token dummy_token = {
+      .tag_name = "html",
+      .local_name = HTML_ELEMENT_HTML,
+      .attributes = { },
+      .self_closing_flag = false,
+      .ack_self_closing_flag_ = false,
+    };
+
     std::shared_ptr< DOM::HTMLHtmlElement> html =
-     std::make_shared< DOM::HTMLHtmlElement>(treebuilder->document,
+     treebuilder->document->create_node<DOM::HTMLHtmlElement>(treebuilder->document,
       INFRA_NAMESPACE_HTML, HTML_ELEMENT_HTML);
 
-    treebuilder->document->append_node(html);
+    treebuilder->insert_element_at_location(
+     InsertionLocation{std::dynamic_pointer_cast<DOM::Node>(treebuilder->document), nullptr},
+     html, &dummy_token);
 
-    treebuilder->open_elements.push_back(html);
+    treebuilder->open_elements.push_back(html.get());
 
     treebuilder->mode = BEFORE_HEAD_MODE;
     return TREEBUILDER_STATUS_REPROCESS;
@@ -206,10 +314,10 @@ before_html_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 before_head_mode(TreeBuilder *treebuilder,
-                 union token_data *token_data,
-                 enum token_type token_type)
+                 union token_data *token_data)
 {
   LOGF("before head mode\n");
 
@@ -218,6 +326,16 @@ before_head_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    (void) split_leading_whitespace(token_data);
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_IGNORE;
+
+    goto anything_else;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -237,7 +355,7 @@ before_head_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -283,10 +401,10 @@ before_head_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_head_mode(TreeBuilder *treebuilder,
-             union token_data *token_data,
-             enum token_type token_type)
+             union token_data *token_data)
 {
   LOGF("in head mode\n");
 
@@ -296,6 +414,19 @@ in_head_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    std::string_view whitespace = split_leading_whitespace(token_data);
+
+    if (! whitespace.empty())
+      treebuilder->insert_characters(whitespace);
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_OK;
+
+    goto anything_else;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -315,7 +446,7 @@ in_head_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -386,11 +517,11 @@ in_head_mode(TreeBuilder *treebuilder,
         LOGF("script_el = %p\n", reinterpret_cast<void *>(script_el.get()));
 
         treebuilder->insert_element_at_location(ins_location,
-         std::dynamic_pointer_cast<DOM::Element>(script_el));
+         std::dynamic_pointer_cast<DOM::Element>(script_el), tag);
 
-        treebuilder->open_elements.push_back(std::dynamic_pointer_cast<DOM::Element>(script_el));
+        treebuilder->open_elements.push_back(script_el.get());
 
-        treebuilder->tokenizer->state = SCRIPT_STATE;
+        treebuilder->switch_tokenizer_state(SCRIPT_STATE);
         treebuilder->original_mode = treebuilder->mode;
         treebuilder->mode = TEXT_MODE;
 
@@ -438,24 +569,26 @@ in_head_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_TEMPLATE: {
-        if (std::find_if(begin(treebuilder->open_elements),
-                         end(treebuilder->open_elements),
-                         [](const auto &elem){ return elem->has_html_element_index(HTML_ELEMENT_TEMPLATE); })
-         == end(treebuilder->open_elements)) {
+        if (std::find_if(treebuilder->open_elements.begin(),
+                         treebuilder->open_elements.end(),
+                         [](const auto &elem){ return elem.has_html_element_index(HTML_ELEMENT_TEMPLATE); })
+         == treebuilder->open_elements.end()) {
           treebuilder->error();
 
           return TREEBUILDER_STATUS_IGNORE;
         }
 
+        treebuilder->generate_all_implied_end_tags_thoroughly();
+
         if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_TEMPLATE))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_TEMPLATE));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_TEMPLATE));
 
         treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -487,10 +620,10 @@ in_head_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_head_noscript_mode(TreeBuilder *treebuilder,
-                      union token_data *token_data,
-                      enum token_type token_type)
+                      union token_data *token_data)
 {
   LOGF("in head noscript mode");
 
@@ -506,13 +639,13 @@ in_head_noscript_mode(TreeBuilder *treebuilder,
     switch (tag->local_name) {
 
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
       case HTML_ELEMENT_BASEFONT: case HTML_ELEMENT_BGSOUND:  case HTML_ELEMENT_LINK:
       case HTML_ELEMENT_META:     case HTML_ELEMENT_NOFRAMES: case HTML_ELEMENT_STYLE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -558,12 +691,25 @@ in_head_noscript_mode(TreeBuilder *treebuilder,
 
 
   if (token_type == TOKEN_WHITESPACE) {
-    return in_head_mode(treebuilder, token_data, token_type);
+    return in_head_mode<token_type>(treebuilder, token_data);
+  }
+
+
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    std::string_view whitespace = split_leading_whitespace(token_data);
+
+    if (! whitespace.empty())
+      (void) in_head_mode<token_type>(treebuilder, reinterpret_cast<union token_data *>(&whitespace));
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_OK;
+
+    goto anything_else;
   }
 
 
   if (token_type == TOKEN_COMMENT) {
-    return in_head_mode(treebuilder, token_data, token_type);
+    return in_head_mode<token_type>(treebuilder, token_data);
   }
 
 
@@ -580,10 +726,10 @@ in_head_noscript_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 after_head_mode(TreeBuilder *treebuilder,
-                union token_data *token_data,
-                enum token_type token_type)
+                union token_data *token_data)
 {
   LOGF("after head mode\n");
 
@@ -593,6 +739,19 @@ after_head_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    std::string_view whitespace = split_leading_whitespace(token_data);
+
+    if (! whitespace.empty())
+      treebuilder->insert_characters(whitespace);
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_OK;
+
+    goto anything_else;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -611,7 +770,7 @@ after_head_mode(TreeBuilder *treebuilder,
     switch (tag->local_name) {
 
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -641,11 +800,11 @@ after_head_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_TITLE: {
         treebuilder->error();
 
-        treebuilder->open_elements.push_back(treebuilder->head);
+        treebuilder->open_elements.push_back(treebuilder->head.get());
 
-        enum treebuilder_status rc = in_head_mode(treebuilder, token_data, token_type);
+        enum treebuilder_status rc = in_head_mode<token_type>(treebuilder, token_data);
 
-        std::erase(treebuilder->open_elements, treebuilder->head);
+        treebuilder->open_elements.erase(treebuilder->open_elements.find(treebuilder->head.get()));
 
         return rc;
       }
@@ -672,7 +831,7 @@ after_head_mode(TreeBuilder *treebuilder,
     switch (tag->local_name) {
 
       case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -717,33 +876,36 @@ close_p_element(TreeBuilder *treebuilder)
   if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_P))
     treebuilder->error();
 
-  std::shared_ptr< DOM::Element> popped;
+  struct open_element popped;
 
   do {
     popped = treebuilder->open_elements.back();
     treebuilder->open_elements.pop_back();
-  } while (! popped->has_html_element_index(HTML_ELEMENT_P));
+  } while (! popped.has_html_element_index(HTML_ELEMENT_P));
 
 }
 
 
+/*
+ * Neither the stack of open elements nor the list of active formatting
+ * elements keeps elements alive; the new elements this creates are always
+ * held by last_node until they are in the tree.
+ */
 static void
 aa_inner_loop_(TreeBuilder *treebuilder,
-               std::shared_ptr< DOM::Element> formatting_element,
-               std::shared_ptr< DOM::Element> furthest_block,
-               std::shared_ptr< DOM::Element> common_ancestor,
-               std::shared_ptr< DOM::Element> *bookmark_p,
-               std::shared_ptr< DOM::Element> node,
+               DOM::Element *formatting_element,
+               DOM::Element *furthest_block,
+               DOM::Element *common_ancestor,
+               DOM::Element **bookmark_p,
                std::shared_ptr< DOM::Element> *last_node_p)
 {
   std::shared_ptr< DOM::Element> last_node = *last_node_p;
+  auto& afe = treebuilder->formatting_elements;
 
   /* Step 4.12. */
   int loop_counter = 0;
-  auto node_prev_it =
-   std::prev(std::find(treebuilder->open_elements.begin(),
-             treebuilder->open_elements.end(),
-             node));
+  size_t node_idx = treebuilder->open_elements.find(furthest_block)
+                  - treebuilder->open_elements.begin();
 
   /* Step 4.13. */
   while (true)
@@ -751,66 +913,47 @@ aa_inner_loop_(TreeBuilder *treebuilder,
     /* Step 4.13.1. */
     loop_counter++;
 
-    /* Step 4.13.2. */
-    {
-      auto node_it = std::find(treebuilder->open_elements.begin(),
-                               treebuilder->open_elements.end(),
-                               node);
-
-      node = (node_it != treebuilder->open_elements.end())
-           ? *std::prev(node_it)
-           : *node_prev_it;
-
-      if (node_it != treebuilder->open_elements.end())
-        node_prev_it = node_it;
-    }
+    /*
+     * Step 4.13.2.; removing node from the stack in step 4.13.5. leaves the
+     * element that was above it at node_idx - 1 all the same
+     */
+    DOM::Element *node = treebuilder->open_elements[--node_idx].element;
 
     /* Step 4.13.3. */
     if (node == formatting_element)
       break;
 
     /* Step 4.13.4. */
-    if (loop_counter >= 3
-     && std::find(treebuilder->formatting_elements.begin(),
-                  treebuilder->formatting_elements.end(),
-                  node) != treebuilder->formatting_elements.end()) {
-      treebuilder->formatting_elements.remove(node);
-      continue; /* XXX: unspecified */
+    int node_afe_idx = afe.index_of(node);
+
+    if (loop_counter > 3 && node_afe_idx != ActiveFormattingList::k_none) {
+      afe.erase(node_afe_idx);
+      node_afe_idx = ActiveFormattingList::k_none;
     }
 
     /* Step 4.13.5. */
-    if (std::find(treebuilder->formatting_elements.begin(),
-                  treebuilder->formatting_elements.end(),
-                  node) == treebuilder->formatting_elements.end()) {
-      /* XXX: remove from open_elements */
+    if (node_afe_idx == ActiveFormattingList::k_none) {
+      treebuilder->open_elements.erase(treebuilder->open_elements.begin() + node_idx);
       continue;
     }
 
     /* Step 4.13.6. */
-    struct tag_token *node_token = &treebuilder->saved_tags.at(node);
+    struct tag_token node_token = afe[node_afe_idx].tag->to_token();
     std::shared_ptr< DOM::Element> new_node =
-     treebuilder->create_element_for_token(node_token, INFRA_NAMESPACE_HTML, common_ancestor);
-
-    std::replace(treebuilder->formatting_elements.begin(),
-                 treebuilder->formatting_elements.end(),
-                 node, new_node);
-
-    std::replace(treebuilder->open_elements.begin(),
-                 treebuilder->open_elements.end(),
-                 node, new_node);
+     treebuilder->create_element_for_adoption(&node_token, common_ancestor);
 
+    afe.replace(node_afe_idx, new_node.get());
+    treebuilder->open_elements.replace(node, new_node.get());
 
     /* Step 4.13.7. */
-    if (last_node == furthest_block)
-      *bookmark_p = *std::next(std::find(treebuilder->formatting_elements.begin(),
-                                         treebuilder->formatting_elements.end(),
-                                         new_node));
+    if (last_node.get() == furthest_block)
+      *bookmark_p = new_node.get();
 
     /* Step 4.13.8. */
-    node->append_node(last_node);
+    treebuilder->move_element(last_node, InsertionLocation{new_node, nullptr});
 
     /* Step 4.13.9. */
-    last_node = node;
+    last_node = new_node;
   }
 
   *last_node_p = last_node;
@@ -821,33 +964,27 @@ static int
 adoption_agency_algorithm(TreeBuilder *treebuilder,
                           struct tag_token *tag)
 {
-  /*
-   * Most repulsive piece of code I have ever written; this function.
-   */
+  auto& afe = treebuilder->formatting_elements;
 
   /* Step 1. */
   uint16_t subject = tag->local_name;
 
   /* Step 2. */
   if (treebuilder->current_node()->has_html_element_index(subject)
-   && (std::find(treebuilder->formatting_elements.begin(),
-                 treebuilder->formatting_elements.end(),
-                 treebuilder->current_node())) == treebuilder->formatting_elements.end()) {
+   && ! afe.contains(treebuilder->current_node())) {
     treebuilder->open_elements.pop_back();
     return 0;
   }
 
   /* Step 3. */
   int outer_counter = 0;
-  std::shared_ptr< DOM::Element> formatting_element = nullptr;
-  std::shared_ptr< DOM::Element> furthest_block = nullptr;
-  std::shared_ptr< DOM::Element> common_ancestor = nullptr;
-  std::shared_ptr< DOM::Element> last_node = nullptr;
-  std::shared_ptr< DOM::Element> bookmark = nullptr;
 
   /* Step 4. */
   while (true)
   {
+    DOM::Element *formatting_element = nullptr;
+    DOM::Element *furthest_block = nullptr;
+
     /* Step 4.1. */
     if (outer_counter >= 8)
       return 0;
@@ -858,31 +995,31 @@ adoption_agency_algorithm(TreeBuilder *treebuilder,
 
 
     /* Step 4.3. */
-    for (auto& elem : std::ranges::views::reverse(treebuilder->formatting_elements)) {
-      if (elem == treebuilder->FORMATTING_MARKER)
+    int formatting_element_idx = ActiveFormattingList::k_none;
+
+    for (int i = static_cast<int>(afe.size()) - 1; i >= 0; i--) {
+      if (afe[i].is_marker())
         break;
 
-      if (elem->has_html_element_index(subject)) {
-        formatting_element = elem;
+      if (afe[i].element->has_html_element_index(subject)) {
+        formatting_element_idx = i;
         break;
       }
 
     }
 
-    if (formatting_element == nullptr)
+    if (formatting_element_idx == ActiveFormattingList::k_none)
       return 1;
 
-    auto formatting_element_it = std::find(treebuilder->formatting_elements.begin(),
-                                           treebuilder->formatting_elements.end(),
-                                           formatting_element);
+    formatting_element = afe[formatting_element_idx].element;
+
+    auto formatting_element_pos = treebuilder->open_elements.find(formatting_element);
 
 
     /* Step 4.4. */
-    if (std::find(treebuilder->open_elements.begin(),
-                  treebuilder->open_elements.end(),
-                  formatting_element) == treebuilder->open_elements.end()) {
+    if (formatting_element_pos == treebuilder->open_elements.end()) {
       treebuilder->error();
-      treebuilder->formatting_elements.remove(formatting_element);
+      afe.erase(formatting_element_idx);
       return 0;
     }
 
@@ -897,82 +1034,73 @@ adoption_agency_algorithm(TreeBuilder *treebuilder,
       treebuilder->error();
 
     /* Step 4.7. */
-    for (auto& elem : std::ranges::views::reverse(treebuilder->open_elements)) {
-      if (elem == formatting_element)
+    for (auto it = std::next(formatting_element_pos); it != treebuilder->open_elements.end(); ++it) {
+      if (treebuilder->is_special_element(*it)) {
+        furthest_block = it->element;
         break;
-
-      if (treebuilder->is_special_element(elem))
-        furthest_block = elem;
+      }
     }
 
     /* Step 4.8. */
     if (furthest_block == nullptr) {
-      std::shared_ptr< DOM::Element> popped;
+      struct open_element popped;
 
       do {
         popped = treebuilder->open_elements.back();
         treebuilder->open_elements.pop_back();
-      } while (popped != formatting_element);
+      } while (popped.element != formatting_element);
 
-      treebuilder->formatting_elements.remove(formatting_element);
+      afe.erase(formatting_element_idx);
 
       return 0;
     }
 
     /* Step 4.9. */
-    common_ancestor = *std::prev(formatting_element_it);
+    DOM::Element *common_ancestor = std::prev(formatting_element_pos)->element;
 
-    /* Step 4.10. */
-    bookmark = *std::prev(formatting_element_it);
+    /* Step 4.10.; nullptr stands for the formatting element's own position */
+    DOM::Element *bookmark = nullptr;
 
     /* Step 4.11. */
-    std::shared_ptr< DOM::Element> node = furthest_block;
-    last_node = furthest_block;
+    std::shared_ptr< DOM::Element> last_node = TreeBuilder::share_element(furthest_block);
 
     /* Steps 4.12. - 4.13.9. */
     aa_inner_loop_(treebuilder, formatting_element, furthest_block,
-                   common_ancestor, &bookmark, node, &last_node);
-
-  }
+                   common_ancestor, &bookmark, &last_node);
 
-  /* Step 4.14. */
-  treebuilder->insert_element_at_location(treebuilder->appropriate_insertion_place(common_ancestor),
-                                          last_node);
+    /* Step 4.14. */
+    treebuilder->move_element(last_node, treebuilder->appropriate_insertion_place(common_ancestor));
 
-  /* Step 15. */
-  struct tag_token *formatting_element_tag = &treebuilder->saved_tags.at(formatting_element);
+    /*
+     * Step 4.15.; the inner loop may have taken entries out from before the
+     * formatting element, so its index has to be looked up again
+     */
+    formatting_element_idx = afe.index_of(formatting_element);
 
-  std::shared_ptr< DOM::Element> new_elem = treebuilder->create_element_for_token(
-   formatting_element_tag, INFRA_NAMESPACE_HTML, furthest_block);
+    struct tag_token formatting_element_tag = afe[formatting_element_idx].tag->to_token();
 
-  /* Step 16. */
-  for (std::shared_ptr< DOM::Node> child : furthest_block->child_nodes)
-    new_elem->append_node(child);
+    std::shared_ptr< DOM::Element> new_elem =
+     treebuilder->create_element_for_adoption(&formatting_element_tag, furthest_block);
 
-  /* Step 17. */
-  furthest_block->append_node(std::dynamic_pointer_cast<DOM::Node>(new_elem));
+    /* Step 4.16. */
+    treebuilder->move_children(furthest_block, new_elem.get());
 
-  /* Step 18. */
-  treebuilder->formatting_elements.remove(formatting_element);
-  treebuilder->formatting_elements.insert(
-   std::find(treebuilder->formatting_elements.begin(),
-             treebuilder->formatting_elements.end(),
-             bookmark),
-   new_elem);
+    /* Step 4.17. */
+    treebuilder->move_element(new_elem,
+     InsertionLocation{TreeBuilder::share_element(furthest_block), nullptr});
 
-  /* Step 19. */
-  treebuilder->open_elements.erase(std::find(
-   treebuilder->open_elements.begin(),
-   treebuilder->open_elements.end(),
-   formatting_element));
+    /* Step 4.18. */
+    if (bookmark == nullptr)
+      afe.replace(formatting_element_idx, new_elem.get());
+    else
+      afe.move_after(formatting_element_idx, bookmark, new_elem.get());
 
-  treebuilder->open_elements.insert(
-    std::next(std::find(treebuilder->open_elements.begin(),
-                        treebuilder->open_elements.end(),
-                        furthest_block)),
-    new_elem);
+    /* Step 4.19. */
+    treebuilder->open_elements.erase(treebuilder->open_elements.find(formatting_element));
+    treebuilder->open_elements.insert(std::next(treebuilder->open_elements.find(furthest_block)),
+                                      new_elem.get());
+  }
 
-  return 0;
 }
 
 
@@ -984,10 +1112,10 @@ adoption_agency_algorithm(TreeBuilder *treebuilder,
   }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_body_mode(TreeBuilder *treebuilder,
-             union token_data *token_data,
-             enum token_type token_type)
+             union token_data *token_data)
 {
   // LOGF("in body mode\n");
 
@@ -1019,6 +1147,17 @@ in_body_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    treebuilder->reconstruct_active_formatting_elements();
+    treebuilder->insert_characters(token_data->chars);
+
+    if (has_non_whitespace(token_data->chars))
+      treebuilder->flags.frameset_ok = false;
+
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -1038,10 +1177,10 @@ in_body_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_HTML: {
         treebuilder->error();
 
-        if (std::find_if(begin(treebuilder->open_elements),
-                         end(treebuilder->open_elements),
-                         [](const auto& elem){ return elem->has_html_element_index(HTML_ELEMENT_TEMPLATE); })
-         != end(treebuilder->open_elements))
+        if (std::find_if(treebuilder->open_elements.begin(),
+                         treebuilder->open_elements.end(),
+                         [](const auto& elem){ return elem.has_html_element_index(HTML_ELEMENT_TEMPLATE); })
+         != treebuilder->open_elements.end())
           return TREEBUILDER_STATUS_IGNORE;
 
         /* XXX: foreach attr: maybe append */
@@ -1054,7 +1193,7 @@ in_body_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_LINK:   case HTML_ELEMENT_META:     case HTML_ELEMENT_NOFRAMES:
       case HTML_ELEMENT_SCRIPT: case HTML_ELEMENT_STYLE:    case HTML_ELEMENT_TEMPLATE:
       case HTML_ELEMENT_TITLE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -1062,11 +1201,11 @@ in_body_mode(TreeBuilder *treebuilder,
         treebuilder->error();
 
         if ((treebuilder->open_elements.size() == 1)
-         || ! treebuilder->open_elements[1]->has_html_element_index(HTML_ELEMENT_BODY)
-         || (std::find_if(begin(treebuilder->open_elements),
-                         end(treebuilder->open_elements),
-                         [](const auto& elem){ return elem->has_html_element_index(HTML_ELEMENT_TEMPLATE); })
-          != end(treebuilder->open_elements))) {
+         || ! treebuilder->open_elements[1].has_html_element_index(HTML_ELEMENT_BODY)
+         || (std::find_if(treebuilder->open_elements.begin(),
+                         treebuilder->open_elements.end(),
+                         [](const auto& elem){ return elem.has_html_element_index(HTML_ELEMENT_TEMPLATE); })
+          != treebuilder->open_elements.end())) {
           /* fragment case or there is a template element on the stack */
           return TREEBUILDER_STATUS_IGNORE;
         }
@@ -1150,10 +1289,10 @@ in_body_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_FORM: {
         /* XXX: ignore token */
         if ((treebuilder->form != nullptr)
-         && (std::find_if(begin(treebuilder->open_elements),
-                         end(treebuilder->open_elements),
-                         [](const auto &elem){ return elem->has_html_element_index(HTML_ELEMENT_TEMPLATE); })
-          == end(treebuilder->open_elements))) {
+         && (std::find_if(treebuilder->open_elements.begin(),
+                         treebuilder->open_elements.end(),
+                         [](const auto &elem){ return elem.has_html_element_index(HTML_ELEMENT_TEMPLATE); })
+          == treebuilder->open_elements.end())) {
           treebuilder->error();
           return TREEBUILDER_STATUS_IGNORE;
         }
@@ -1171,27 +1310,27 @@ in_body_mode(TreeBuilder *treebuilder,
         treebuilder->flags.frameset_ok = false;
 
         for (const auto& node : std::ranges::views::reverse(treebuilder->open_elements)) {
-          if (node->has_html_element_index(HTML_ELEMENT_LI)) {
+          if (node.has_html_element_index(HTML_ELEMENT_LI)) {
             treebuilder->generate_implied_end_tags(HTML_ELEMENT_LI);
 
             if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_LI))
               treebuilder->error();
 
-            std::shared_ptr< DOM::Element> popped;
+            struct open_element popped;
 
             do {
               popped = treebuilder->open_elements.back();
               treebuilder->open_elements.pop_back();
-            } while (! popped->has_html_element_index(HTML_ELEMENT_LI));
+            } while (! popped.has_html_element_index(HTML_ELEMENT_LI));
 
             break;
           }
 
 
           if (treebuilder->is_special_element(node)
-           && !( node->has_html_element_index(HTML_ELEMENT_ADDRESS)
-              || node->has_html_element_index(HTML_ELEMENT_DIV)
-              || node->has_html_element_index(HTML_ELEMENT_P)))
+           && !( node.has_html_element_index(HTML_ELEMENT_ADDRESS)
+              || node.has_html_element_index(HTML_ELEMENT_DIV)
+              || node.has_html_element_index(HTML_ELEMENT_P)))
             break;
         }
 
@@ -1207,27 +1346,27 @@ in_body_mode(TreeBuilder *treebuilder,
         treebuilder->flags.frameset_ok = false;
 
         for (const auto& node : std::ranges::views::reverse(treebuilder->open_elements)) {
-          if (node->has_html_element_index(tag->local_name)) {
+          if (node.has_html_element_index(tag->local_name)) {
             treebuilder->generate_implied_end_tags(tag->local_name);
 
             if (! treebuilder->current_node()->has_html_element_index(tag->local_name))
               treebuilder->error();
 
-            std::shared_ptr< DOM::Element> popped;
+            struct open_element popped;
 
             do {
               popped = treebuilder->open_elements.back();
               treebuilder->open_elements.pop_back();
-            } while (! popped->has_html_element_index(tag->local_name));
+            } while (! popped.has_html_element_index(tag->local_name));
 
             break;
           }
 
 
           if (treebuilder->is_special_element(node)
-           && !( node->has_html_element_index(HTML_ELEMENT_ADDRESS)
-              || node->has_html_element_index(HTML_ELEMENT_DIV)
-              || node->has_html_element_index(HTML_ELEMENT_P)))
+           && !( node.has_html_element_index(HTML_ELEMENT_ADDRESS)
+              || node.has_html_element_index(HTML_ELEMENT_DIV)
+              || node.has_html_element_index(HTML_ELEMENT_P)))
             break;
         }
 
@@ -1245,23 +1384,23 @@ in_body_mode(TreeBuilder *treebuilder,
 
         treebuilder->insert_html_element(tag);
 
-        treebuilder->tokenizer->state = PLAINTEXT_STATE;
+        treebuilder->switch_tokenizer_state(PLAINTEXT_STATE);
 
         return TREEBUILDER_STATUS_OK;
       }
 
 
       case HTML_ELEMENT_BUTTON: {
-        if (! treebuilder->have_element_in_scope(HTML_ELEMENT_BUTTON)) {
+        if (treebuilder->have_element_in_scope(HTML_ELEMENT_BUTTON)) {
           treebuilder->error();
           treebuilder->generate_implied_end_tags();
 
-          std::shared_ptr< DOM::Element> popped;
+          struct open_element popped;
 
           do {
             popped = treebuilder->open_elements.back();
             treebuilder->open_elements.pop_back();
-          } while (! popped->has_html_element_index(HTML_ELEMENT_BUTTON));
+          } while (! popped.has_html_element_index(HTML_ELEMENT_BUTTON));
 
         }
 
@@ -1276,24 +1415,37 @@ in_body_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_A: {
-        for (auto& elem : std::ranges::views::reverse(treebuilder->formatting_elements))
+        DOM::Element *a_elem = nullptr;
+
+        for (auto const& entry : std::ranges::views::reverse(treebuilder->formatting_elements))
         {
-          if (elem == treebuilder->FORMATTING_MARKER)
+          if (entry.is_marker())
             break;
 
-          if (elem->has_html_element_index(HTML_ELEMENT_A)) {
-            RUN_ADOPTION_AGENCY_ALGORITHM(treebuilder, tag);
-            treebuilder->formatting_elements.remove(elem);
-            // treebuilder->open_elements.remove(elem);
+          if (entry.element->has_html_element_index(HTML_ELEMENT_A)) {
+            a_elem = entry.element;
             break;
           }
 
         }
 
+        if (a_elem != nullptr) {
+          treebuilder->error();
+
+          RUN_ADOPTION_AGENCY_ALGORITHM(treebuilder, tag);
+
+          if (int idx = treebuilder->formatting_elements.index_of(a_elem);
+              idx != ActiveFormattingList::k_none)
+            treebuilder->formatting_elements.erase(idx);
+
+          if (auto it = treebuilder->open_elements.find(a_elem); it != treebuilder->open_elements.end())
+            treebuilder->open_elements.erase(it);
+        }
+
         treebuilder->reconstruct_active_formatting_elements();
 
         auto a_el = treebuilder->insert_html_element(tag);
-        treebuilder->push_to_active_formatting_elements(a_el);
+        treebuilder->push_to_active_formatting_elements(a_el.get(), tag);
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1306,7 +1458,7 @@ in_body_mode(TreeBuilder *treebuilder,
         treebuilder->reconstruct_active_formatting_elements();
 
         auto el = treebuilder->insert_html_element(tag);
-        treebuilder->push_to_active_formatting_elements(el);
+        treebuilder->push_to_active_formatting_elements(el.get(), tag);
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1325,7 +1477,7 @@ in_body_mode(TreeBuilder *treebuilder,
 
         auto nobr = treebuilder->insert_html_element(tag);
 
-        treebuilder->push_to_active_formatting_elements(nobr);
+        treebuilder->push_to_active_formatting_elements(nobr.get(), tag);
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1417,7 +1569,7 @@ in_body_mode(TreeBuilder *treebuilder,
 
         treebuilder->flags.skip_newline = true;
 
-        treebuilder->tokenizer->state = RCDATA_STATE;
+        treebuilder->switch_tokenizer_state(RCDATA_STATE);
         treebuilder->original_mode = treebuilder->mode;
         treebuilder->flags.frameset_ok = false;
 
@@ -1576,7 +1728,7 @@ in_body_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -1587,24 +1739,7 @@ in_body_mode(TreeBuilder *treebuilder,
         }
 
         for (const auto& elem : std::ranges::views::reverse(treebuilder->open_elements)) {
-          if (! (elem->has_html_element_index(HTML_ELEMENT_DD)
-              || elem->has_html_element_index(HTML_ELEMENT_DT)
-              || elem->has_html_element_index(HTML_ELEMENT_LI)
-              || elem->has_html_element_index(HTML_ELEMENT_OPTGROUP)
-              || elem->has_html_element_index(HTML_ELEMENT_OPTION)
-              || elem->has_html_element_index(HTML_ELEMENT_P)
-              || elem->has_html_element_index(HTML_ELEMENT_RB)
-              || elem->has_html_element_index(HTML_ELEMENT_RP)
-              || elem->has_html_element_index(HTML_ELEMENT_RT)
-              || elem->has_html_element_index(HTML_ELEMENT_RTC)
-              || elem->has_html_element_index(HTML_ELEMENT_TBODY)
-              || elem->has_html_element_index(HTML_ELEMENT_TD)
-              || elem->has_html_element_index(HTML_ELEMENT_TFOOT)
-              || elem->has_html_element_index(HTML_ELEMENT_TH)
-              || elem->has_html_element_index(HTML_ELEMENT_THEAD)
-              || elem->has_html_element_index(HTML_ELEMENT_TR)
-              || elem->has_html_element_index(HTML_ELEMENT_BODY)
-              || elem->has_html_element_index(HTML_ELEMENT_HTML))) {
+          if (! elem.has_category(ELEMENT_OPEN_AT_BODY_END)) {
             treebuilder->error();
             break;
           }
@@ -1623,24 +1758,7 @@ in_body_mode(TreeBuilder *treebuilder,
         }
 
         for (const auto& elem : std::ranges::views::reverse(treebuilder->open_elements)) {
-          if (! (elem->has_html_element_index(HTML_ELEMENT_DD)
-              || elem->has_html_element_index(HTML_ELEMENT_DT)
-              || elem->has_html_element_index(HTML_ELEMENT_LI)
-              || elem->has_html_element_index(HTML_ELEMENT_OPTGROUP)
-              || elem->has_html_element_index(HTML_ELEMENT_OPTION)
-              || elem->has_html_element_index(HTML_ELEMENT_P)
-              || elem->has_html_element_index(HTML_ELEMENT_RB)
-              || elem->has_html_element_index(HTML_ELEMENT_RP)
-              || elem->has_html_element_index(HTML_ELEMENT_RT)
-              || elem->has_html_element_index(HTML_ELEMENT_RTC)
-              || elem->has_html_element_index(HTML_ELEMENT_TBODY)
-              || elem->has_html_element_index(HTML_ELEMENT_TD)
-              || elem->has_html_element_index(HTML_ELEMENT_TFOOT)
-              || elem->has_html_element_index(HTML_ELEMENT_TH)
-              || elem->has_html_element_index(HTML_ELEMENT_THEAD)
-              || elem->has_html_element_index(HTML_ELEMENT_TR)
-              || elem->has_html_element_index(HTML_ELEMENT_BODY)
-              || elem->has_html_element_index(HTML_ELEMENT_HTML))) {
+          if (! elem.has_category(ELEMENT_OPEN_AT_BODY_END)) {
             treebuilder->error();
             break;
           }
@@ -1671,14 +1789,14 @@ in_body_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(tag->local_name))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           LOGF("open_elements has %d elements\n", static_cast<int>(treebuilder->open_elements.size()));
           popped = treebuilder->open_elements.back();
-          LOGF("popped: %d\n", static_cast<int>(popped->local_name));
+          LOGF("popped: %d\n", static_cast<int>(popped.local_name));
           treebuilder->open_elements.pop_back();
-        }  while (! popped->has_html_element_index(tag->local_name));
+        }  while (! popped.has_html_element_index(tag->local_name));
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1721,12 +1839,12 @@ in_body_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_LI))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_LI));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_LI));
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1743,12 +1861,12 @@ in_body_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(tag->local_name))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(tag->local_name));
+        } while (! popped.has_html_element_index(tag->local_name));
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1773,17 +1891,17 @@ in_body_mode(TreeBuilder *treebuilder,
         if (!treebuilder->current_node()->has_html_element_index(tag->local_name))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! (popped->has_html_element_index(HTML_ELEMENT_H1)
-                 || popped->has_html_element_index(HTML_ELEMENT_H2)
-                 || popped->has_html_element_index(HTML_ELEMENT_H3)
-                 || popped->has_html_element_index(HTML_ELEMENT_H4)
-                 || popped->has_html_element_index(HTML_ELEMENT_H5)
-                 || popped->has_html_element_index(HTML_ELEMENT_H6)));
+        } while (! (popped.has_html_element_index(HTML_ELEMENT_H1)
+                 || popped.has_html_element_index(HTML_ELEMENT_H2)
+                 || popped.has_html_element_index(HTML_ELEMENT_H3)
+                 || popped.has_html_element_index(HTML_ELEMENT_H4)
+                 || popped.has_html_element_index(HTML_ELEMENT_H5)
+                 || popped.has_html_element_index(HTML_ELEMENT_H6)));
 
         return TREEBUILDER_STATUS_OK;
       }
@@ -1810,12 +1928,12 @@ in_body_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(tag->local_name))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! (popped->has_html_element_index(tag->local_name)));
+        } while (! (popped.has_html_element_index(tag->local_name)));
 
         treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -1835,20 +1953,22 @@ any_other_end_tag:
 
         for (const auto& node : std::ranges::views::reverse(treebuilder->open_elements))
         {
-          if (node->name_space == INFRA_NAMESPACE_HTML
-           && node->local_name == tag->local_name) {
+          if (node.name_space == INFRA_NAMESPACE_HTML
+           && node.local_name == tag->local_name) {
+            /* node doesn't survive the pops below */
+            DOM::Element *target = node.element;
 
             treebuilder->generate_implied_end_tags(tag->local_name);
 
-            if (node != treebuilder->current_node())
+            if (target != treebuilder->current_node())
               treebuilder->error();
 
-            std::shared_ptr< DOM::Element> popped;
+            struct open_element popped;
 
             do {
               popped = treebuilder->open_elements.back();
               treebuilder->open_elements.pop_back();
-            } while (popped != node);
+            } while (popped.element != target);
 
             break;
           }
@@ -1868,26 +1988,10 @@ any_other_end_tag:
 
   if (token_type == TOKEN_EOF) {
     if (! treebuilder->template_modes.empty())
-      return in_template_mode(treebuilder, token_data, token_type);
+      return in_template_mode<token_type>(treebuilder, token_data);
 
     for (const auto& elem : treebuilder->open_elements) {
-      if (! (elem->has_html_element_index(HTML_ELEMENT_DD)
-          || elem->has_html_element_index(HTML_ELEMENT_DT)
-          || elem->has_html_element_index(HTML_ELEMENT_LI)
-          || elem->has_html_element_index(HTML_ELEMENT_OPTGROUP)
-          || elem->has_html_element_index(HTML_ELEMENT_OPTION)
-          || elem->has_html_element_index(HTML_ELEMENT_P)
-          || elem->has_html_element_index(HTML_ELEMENT_RB)
-          || elem->has_html_element_index(HTML_ELEMENT_RP)
-          || elem->has_html_element_index(HTML_ELEMENT_RT)
-          || elem->has_html_element_index(HTML_ELEMENT_RTC)
-          || elem->has_html_element_index(HTML_ELEMENT_TBODY)
-          || elem->has_html_element_index(HTML_ELEMENT_TD)
-          || elem->has_html_element_index(HTML_ELEMENT_TFOOT)
-          || elem->has_html_element_index(HTML_ELEMENT_TH)
-          || elem->has_html_element_index(HTML_ELEMENT_THEAD)
-          || (elem == treebuilder->open_elements[1])
-          || (elem == treebuilder->open_elements[0]))) {
+      if (! elem.has_category(ELEMENT_OPEN_AT_BODY_END)) {
         treebuilder->error();
         break;
       }
@@ -1902,10 +2006,10 @@ any_other_end_tag:
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 text_mode(TreeBuilder *treebuilder,
-          union token_data *token_data,
-          enum token_type token_type)
+          union token_data *token_data)
 {
   LOGF("text mode\n");
 
@@ -1915,6 +2019,12 @@ text_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    treebuilder->insert_characters(token_data->chars);
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
   if (token_type == TOKEN_EOF) {
     treebuilder->error();
 
@@ -1958,7 +2068,7 @@ text_mode(TreeBuilder *treebuilder,
   }
 
 
-  printf("what???\n");
+  LOGF("what???\n");
   // std::unreachable();
   return TREEBUILDER_STATUS_OK;
 }
@@ -1975,14 +2085,15 @@ clear_stack_to_table_context(TreeBuilder *treebuilder)
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_table_mode(TreeBuilder *treebuilder,
-              union token_data *token_data,
-              enum token_type token_type)
+              union token_data *token_data)
 {
   LOGF("in table mode\n");
 
-  if (token_type == TOKEN_CHARACTER || token_type == TOKEN_WHITESPACE) {
+  if (token_type == TOKEN_CHARACTER || token_type == TOKEN_WHITESPACE
+   || token_type == TOKEN_CHARACTER_RUN) {
     if ((treebuilder->current_node()->name_space == INFRA_NAMESPACE_HTML)
      && (treebuilder->current_node()->local_name == HTML_ELEMENT_TABLE
       || treebuilder->current_node()->local_name == HTML_ELEMENT_TBODY
@@ -2091,13 +2202,13 @@ in_table_mode(TreeBuilder *treebuilder,
         treebuilder->error();
         /* XXX: table in scope */
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! (popped->name_space == INFRA_NAMESPACE_HTML
-                 && popped->local_name == HTML_ELEMENT_TABLE));
+        } while (! (popped.name_space == INFRA_NAMESPACE_HTML
+                 && popped.local_name == HTML_ELEMENT_TABLE));
 
         treebuilder->reset_insertion_mode_appropriately();
 
@@ -2106,7 +2217,7 @@ in_table_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_STYLE: case HTML_ELEMENT_SCRIPT: case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -2148,16 +2259,19 @@ in_table_mode(TreeBuilder *treebuilder,
 
 
   if (token_type == TOKEN_EOF) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
   anything_else: {
-    treebuilder->error();
+    if (token_type == TOKEN_CHARACTER_RUN)
+      error_per_code_point(treebuilder, token_data->chars);
+    else
+      treebuilder->error();
 
     treebuilder->flags.foster_parenting = true;
 
-    enum treebuilder_status rc = in_body_mode(treebuilder, token_data, token_type);
+    enum treebuilder_status rc = in_body_mode<token_type>(treebuilder, token_data);
 
     treebuilder->flags.foster_parenting = false;
 
@@ -2167,10 +2281,10 @@ in_table_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_table_text_mode(TreeBuilder *treebuilder,
-                   union token_data *token_data,
-                   enum token_type token_type)
+                   union token_data *token_data)
 {
   LOGF("in table text mode\n");
 
@@ -2180,7 +2294,13 @@ in_table_text_mode(TreeBuilder *treebuilder,
       return TREEBUILDER_STATUS_IGNORE;
     }
 
-    treebuilder->pending_table_characters.push_back(token_data->ch);
+    QueequegLib::append_c32_as_utf8(&treebuilder->pending_table_characters, token_data->ch);
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    treebuilder->pending_table_characters.append(token_data->chars);
     return TREEBUILDER_STATUS_OK;
   }
 
@@ -2188,7 +2308,7 @@ in_table_text_mode(TreeBuilder *treebuilder,
   /* anything_else: */ {
     /* XXX: ... */
 
-    treebuilder->insert_characters(&treebuilder->pending_table_characters);
+    treebuilder->insert_characters(treebuilder->pending_table_characters);
 
     treebuilder->mode = treebuilder->original_mode;
 
@@ -2198,10 +2318,10 @@ in_table_text_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_caption_mode(TreeBuilder *treebuilder,
-                union token_data *token_data,
-                enum token_type token_type)
+                union token_data *token_data)
 {
   LOGF("in caption mode\n");
 
@@ -2224,12 +2344,12 @@ in_caption_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_CAPTION))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_CAPTION));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_CAPTION));
 
         treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -2250,12 +2370,12 @@ in_caption_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_CAPTION))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_CAPTION));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_CAPTION));
 
         /* XXX: clear to last marker */
 
@@ -2302,12 +2422,12 @@ in_caption_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_CAPTION))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_CAPTION));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_CAPTION));
 
         treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -2324,16 +2444,16 @@ in_caption_mode(TreeBuilder *treebuilder,
 
 
   anything_else: {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_column_group_mode(TreeBuilder *treebuilder,
-                     union token_data *token_data,
-                     enum token_type token_type)
+                     union token_data *token_data)
 {
   LOGF("in column group mode\n");
 
@@ -2343,6 +2463,19 @@ in_column_group_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    std::string_view whitespace = split_leading_whitespace(token_data);
+
+    if (! whitespace.empty())
+      treebuilder->insert_characters(whitespace);
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_OK;
+
+    goto anything_else;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -2361,7 +2494,7 @@ in_column_group_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -2374,7 +2507,7 @@ in_column_group_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -2415,7 +2548,7 @@ in_column_group_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -2455,10 +2588,10 @@ clear_stack_to_table_body_context(TreeBuilder *treebuilder)
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_table_body_mode(TreeBuilder *treebuilder,
-                   union token_data *token_data,
-                   enum token_type token_type)
+                   union token_data *token_data)
 {
   LOGF("in table body mode\n");
 
@@ -2583,7 +2716,7 @@ in_table_body_mode(TreeBuilder *treebuilder,
 
 
   anything_else: {
-    return in_table_mode(treebuilder, token_data, token_type);
+    return in_table_mode<token_type>(treebuilder, token_data);
   }
 
 }
@@ -2592,22 +2725,17 @@ in_table_body_mode(TreeBuilder *treebuilder,
 static void
 clear_stack_to_table_row_context(TreeBuilder *treebuilder)
 {
-  std::shared_ptr< DOM::Element> popped;
-
-  do {
-    popped = treebuilder->open_elements.back();
+  while (! (treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_TR)
+         || treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_TEMPLATE)
+         || treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_HTML)))
     treebuilder->open_elements.pop_back();
-  } while (! (popped->has_html_element_index(HTML_ELEMENT_TR)
-           || popped->has_html_element_index(HTML_ELEMENT_TEMPLATE)
-           || popped->has_html_element_index(HTML_ELEMENT_HTML)));
-
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_row_mode(TreeBuilder *treebuilder,
-            union token_data *token_data,
-            enum token_type token_type)
+            union token_data *token_data)
 {
   LOGF("in row mode\n");
 
@@ -2700,7 +2828,7 @@ in_row_mode(TreeBuilder *treebuilder,
 
 
   anything_else: {
-    return in_table_mode(treebuilder, token_data, token_type);
+    return in_table_mode<token_type>(treebuilder, token_data);
   }
 
 }
@@ -2715,13 +2843,13 @@ close_cell(TreeBuilder *treebuilder)
       || treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_TH)))
     treebuilder->error();
 
-  std::shared_ptr< DOM::Element> popped;
+  struct open_element popped;
 
   do {
     popped = treebuilder->open_elements.back();
     treebuilder->open_elements.pop_back();
-  } while (! (popped->has_html_element_index(HTML_ELEMENT_TD)
-           || popped->has_html_element_index(HTML_ELEMENT_TH)));
+  } while (! (popped.has_html_element_index(HTML_ELEMENT_TD)
+           || popped.has_html_element_index(HTML_ELEMENT_TH)));
 
   treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -2729,10 +2857,10 @@ close_cell(TreeBuilder *treebuilder)
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_cell_mode(TreeBuilder *treebuilder,
-             union token_data *token_data,
-             enum token_type token_type)
+             union token_data *token_data)
 {
   LOGF("in cell mode\n");
 
@@ -2753,12 +2881,12 @@ in_cell_mode(TreeBuilder *treebuilder,
         if (! treebuilder->current_node()->has_html_element_index(tag->local_name))
           treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(tag->local_name));
+        } while (! popped.has_html_element_index(tag->local_name));
 
         treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -2811,16 +2939,16 @@ in_cell_mode(TreeBuilder *treebuilder,
 
 
   anything_else: {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_select_mode(TreeBuilder *treebuilder,
-               union token_data *token_data,
-               enum token_type token_type)
+               union token_data *token_data)
 {
   LOGF("in select mode\n");
 
@@ -2835,6 +2963,12 @@ in_select_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    treebuilder->insert_characters(token_data->chars);
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -2853,7 +2987,7 @@ in_select_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -2905,12 +3039,12 @@ in_select_mode(TreeBuilder *treebuilder,
           return TREEBUILDER_STATUS_IGNORE;
         }
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_SELECT));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_SELECT));
 
         treebuilder->reset_insertion_mode_appropriately();
 
@@ -2926,12 +3060,12 @@ in_select_mode(TreeBuilder *treebuilder,
           return TREEBUILDER_STATUS_IGNORE;
         }
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_SELECT));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_SELECT));
 
         treebuilder->reset_insertion_mode_appropriately();
 
@@ -2940,7 +3074,7 @@ in_select_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_SCRIPT: case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -2960,7 +3094,7 @@ in_select_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_OPTGROUP: {
         if (treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_OPTION)
          && treebuilder->open_elements[
-             treebuilder->open_elements.size() - 2]->has_html_element_index(HTML_ELEMENT_OPTGROUP))
+             treebuilder->open_elements.size() - 2].has_html_element_index(HTML_ELEMENT_OPTGROUP))
           treebuilder->open_elements.pop_back();
 
         if (treebuilder->current_node()->has_html_element_index(HTML_ELEMENT_OPTGROUP)) {
@@ -2991,12 +3125,12 @@ in_select_mode(TreeBuilder *treebuilder,
           return TREEBUILDER_STATUS_IGNORE;
         }
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_SELECT));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_SELECT));
 
         treebuilder->reset_insertion_mode_appropriately();
 
@@ -3005,7 +3139,7 @@ in_select_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3018,7 +3152,7 @@ in_select_mode(TreeBuilder *treebuilder,
 
 
   if (token_type == TOKEN_EOF) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
@@ -3030,10 +3164,10 @@ in_select_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_select_in_table_mode(TreeBuilder *treebuilder,
-                        union token_data *token_data,
-                        enum token_type token_type)
+                        union token_data *token_data)
 {
   LOGF("in select in table mode\n");
 
@@ -3047,12 +3181,12 @@ in_select_in_table_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_TD:      case HTML_ELEMENT_TH: {
         treebuilder->error();
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_SELECT));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_SELECT));
 
         treebuilder->reset_insertion_mode_appropriately();
 
@@ -3081,12 +3215,12 @@ in_select_in_table_mode(TreeBuilder *treebuilder,
                static_cast<enum html_element_index>(tag->local_name)))
           return TREEBUILDER_STATUS_IGNORE;
 
-        std::shared_ptr< DOM::Element> popped;
+        struct open_element popped;
 
         do {
           popped = treebuilder->open_elements.back();
           treebuilder->open_elements.pop_back();
-        } while (! popped->has_html_element_index(HTML_ELEMENT_SELECT));
+        } while (! popped.has_html_element_index(HTML_ELEMENT_SELECT));
 
         treebuilder->reset_insertion_mode_appropriately();
 
@@ -3102,31 +3236,32 @@ in_select_in_table_mode(TreeBuilder *treebuilder,
 
 
   anything_else: {
-    return in_select_mode(treebuilder, token_data, token_type);
+    return in_select_mode<token_type>(treebuilder, token_data);
   }
 
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_template_mode(TreeBuilder *treebuilder,
-                 union token_data *token_data,
-                 enum token_type token_type)
+                 union token_data *token_data)
 {
   LOGF("in template mode\n");
 
-  if (token_type == TOKEN_CHARACTER) {
-    return in_body_mode(treebuilder, token_data, token_type);
+  if (token_type == TOKEN_CHARACTER || token_type == TOKEN_WHITESPACE
+   || token_type == TOKEN_CHARACTER_RUN) {
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
   if (token_type == TOKEN_COMMENT) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
   if (token_type == TOKEN_DOCTYPE) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
@@ -3139,7 +3274,7 @@ in_template_mode(TreeBuilder *treebuilder,
       case HTML_ELEMENT_LINK:   case HTML_ELEMENT_META:     case HTML_ELEMENT_NOFRAMES:
       case HTML_ELEMENT_SCRIPT: case HTML_ELEMENT_STYLE:    case HTML_ELEMENT_TEMPLATE:
       case HTML_ELEMENT_TITLE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3195,7 +3330,7 @@ in_template_mode(TreeBuilder *treebuilder,
     {
 
       case HTML_ELEMENT_TEMPLATE: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3215,12 +3350,12 @@ in_template_mode(TreeBuilder *treebuilder,
 
     treebuilder->error();
 
-    std::shared_ptr< DOM::Element> popped;
+    struct open_element popped;
 
     do {
       popped = treebuilder->open_elements.back();
       treebuilder->open_elements.pop_back();
-    } while (! popped->has_html_element_index(HTML_ELEMENT_TEMPLATE));
+    } while (! popped.has_html_element_index(HTML_ELEMENT_TEMPLATE));
 
     treebuilder->clear_active_formatting_elements_to_marker();
 
@@ -3240,21 +3375,34 @@ in_template_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 after_body_mode(TreeBuilder *treebuilder,
-                union token_data *token_data,
-                enum token_type token_type)
+                union token_data *token_data)
 {
   LOGF("after body mode\n");
 
   if (token_type == TOKEN_WHITESPACE) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
+  }
+
+
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    std::string_view whitespace = split_leading_whitespace(token_data);
+
+    if (! whitespace.empty())
+      (void) in_body_mode<token_type>(treebuilder, reinterpret_cast<union token_data *>(&whitespace));
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_OK;
+
+    goto anything_else;
   }
 
 
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment,
-     InsertionLocation{std::dynamic_pointer_cast<DOM::Node>(treebuilder->open_elements.front()), nullptr});
+     InsertionLocation{TreeBuilder::share_element(treebuilder->open_elements.front().element), nullptr});
     return TREEBUILDER_STATUS_OK;
   }
 
@@ -3271,7 +3419,7 @@ after_body_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
       default:
@@ -3323,10 +3471,10 @@ after_body_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_frameset_mode(TreeBuilder *treebuilder,
-                 union token_data *token_data,
-                 enum token_type token_type)
+                 union token_data *token_data)
 {
   LOGF("in frameset mode\n");
 
@@ -3336,6 +3484,16 @@ in_frameset_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    keep_whitespace(treebuilder, token_data->chars,
+                    [treebuilder](std::string_view whitespace) {
+                      treebuilder->insert_characters(whitespace);
+                    });
+
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -3354,7 +3512,7 @@ in_frameset_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3373,7 +3531,7 @@ in_frameset_mode(TreeBuilder *treebuilder,
 
 
       case HTML_ELEMENT_NOFRAMES: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3390,7 +3548,7 @@ in_frameset_mode(TreeBuilder *treebuilder,
 
     switch (tag->local_name) {
       case HTML_ELEMENT_FRAMESET: {
-        if (treebuilder->current_node() == treebuilder->open_elements.front()) {
+        if (treebuilder->current_node() == treebuilder->open_elements.front().element) {
           /* fragment case */
           treebuilder->error();
           return TREEBUILDER_STATUS_IGNORE;
@@ -3414,7 +3572,7 @@ in_frameset_mode(TreeBuilder *treebuilder,
 
 
   if (token_type == TOKEN_EOF) {
-    if (treebuilder->current_node() != treebuilder->open_elements.front())
+    if (treebuilder->current_node() != treebuilder->open_elements.front().element)
       treebuilder->error();
 
     return TREEBUILDER_STATUS_STOP;
@@ -3429,10 +3587,10 @@ in_frameset_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 after_frameset_mode(TreeBuilder *treebuilder,
-                    union token_data *token_data,
-                    enum token_type token_type)
+                    union token_data *token_data)
 {
   LOGF("after frameset mode\n");
 
@@ -3442,6 +3600,16 @@ after_frameset_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    keep_whitespace(treebuilder, token_data->chars,
+                    [treebuilder](std::string_view whitespace) {
+                      treebuilder->insert_characters(whitespace);
+                    });
+
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -3460,12 +3628,12 @@ after_frameset_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
       case HTML_ELEMENT_NOFRAMES: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3509,10 +3677,10 @@ after_frameset_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 after_after_body_mode(TreeBuilder *treebuilder,
-                      union token_data *token_data,
-                      enum token_type token_type)
+                      union token_data *token_data)
 {
   LOGF("after after body mode\n");
 
@@ -3524,12 +3692,25 @@ after_after_body_mode(TreeBuilder *treebuilder,
 
 
   if (token_type == TOKEN_DOCTYPE) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
   if (token_type == TOKEN_WHITESPACE) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
+  }
+
+
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    std::string_view whitespace = split_leading_whitespace(token_data);
+
+    if (! whitespace.empty())
+      (void) in_body_mode<token_type>(treebuilder, reinterpret_cast<union token_data *>(&whitespace));
+
+    if (token_data->chars.empty())
+      return TREEBUILDER_STATUS_OK;
+
+    goto anything_else;
   }
 
 
@@ -3539,7 +3720,7 @@ after_after_body_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3561,10 +3742,10 @@ after_after_body_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 after_after_frameset_mode(TreeBuilder *treebuilder,
-                          union token_data *token_data,
-                          enum token_type token_type)
+                          union token_data *token_data)
 {
   LOGF("after after frameset mode\n");
 
@@ -3576,12 +3757,23 @@ after_after_frameset_mode(TreeBuilder *treebuilder,
 
 
   if (token_type == TOKEN_DOCTYPE) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
   }
 
 
   if (token_type == TOKEN_WHITESPACE) {
-    return in_body_mode(treebuilder, token_data, token_type);
+    return in_body_mode<token_type>(treebuilder, token_data);
+  }
+
+
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    keep_whitespace(treebuilder, token_data->chars,
+                    [treebuilder](std::string_view whitespace) {
+                      (void) in_body_mode<token_type>(treebuilder,
+                       reinterpret_cast<union token_data *>(&whitespace));
+                    });
+
+    return TREEBUILDER_STATUS_OK;
   }
 
 
@@ -3591,12 +3783,12 @@ after_after_frameset_mode(TreeBuilder *treebuilder,
     switch (tag->local_name)
     {
       case HTML_ELEMENT_HTML: {
-        return in_body_mode(treebuilder, token_data, token_type);
+        return in_body_mode<token_type>(treebuilder, token_data);
       }
 
 
       case HTML_ELEMENT_NOFRAMES: {
-        return in_head_mode(treebuilder, token_data, token_type);
+        return in_head_mode<token_type>(treebuilder, token_data);
       }
 
 
@@ -3621,10 +3813,10 @@ after_after_frameset_mode(TreeBuilder *treebuilder,
 }
 
 
+template< enum token_type token_type>
 static enum treebuilder_status
 in_foreign_content_mode(TreeBuilder *treebuilder,
-                        union token_data *token_data,
-                        enum token_type token_type)
+                        union token_data *token_data)
 {
   LOGF("in foreign content mode\n");
 
@@ -3647,6 +3839,16 @@ in_foreign_content_mode(TreeBuilder *treebuilder,
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    treebuilder->insert_characters(token_data->chars);
+
+    if (has_non_whitespace(token_data->chars))
+      treebuilder->flags.frameset_ok = false;
+
+    return TREEBUILDER_STATUS_OK;
+  }
+
+
   if (token_type == TOKEN_COMMENT) {
     treebuilder->insert_comment(&token_data->comment);
     return TREEBUILDER_STATUS_OK;
@@ -3670,30 +3872,50 @@ in_foreign_content_mode(TreeBuilder *treebuilder,
 }
 
 
-const TreeBuilder::insertion_mode_handler_cb_t TreeBuilder::k_insertion_mode_handlers_[NUM_MODES] = {
-  initial_mode,
-  before_html_mode,
-  before_head_mode,
-  in_head_mode,
-  in_head_noscript_mode,
-  after_head_mode,
-  in_body_mode,
-  text_mode,
-  in_table_mode,
-  in_table_text_mode,
-  in_caption_mode,
-  in_column_group_mode,
-  in_table_body_mode,
-  in_row_mode,
-  in_cell_mode,
-  in_select_mode,
-  in_select_in_table_mode,
-  in_template_mode,
-  after_body_mode,
-  in_frameset_mode,
-  after_frameset_mode,
-  after_after_body_mode,
-  after_after_frameset_mode,
-  in_foreign_content_mode,
+/*
+ * Every mode is instantiated once per token type, each instantiation keeping
+ * only the branches for its own type; dispatching a token (or reprocessing
+ * it in another mode) is then a single indirect call.
+ */
+#define TOKEN_HANDLERS_(mode_handler_) \
+  { \
+    mode_handler_<TOKEN_CHARACTER>, \
+    mode_handler_<TOKEN_WHITESPACE>, \
+    mode_handler_<TOKEN_CHARACTER_RUN>, \
+    mode_handler_<TOKEN_DOCTYPE>, \
+    mode_handler_<TOKEN_START_TAG>, \
+    mode_handler_<TOKEN_END_TAG>, \
+    mode_handler_<TOKEN_COMMENT>, \
+    mode_handler_<TOKEN_EOF>, \
+  }
+
+constinit const TreeBuilder::insertion_mode_handler_cb_t
+TreeBuilder::k_insertion_mode_handlers_[NUM_MODES][NUM_TOKEN_TYPES] = {
+  TOKEN_HANDLERS_(initial_mode),
+  TOKEN_HANDLERS_(before_html_mode),
+  TOKEN_HANDLERS_(before_head_mode),
+  TOKEN_HANDLERS_(in_head_mode),
+  TOKEN_HANDLERS_(in_head_noscript_mode),
+  TOKEN_HANDLERS_(after_head_mode),
+  TOKEN_HANDLERS_(in_body_mode),
+  TOKEN_HANDLERS_(text_mode),
+  TOKEN_HANDLERS_(in_table_mode),
+  TOKEN_HANDLERS_(in_table_text_mode),
+  TOKEN_HANDLERS_(in_caption_mode),
+  TOKEN_HANDLERS_(in_column_group_mode),
+  TOKEN_HANDLERS_(in_table_body_mode),
+  TOKEN_HANDLERS_(in_row_mode),
+  TOKEN_HANDLERS_(in_cell_mode),
+  TOKEN_HANDLERS_(in_select_mode),
+  TOKEN_HANDLERS_(in_select_in_table_mode),
+  TOKEN_HANDLERS_(in_template_mode),
+  TOKEN_HANDLERS_(after_body_mode),
+  TOKEN_HANDLERS_(in_frameset_mode),
+  TOKEN_HANDLERS_(after_frameset_mode),
+  TOKEN_HANDLERS_(after_after_body_mode),
+  TOKEN_HANDLERS_(after_after_frameset_mode),
+  TOKEN_HANDLERS_(in_foreign_content_mode),
 };
 
+#undef TOKEN_HANDLERS_
+
@@ -13,16 +13,20 @@
  * together properly.
  */
 
+#include <algorithm>
+#include <array>
 #include <concepts>
 #include <initializer_list>
+#include <span>
 
 #include <memory>
+#include <memory_resource>
 #include <vector>
-#include <list>
 #include <string>
-#include <unordered_map>
-#include <map>
+#include <string_view>
+#include <unordered_set>
 
+#include <stdint.h>
 #include <string.h>
 
 #include <infra/namespace.h>
@@ -30,14 +34,26 @@
 #include "dom/core/node.hh"
 #include "dom/core/document.hh"
 #include "dom/core/element.hh"
+#include "dom/core/text.hh"
 
 #include "dom/html/html_head_element.hh"
 
 #include "html/elements.hh"
 
+#include "html_parser/element_categories.hh"
+#include "html_parser/parse_error.hh"
 
-class Tokenizer;
+#include "qglib/borrowed_string.hh"
+#include "qglib/small_vector.hh"
+
+
+template< typename Sink> class BasicTokenizer;
 class TreeBuilder;
+class TokenQueue;
+class TokenReplay;
+class TreeEventHandler;
+
+typedef BasicTokenizer< TreeBuilder> Tokenizer;
 
 /*
  * Token structs are always simple aggregate types; their memory
@@ -49,18 +65,27 @@ class TreeBuilder;
 enum token_type {
   TOKEN_CHARACTER,
   TOKEN_WHITESPACE,
+  TOKEN_CHARACTER_RUN,
   TOKEN_DOCTYPE,
   TOKEN_START_TAG,
   TOKEN_END_TAG,
   TOKEN_COMMENT,
   TOKEN_EOF,
+
+  NUM_TOKEN_TYPES
 };
 
 
+/*
+ * Token strings borrow from the input buffer for as long as they are verbatim
+ * slices of it (see QueequegLib::BorrowedString); consumers that outlive the
+ * input must own() them.
+ */
+
 struct doctype_token {
-  std::string name;
-  std::string public_id;
-  std::string system_id;
+  QueequegLib::BorrowedString name;
+  QueequegLib::BorrowedString public_id;
+  QueequegLib::BorrowedString system_id;
 
   bool public_id_missing;
   bool system_id_missing;
@@ -84,13 +109,61 @@ enum html_element_index_parser_internal : uint16_t {
 };
 
 
+struct tag_attribute {
+  QueequegLib::BorrowedString name;
+  QueequegLib::BorrowedString value;
+};
+
+
+/*
+ * A tag's attributes in source order. Most tags have a handful at most, so
+ * they live inline and duplicates are found with a linear scan; past
+ * k_linear_max_ the names are also tracked by hash.
+ */
+class AttributeList final {
+  public:
+    [[nodiscard]] inline size_t size(void) const { return this->list_.size(); }
+    [[nodiscard]] inline bool empty(void) const { return this->list_.empty(); }
+
+    [[nodiscard]] inline struct tag_attribute *begin(void) { return this->list_.begin(); }
+    [[nodiscard]] inline struct tag_attribute *end(void) { return this->list_.end(); }
+    [[nodiscard]] inline struct tag_attribute const *begin(void) const { return this->list_.begin(); }
+    [[nodiscard]] inline struct tag_attribute const *end(void) const { return this->list_.end(); }
+
+    [[nodiscard]] bool contains(std::string_view name) const;
+    [[nodiscard]] QueequegLib::BorrowedString const *find(std::string_view name) const;
+
+    /*
+     * The caller checks for duplicates; the returned pointer is valid until
+     * the next append()
+     */
+    struct tag_attribute *append(QueequegLib::BorrowedString const& name);
+
+    void clear(void);
+    void own(void);
+
+
+  private:
+    static constexpr size_t k_linear_max_ = 8;
+
+    QueequegLib::SmallVector< struct tag_attribute, 4> list_;
+    /* only filled in past k_linear_max_ */
+    std::unordered_set<uint32_t> name_hashes_;
+};
+
+
 struct tag_token {
-  std::string tag_name;
+  QueequegLib::BorrowedString tag_name;
   uint16_t local_name;
-  std::map< std::string, std::string> attributes;
+  AttributeList attributes;
 
   bool self_closing_flag;
   bool ack_self_closing_flag_;
+
+  /*
+   * Detaches the token's strings from the input buffer
+   */
+  void own(void);
 };
 
 
@@ -101,10 +174,18 @@ struct tag_token {
  */
 
 union token_data {
-  std::string           comment;
+  QueequegLib::BorrowedString comment;
   struct doctype_token  doctype;
   struct tag_token      tag;
   char32_t              ch;
+  /*
+   * TOKEN_CHARACTER_RUN: a sequence of character tokens as UTF-8, straight
+   * from the input buffer (or the replacement text of a named character
+   * reference). It never contains NUL or CR, but may freely mix
+   * whitespace with other characters; the insertion modes split it up where
+   * they need to.
+   */
+  std::string_view      chars;
 };
 
 
@@ -123,6 +204,7 @@ struct InsertionLocation {
 enum tokenizer_state {
   /*
    * 0 needed for jump table to work properly
+   * The text states must come first, see Tokenizer::run()
    */
   DATA_STATE = 0,
   RCDATA_STATE,
@@ -214,42 +296,140 @@ enum tokenizer_status {
   TOKENIZER_STATUS_OK,
   TOKENIZER_STATUS_IGNORE,
   TOKENIZER_STATUS_EOF,
+  /*
+   * the state handler needs more input than the current chunk has to offer;
+   * it must not have consumed anything yet
+   */
+  TOKENIZER_STATUS_SUSPEND,
+};
+
+
+/*
+ * See Tokenizer::run_threaded_(); needs GCC's labels-as-values
+ */
+#if defined(TOKENIZER_THREADED_DISPATCH) && ! defined(__GNUC__)
+# undef TOKENIZER_THREADED_DISPATCH
+#endif
+
+
+/*
+ * Where the tokenizer stands in between two tokens, as far as it matters for
+ * going on from there (see Tokenizer::rewind())
+ */
+struct tokenizer_checkpoint {
+  char const *p;
+  /*
+   * input.invalid back then: [p, invalid) needn't be validated again
+   */
+  char const *invalid;
+  enum tokenizer_state state;
+  QueequegLib::BorrowedString last_start_tag_name;
+  uint32_t last_start_tag_hash;
 };
 
 
-class Tokenizer final {
+/*
+ * What the tokenizer hands its tokens to:
+ *
+ *   void process_token(union token_data *token_data, enum token_type token_type);
+ *   bool allows_cdata_section(void);
+ *
+ * the latter being asked whether "<![CDATA[" starts a CDATA section rather
+ * than a bogus comment. A sink may also take the tokenizer's parse errors in
+ * place of its ParseErrorSink, with
+ *
+ *   void report_error(enum parse_error_code code, size_t offset);
+ *
+ * and one without a tree builder behind it can have the tokenizer switch to
+ * the text states after start tags by itself (see
+ * guess_tokenizer_state_after()), with
+ *
+ *   static constexpr bool k_guesses_text_states = true;
+ *
+ * The calls are resolved (and usually inlined) at compile time; each sink
+ * gets a tokenizer of its own, instantiated by the library for the sinks in
+ * TOKEN_SINKS (see html_parser/tokenize.hh) and for any other with
+ * HTML_TOKENIZER_INSTANTIATE() (see html_parser/tokenizer_impl.hh).
+ */
+template< typename Sink>
+concept TokenSink = requires (Sink *sink, union token_data *token_data,
+                              enum token_type token_type) {
+  sink->process_token(token_data, token_type);
+  { sink->allows_cdata_section() } -> std::same_as< bool>;
+};
+
+
+/*
+ * The state the tree builder switches the tokenizer to after tag, in every
+ * insertion mode that doesn't just ignore it; natural_state for any tag that
+ * leaves the tokenizer where it put itself
+ */
+[[nodiscard]] enum tokenizer_state guess_tokenizer_state_after(struct tag_token const *tag,
+                                                               bool scripting,
+                                                               enum tokenizer_state natural_state);
+
+
+template< typename Sink>
+class BasicTokenizer final {
   public:
-      Tokenizer(char const *input, size_t input_len);
-    ~Tokenizer();
+      BasicTokenizer(void);
+      /*
+       * For a complete document (or a piece of one, starting at input_offset
+       * in it) that outlives the tokenizer; feed() and finish() must not be
+       * used then
+       */
+      BasicTokenizer(char const *input, size_t input_len, size_t input_offset = 0);
+    ~BasicTokenizer();
 
 
   public:
     /*
      * Handlers
      */
-    typedef enum tokenizer_status (* const state_handler_cb_t) (Tokenizer *tokenizer, char32_t ch);
+    typedef enum tokenizer_status (* const state_handler_cb_t) (BasicTokenizer *tokenizer, char32_t ch);
 
     struct {
       char const *p;
       char const *end;
+      /*
+       * start of the character last returned by getchar()
+       */
+      char const *cur;
+      /*
+       * first ill-formed UTF-8 sequence at or after p; everything before it
+       * has been validated
+       */
+      char const *invalid;
+      /*
+       * no more input will come after end
+       */
+      bool final;
     } input;
 
-    TreeBuilder *treebuilder = nullptr;
+    Sink *sink = nullptr;
+    /*
+     * nullptr drops parse errors
+     */
+    ParseErrorSink *errors = nullptr;
 
     struct doctype_token doctype;
     struct tag_token tag;
+    /*
+     * QueequegLib::fnv1a() of the tag name so far, see append_tag_name()
+     */
+    uint32_t tag_name_hash;
     std::u32string temp_buffer;
-    std::string comment;
+    QueequegLib::BorrowedString comment;
     uintmax_t char_ref;
 
     /*
      * used until we write the value
      */
-    std::string attr_name;
+    QueequegLib::BorrowedString attr_name;
     /*
-     * points inside the map
+     * points into tag.attributes, or at discarded_attr_value_ for a duplicate
      */
-    std::string *attr_value;
+    QueequegLib::BorrowedString *attr_value;
 
     enum tokenizer_state state = DATA_STATE;
     enum tokenizer_state ret_state;
@@ -257,11 +437,26 @@ class Tokenizer final {
     enum token_type tag_type;
 
 
+    /*
+     * returned by getchar() when the current chunk ends before the next
+     * character does
+     */
+    static constexpr char32_t k_suspend = static_cast<char32_t>(-2);
+
+
     /*
      * Methods
      */
     [[nodiscard]] char32_t getchar(void);
 
+    [[nodiscard]]
+    inline bool
+    need_input(size_t n) const
+    {
+      return (! this->input.final
+           && static_cast<size_t>(this->input.end - this->input.p) < n);
+    }
+
     [[nodiscard]] bool match(char const *s, size_t slen);
 
     [[nodiscard]]
@@ -278,7 +473,42 @@ class Tokenizer final {
       return this->match_insensitive(c_str, strlen(c_str));
     }
 
-    void error(char const *errstr);
+    inline void
+    error(enum parse_error_code code)
+    {
+      this->error(code, this->offset_of_(this->input.cur));
+    }
+
+    inline void
+    error(enum parse_error_code code, size_t offset)
+    {
+      if (this->errors == nullptr)
+        return;
+
+      if constexpr (requires { this->sink->report_error(code, size_t{}); })
+        this->sink->report_error(code, offset);
+      else
+        this->errors->report(code, offset);
+    }
+
+    void append_current_char(QueequegLib::BorrowedString *str, char32_t c) const;
+
+    /*
+     * c is already lowercased. The hash goes over the UTF-8 that got
+     * appended, so that it is always fnv1a() of the name.
+     */
+    inline void
+    append_tag_name(char32_t c)
+    {
+      size_t old_size = this->tag.tag_name.size();
+
+      this->append_current_char(&this->tag.tag_name, c);
+
+      for (char byte : this->tag.tag_name.view().substr(old_size))
+        this->tag_name_hash = QueequegLib::fnv1a_step(this->tag_name_hash,
+                                                      static_cast<unsigned char>(byte));
+    }
+    void append_lookbehind(QueequegLib::BorrowedString *str, std::string_view s) const;
 
     bool have_appropriate_end_tag(void) const;
 
@@ -299,9 +529,10 @@ class Tokenizer final {
     void start_new_attr(void);
     void begin_attr_value(void);
 
-    void create_comment(std::string data = "");
+    void create_comment(std::string_view data = { });
 
     void emit_character(char32_t ch);
+    void emit_character_run(char const *s, size_t len);
 
     void emit_current_doctype(void);
 
@@ -315,19 +546,101 @@ class Tokenizer final {
 
     void run(void);
 
+    void feed(char const *chunk, size_t chunk_len);
+    void finish(void);
+
+    /*
+     * For a complete input, in place of feed(): goes on up to end, which is
+     * only the end of input if final
+     */
+    void run_until(char const *end, bool final);
+
+    /*
+     * Only right after a start tag was emitted, on "<![CDATA[" (with input.p
+     * still in front of it), or in a text state, and on a complete input
+     */
+    [[nodiscard]] struct tokenizer_checkpoint checkpoint(enum tokenizer_state state) const;
+    void rewind(struct tokenizer_checkpoint const& checkpoint, char const *input_end);
+
+    [[nodiscard]]
+    inline size_t
+    offset(void) const
+    {
+      return this->offset_of_(this->input.cur);
+    }
+
 
   private:
-    std::string last_start_tag_name_;
+    /*
+     * Unconsumed tail of the previous chunk, see feed()
+     */
+    std::string carry_;
+
+    /*
+     * Offset of input_begin_ in the whole input, and how much of it was
+     * fed so far; only used to locate parse errors
+     */
+    char const *input_begin_ = nullptr;
+    size_t input_offset_ = 0;
+    size_t fed_ = 0;
+
+    [[nodiscard]]
+    inline size_t
+    offset_of_(char const *p) const
+    {
+      return this->input_offset_ + static_cast<size_t>(p - this->input_begin_);
+    }
+
+    QueequegLib::BorrowedString last_start_tag_name_;
+    uint32_t last_start_tag_hash_ = 0;
+
+    /*
+     * Values of duplicate attributes still get tokenized; they end up here
+     */
+    QueequegLib::BorrowedString discarded_attr_value_;
 
     [[nodiscard]] bool match_fn_(int (*cmp) (char const *, char const *, size_t),
                                  char const *s,
                                  size_t slen);
 
+    /*
+     * getchar() with the common case inlined
+     */
+    [[nodiscard]]
+    inline char32_t
+    next_char_(void)
+    {
+      if (this->input.p < this->input.end) {
+        unsigned char b = static_cast<unsigned char>(*this->input.p);
+
+        if (b < 0x80 && b != '\r') {
+          this->input.cur = this->input.p++;
+          return b;
+        }
+      }
+
+      return this->getchar();
+    }
+
+#if defined(TOKENIZER_THREADED_DISPATCH)
+    void run_threaded_(void);
+#endif
+
+    void set_input_(char const *p, char const *end, size_t offset);
+    void own_pending_strings_(void);
+    void save_carry_(void);
+
     void create_tag_(enum token_type tag_type);
+    void consume_text_run_(void);
     void emit_token_(union token_data *token_data, enum token_type token_type);
 
+    /*
+     * Longest lookahead any state needs (the longest named character
+     * reference is 33 bytes), with room to spare
+     */
+    static constexpr size_t k_max_lookahead_ = 64;
+
     static const state_handler_cb_t k_state_handlers_[NUM_STATES];
-    static const std::unordered_map< std::string, uint16_t> k_quirky_local_names_;
 };
 
 
@@ -373,25 +686,499 @@ enum treebuilder_status {
 };
 
 
+/*
+ * Entry of the stack of open elements. The element is owned by the DOM tree
+ * it was inserted into (or by the tree builder, see TreeBuilder::events);
+ * its namespace and local name are copied alongside so that walking the
+ * stack doesn't have to touch the nodes themselves.
+ */
+struct open_element {
+  DOM::Element *element = nullptr;
+  enum InfraNamespace name_space = INFRA_NAMESPACE_NULL;
+  uint16_t local_name = 0;
+  /* see html_parser/element_categories.hh */
+  uint16_t categories = k_default_element_categories;
+
+
+  inline bool
+  has_element_index(enum InfraNamespace name_space, uint16_t local_name) const
+  {
+    return (this->name_space == name_space && this->local_name == local_name);
+  }
+
+  inline bool
+  has_html_element_index(uint16_t local_name) const
+  {
+    return this->has_element_index(INFRA_NAMESPACE_HTML, local_name);
+  }
+
+  inline bool
+  has_category(uint16_t categories) const
+  {
+    return (this->categories & categories) != 0;
+  }
+
+
+  static inline struct open_element
+  of(DOM::Element *element)
+  {
+    return {
+      .element    = element,
+      .name_space = element->name_space,
+      .local_name = element->local_name,
+      .categories = element_categories(element->name_space, element->local_name),
+    };
+  }
+};
+
+
+/*
+ * Entries can't be modified in place, so that every change to the stack goes
+ * through the methods below.
+ *
+ * Besides the entries, the stack keeps track of the topmost entry for every
+ * builtin HTML element (each entry linking to the next one of the same name
+ * below it) and of where every scope kind's boundaries are. Most "in scope"
+ * checks then come down to comparing two indices, rather than walking the
+ * stack down to the nearest boundary. Every element on the stack also knows
+ * its own index (DOM::Element::parser_index), so finding one is a lookup.
+ */
+class OpenElementStack final {
+  public:
+    using const_iterator = std::vector< struct open_element>::const_iterator;
+
+    /*
+     * Told about every element that comes off the stack, if set
+     */
+    TreeEventHandler *events = nullptr;
+
+
+  public:
+    [[nodiscard]] inline size_t size(void) const { return this->entries_.size(); }
+    [[nodiscard]] inline bool empty(void) const { return this->entries_.empty(); }
+
+    [[nodiscard]] inline const_iterator begin(void) const { return this->entries_.begin(); }
+    [[nodiscard]] inline const_iterator end(void) const { return this->entries_.end(); }
+
+    [[nodiscard]] inline struct open_element const& front(void) const { return this->entries_.front(); }
+    [[nodiscard]] inline struct open_element const& back(void) const { return this->entries_.back(); }
+
+    [[nodiscard]]
+    inline struct open_element const&
+    operator[](size_t i) const
+    {
+      return this->entries_[i];
+    }
+
+
+    inline void
+    push_back(DOM::Element *element)
+    {
+      this->entries_.push_back(open_element::of(element));
+
+      this->link_(this->entries_.size() - 1);
+    }
+
+    inline void
+    pop_back(void)
+    {
+      DOM::Element const *element = this->entries_.back().element;
+
+      this->unlink_(this->entries_.size() - 1);
+      this->entries_.pop_back();
+
+      if (this->events != nullptr)
+        this->report_closed_(element);
+    }
+
+
+    [[nodiscard]]
+    inline const_iterator
+    find(DOM::Element const *element) const
+    {
+      int index = this->index_of_(element);
+
+      return (index == k_none_) ? this->end() : this->begin() + index;
+    }
+
+    [[nodiscard]]
+    inline bool
+    contains(DOM::Element const *element) const
+    {
+      return (this->find(element) != this->end());
+    }
+
+    void insert(const_iterator pos, DOM::Element *element);
+    void erase(const_iterator pos);
+    void replace(DOM::Element const *element, DOM::Element *replacement);
+
+
+    [[nodiscard]] bool in_scope(enum scope_kind kind, enum html_element_index local_name) const;
+    [[nodiscard]] bool in_scope(enum scope_kind kind,
+                                std::initializer_list< enum html_element_index> local_names) const;
+    [[nodiscard]] bool in_scope(enum scope_kind kind, DOM::Element const *element) const;
+
+
+  private:
+    static constexpr int k_none_ = -1;
+
+    /*
+     * An element that was on the stack of a parser which didn't run to
+     * completion may still have an index set; it only counts if it agrees
+     * with the entry.
+     */
+    [[nodiscard]]
+    inline int
+    index_of_(DOM::Element const *element) const
+    {
+      int index = element->parser_index.open_element;
+
+      if (index < 0 || static_cast<size_t>(index) >= this->entries_.size()
+       || this->entries_[index].element != element)
+        return k_none_;
+
+      return index;
+    }
+
+    [[nodiscard]]
+    inline int
+    topmost_(uint16_t local_name) const
+    {
+      return (local_name < NUM_HTML_BUILTIN_ELEMENTS) ? this->topmost_by_name_[local_name]
+                                                      : k_none_;
+    }
+
+    [[nodiscard]]
+    inline int
+    nearest_boundary_(enum scope_kind kind) const
+    {
+      auto const& boundaries = this->boundaries_[kind];
+
+      return boundaries.empty() ? k_none_ : static_cast<int>(boundaries.back());
+    }
+
+    /*
+     * Both expect entries_[index] to be the topmost entry
+     */
+    inline void
+    link_(size_t index)
+    {
+      struct open_element const& entry = this->entries_[index];
+      int below = k_none_;
+
+      entry.element->parser_index.open_element = static_cast<int32_t>(index);
+
+      if (entry.name_space == INFRA_NAMESPACE_HTML
+       && entry.local_name < NUM_HTML_BUILTIN_ELEMENTS) {
+        below = this->topmost_by_name_[entry.local_name];
+        this->topmost_by_name_[entry.local_name] = static_cast<int>(index);
+      }
+
+      this->same_name_below_.push_back(below);
+
+      for (size_t kind = 0; kind < NUM_SCOPE_KINDS; kind++)
+        if (entry.has_category(scope_boundary_category(static_cast<enum scope_kind>(kind))))
+          this->boundaries_[kind].push_back(static_cast<uint32_t>(index));
+    }
+
+    inline void
+    unlink_(size_t index)
+    {
+      struct open_element const& entry = this->entries_[index];
+
+      entry.element->parser_index.open_element = k_none_;
+
+      if (entry.name_space == INFRA_NAMESPACE_HTML
+       && entry.local_name < NUM_HTML_BUILTIN_ELEMENTS)
+        this->topmost_by_name_[entry.local_name] = this->same_name_below_.back();
+
+      this->same_name_below_.pop_back();
+
+      for (auto& boundaries : this->boundaries_)
+        if (! boundaries.empty() && boundaries.back() == index)
+          boundaries.pop_back();
+    }
+
+    /*
+     * For changes in the middle of the stack, which are rare enough (the
+     * adoption agency algorithm, mostly) that we just start over.
+     */
+    void relink_all_(void);
+
+    void report_closed_(DOM::Element const *element) const;
+
+
+  private:
+    std::vector< struct open_element> entries_;
+
+    std::vector< int> same_name_below_;
+    std::array< int, NUM_HTML_BUILTIN_ELEMENTS> topmost_by_name_ = make_topmost_by_name_();
+    std::array< std::vector< uint32_t>, NUM_SCOPE_KINDS> boundaries_;
+
+
+    static constexpr std::array< int, NUM_HTML_BUILTIN_ELEMENTS>
+    make_topmost_by_name_(void)
+    {
+      std::array< int, NUM_HTML_BUILTIN_ELEMENTS> table;
+      table.fill(k_none_);
+      return table;
+    }
+};
+
+
+struct saved_attribute {
+  std::string_view name;
+  std::string_view value;
+};
+
+
+/*
+ * What the list of active formatting elements remembers of the token an
+ * element was created for. The strings are interned by the SavedTagPool the
+ * snapshot came from, so two snapshots have equal strings exactly when they
+ * point at the same characters. The attributes follow the struct in the
+ * same allocation.
+ */
+struct saved_tag {
+  std::string_view tag_name;
+  uint16_t local_name;
+  uint16_t n_attributes;
+
+
+  [[nodiscard]]
+  inline std::span< struct saved_attribute const>
+  attributes(void) const
+  {
+    return { reinterpret_cast<struct saved_attribute const *>(this + 1), this->n_attributes };
+  }
+
+  /*
+   * The token borrows from the snapshot, and is only good for as long as the
+   * latter
+   */
+  [[nodiscard]] struct tag_token to_token(void) const;
+};
+
+
+/*
+ * Allocates saved_tag snapshots and interns their strings, handing both back
+ * as soon as they are released; interned strings are reference-counted, the
+ * count sitting right before the characters.
+ */
+class SavedTagPool final {
+  public:
+    SavedTagPool(void) = default;
+
+    SavedTagPool(SavedTagPool const& other) = delete;
+    SavedTagPool& operator=(SavedTagPool const& other) = delete;
+
+
+  public:
+    [[nodiscard]] struct saved_tag const *save(struct tag_token const *tag);
+    void release(struct saved_tag const *saved);
+
+
+  private:
+    [[nodiscard]] std::string_view intern_(std::string_view sv);
+    void unintern_(std::string_view sv);
+
+    [[nodiscard]]
+    static inline uint32_t *
+    refcount_(std::string_view interned)
+    {
+      return reinterpret_cast<uint32_t *>(const_cast<char *>(interned.data())) - 1;
+    }
+
+
+  private:
+    std::pmr::unsynchronized_pool_resource memory_;
+    std::pmr::unordered_set< std::string_view> strings_{ &this->memory_ };
+};
+
+
+/*
+ * Entry of the list of active formatting elements; markers are entries
+ * without an element.
+ */
+struct formatting_entry {
+  DOM::Element *element = nullptr;
+  struct saved_tag const *tag = nullptr;
+
+
+  inline bool
+  is_marker(void) const
+  {
+    return (this->element == nullptr);
+  }
+};
+
+
+/*
+ * The list of active formatting elements, kept in one array. Every element
+ * in the list knows its own index (DOM::Element::parser_index), which the
+ * methods below keep up to date as entries come and go.
+ *
+ * The list also owns the snapshots of the tokens its elements were created
+ * for: an entry keeps its snapshot when its element is replaced, and gives
+ * it back to the pool once the entry is removed.
+ */
+class ActiveFormattingList final {
+  public:
+    using const_iterator = std::vector< struct formatting_entry>::const_iterator;
+
+    static constexpr int k_none = -1;
+
+
+  public:
+    [[nodiscard]] inline size_t size(void) const { return this->entries_.size(); }
+    [[nodiscard]] inline bool empty(void) const { return this->entries_.empty(); }
+
+    [[nodiscard]] inline const_iterator begin(void) const { return this->entries_.begin(); }
+    [[nodiscard]] inline const_iterator end(void) const { return this->entries_.end(); }
+
+    [[nodiscard]] inline struct formatting_entry const& back(void) const { return this->entries_.back(); }
+
+    [[nodiscard]]
+    inline struct formatting_entry const&
+    operator[](size_t i) const
+    {
+      return this->entries_[i];
+    }
+
+
+    inline void
+    push_back(DOM::Element *element, struct tag_token const *tag)
+    {
+      this->entries_.push_back({ .element = element, .tag = this->tags_.save(tag) });
+      this->reindex_from_(this->entries_.size() - 1);
+    }
+
+    inline void
+    push_marker(void)
+    {
+      this->entries_.push_back({ });
+    }
+
+    inline void
+    pop_back(void)
+    {
+      this->release_(this->entries_.back());
+      this->entries_.pop_back();
+    }
+
+
+    /*
+     * As with the stack of open elements, a stale index from a parser that
+     * didn't run to completion doesn't count unless it agrees with the entry.
+     */
+    [[nodiscard]]
+    inline int
+    index_of(DOM::Element const *element) const
+    {
+      int index = element->parser_index.formatting;
+
+      if (index < 0 || static_cast<size_t>(index) >= this->entries_.size()
+       || this->entries_[index].element != element)
+        return k_none;
+
+      return index;
+    }
+
+    [[nodiscard]]
+    inline bool
+    contains(DOM::Element const *element) const
+    {
+      return (this->index_of(element) != k_none);
+    }
+
+
+    inline void
+    erase(size_t index)
+    {
+      this->release_(this->entries_[index]);
+      this->entries_.erase(this->entries_.begin() + index);
+      this->reindex_from_(index);
+    }
+
+    /*
+     * The entry's snapshot stays, since the replacement is always an element
+     * created for the same token.
+     */
+    inline void
+    replace(size_t index, DOM::Element *replacement)
+    {
+      this->entries_[index].element->parser_index.formatting = k_none;
+      this->entries_[index].element = replacement;
+      this->reindex_from_(index, index + 1);
+    }
+
+    /*
+     * Moves the entry at index to right after the entry of bookmark, as a
+     * replacement element for it (step 4.18. of the adoption agency
+     * algorithm).
+     */
+    void move_after(size_t index, DOM::Element const *bookmark, DOM::Element *replacement);
+
+
+  private:
+    inline void
+    release_(struct formatting_entry const& entry)
+    {
+      if (entry.is_marker())
+        return;
+
+      entry.element->parser_index.formatting = k_none;
+      this->tags_.release(entry.tag);
+    }
+
+    inline void
+    reindex_from_(size_t first, size_t last = SIZE_MAX)
+    {
+      last = std::min(last, this->entries_.size());
+
+      for (size_t i = first; i < last; i++)
+        if (! this->entries_[i].is_marker())
+          this->entries_[i].element->parser_index.formatting = static_cast<int32_t>(i);
+    }
+
+
+  private:
+    /* declared first, so that it outlives the entries */
+    SavedTagPool tags_;
+    std::vector< struct formatting_entry> entries_;
+};
+
+
 template< typename T>
-concept ScopeTargetable = std::same_as< T, std::shared_ptr< DOM::Element>>
+concept ScopeTargetable = std::same_as< T, DOM::Element *>
                        || std::same_as< T, std::initializer_list< enum html_element_index>>
                        || std::same_as< T, enum html_element_index>;
 
 
 class TreeBuilder final {
   public:
-      TreeBuilder(std::shared_ptr< DOM::Document> document);
+      /*
+       * With events, nothing goes into the document, which only makes the
+       * elements (see html_parser/tree_events.hh)
+       */
+      TreeBuilder(std::shared_ptr< DOM::Document> document,
+                  TreeEventHandler *events = nullptr);
     ~TreeBuilder();
 
   public:
     /*
-     * Handlers
+     * Handlers, one per insertion mode and token type
      */
     typedef enum treebuilder_status (*insertion_mode_handler_cb_t)
-     (TreeBuilder *treebuilder, union token_data *token_data, enum token_type);
+     (TreeBuilder *treebuilder, union token_data *token_data);
 
     Tokenizer *tokenizer = nullptr;
+    /*
+     * Set while tokens queued by a tokenizer of its own are being replayed
+     * (see html_parser/pipeline.hh); the tokenizer must not be touched then
+     */
+    TokenReplay *replay = nullptr;
+    TreeEventHandler *events = nullptr;
 
     std::shared_ptr< DOM::Document> document = nullptr;
     std::shared_ptr< DOM::Element>  context = nullptr;
@@ -399,21 +1186,14 @@ class TreeBuilder final {
     std::shared_ptr< DOM::HTMLHeadElement> head = nullptr;
     std::shared_ptr< DOM::Element>         form = nullptr;
 
-    std::vector< std::shared_ptr< DOM::Element>> open_elements = { };
-    std::list< std::shared_ptr< DOM::Element>> formatting_elements = { };
-
     /*
-     * for the "adoption agency algorithm"
+     * Neither list owns its elements; the document does, or live_elements_
+     * with events
      */
-    std::unordered_map< std::shared_ptr< DOM::Element>, struct tag_token> saved_tags = { };
+    OpenElementStack open_elements = { };
+    ActiveFormattingList formatting_elements = { };
 
-    /*
-     * dummy element to get an unique smart pointer
-     */
-    std::shared_ptr< DOM::Element> FORMATTING_MARKER =
-     std::make_shared<DOM::Element>(nullptr, INFRA_NAMESPACE_NULL, 0);
-
-    std::vector< char32_t> pending_table_characters = { };
+    std::string pending_table_characters = { };
 
     std::vector< enum insertion_mode> template_modes = { };
 
@@ -438,7 +1218,24 @@ class TreeBuilder final {
      */
     void process_token(union token_data *token_data, enum token_type token_type);
 
+    /*
+     * Where the current token is, or with a character run, its first
+     * character that is still to be processed; the other takes the offset of
+     * a given character, see run_offset_of()
+     */
     void error(void);
+    void error(size_t offset);
+    void switch_tokenizer_state(enum tokenizer_state state);
+
+    /*
+     * p points into the character run being processed
+     */
+    [[nodiscard]]
+    inline size_t
+    run_offset_of(char const *p) const
+    {
+      return this->run_offset_ + static_cast<size_t>(p - this->run_begin_);
+    }
 
 
     inline enum insertion_mode
@@ -452,179 +1249,230 @@ class TreeBuilder final {
     void reset_insertion_mode_appropriately(void);
 
 
-    inline std::shared_ptr< DOM::Element>
+    inline DOM::Element *
     current_node(void) const
     {
-      return this->open_elements.back();
+      return this->open_elements.back().element;
     }
 
 
-    inline std::shared_ptr< DOM::Element>
+    inline DOM::Element *
     adjusted_current_node(void) const
     {
       if (this->context != nullptr)
-        return this->context;
+        return this->context.get();
 
       return this->current_node();
     }
 
+    /*
+     * Whether "<![CDATA[" starts a CDATA section rather than a bogus comment
+     */
+    [[nodiscard]]
+    inline bool
+    allows_cdata_section(void) const
+    {
+      if (this->context == nullptr && this->open_elements.empty())
+        return false;
+
+      return (this->adjusted_current_node()->name_space != INFRA_NAMESPACE_HTML);
+    }
+
 
-    std::shared_ptr< DOM::Element> find_foreign_element_in_stack(enum InfraNamespace name_space,
-                                                                uint16_t local_name);
+    DOM::Element *find_foreign_element_in_stack(enum InfraNamespace name_space,
+                                               uint16_t local_name);
 
-    inline std::shared_ptr< DOM::Element>
+    inline DOM::Element *
     find_html_element_in_stack(uint16_t local_name)
     {
       return this->find_foreign_element_in_stack(INFRA_NAMESPACE_HTML, local_name);
     }
 
-    bool is_special_element(std::shared_ptr< DOM::Element> element) const;
-    bool is_formatting_element(std::shared_ptr< DOM::Element> element) const;
-
-
-  /*
-   * For the "in scope" algorithms, we use a barebones template function
-   * ("have_target_node_in_scope_") which just calls the overloaded ones
-   * right above it in the list below.
-   *
-   * The element scope definitions themselves are also implemented as templates
-   * so we don't need to write the same thing 50 times.
-   * XXX: Caveat; will have to explicitly instantiate everything in treebuilder.cc
-   */
-  /*
-   * XXX: remove useless overloads (html_element_index antecedents)
-   */
-  private:
-    bool scope_node_equals_(std::shared_ptr< DOM::Element> node,
-                            std::shared_ptr< DOM::Element> target) const;
-    bool scope_node_equals_(std::shared_ptr< DOM::Element> node,
-                            std::initializer_list< enum html_element_index> html_local_names) const;
-    bool scope_node_equals_(std::shared_ptr< DOM::Element> node,
-                            enum html_element_index html_local_name) const
+    static inline bool
+    is_special_element(enum InfraNamespace name_space, uint16_t local_name)
     {
-      return this->scope_node_equals_(node, {html_local_name} );
+      return element_has_category(name_space, local_name, ELEMENT_SPECIAL);
     }
 
-    bool scope_batch_contains_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                               std::shared_ptr< DOM::Element> elem) const;
-    bool scope_batch_contains_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                               std::initializer_list< enum html_element_index> html_local_names) const;
-
-    bool scope_batch_contains_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                               enum html_element_index html_local_name) const
+    static inline bool
+    is_formatting_element(enum InfraNamespace name_space, uint16_t local_name)
     {
-      return this->scope_batch_contains_(list, {html_local_name});
+      return element_has_category(name_space, local_name, ELEMENT_FORMATTING);
     }
 
-    template< ScopeTargetable T>
-    bool have_target_node_in_scope_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                                    T targets) const;
+    static inline bool
+    is_special_element(DOM::Element const *element)
+    {
+      return TreeBuilder::is_special_element(element->name_space, element->local_name);
+    }
 
-    static const std::vector< std::pair< uint16_t, uint16_t>> k_particular_scope_def_;
-    static const std::vector< std::pair< uint16_t, uint16_t>> k_list_scope_def_;
-    static const std::vector< std::pair< uint16_t, uint16_t>> k_button_scope_def_;
-    static const std::vector< std::pair< uint16_t, uint16_t>> k_table_scope_def_;
-    static const std::vector< std::pair< uint16_t, uint16_t>> k_select_scope_def_;
+    static inline bool
+    is_special_element(struct open_element const& entry)
+    {
+      return entry.has_category(ELEMENT_SPECIAL);
+    }
 
+    static inline bool
+    is_formatting_element(DOM::Element const *element)
+    {
+      return TreeBuilder::is_formatting_element(element->name_space, element->local_name);
+    }
 
 
+  /*
+   * The "in scope" algorithms; see OpenElementStack for how they're answered
+   */
   public:
     template< ScopeTargetable T>
-    bool
+    inline bool
     have_element_in_scope(T targets) const
     {
-      return this->have_target_node_in_scope_(&TreeBuilder::k_particular_scope_def_,
-                                              targets);
+      return this->open_elements.in_scope(SCOPE_PARTICULAR, targets);
     }
 
     template< ScopeTargetable T>
-    bool
+    inline bool
     have_element_in_list_item_scope(T targets) const
     {
-      return this->have_target_node_in_scope_(&TreeBuilder::k_list_scope_def_,
-                                              targets);
+      return this->open_elements.in_scope(SCOPE_LIST_ITEM, targets);
     }
 
     template< ScopeTargetable T>
-    bool
+    inline bool
     have_element_in_button_scope(T targets) const
     {
-      return this->have_target_node_in_scope_(&TreeBuilder::k_button_scope_def_,
-                                              targets);
+      return this->open_elements.in_scope(SCOPE_BUTTON, targets);
     }
 
     template< ScopeTargetable T>
-    bool
+    inline bool
     have_element_in_table_scope(T targets) const
     {
-      return this->have_target_node_in_scope_(&TreeBuilder::k_table_scope_def_,
-                                              targets);
+      return this->open_elements.in_scope(SCOPE_TABLE, targets);
     }
 
     template< ScopeTargetable T>
-    bool
+    inline bool
     have_element_in_select_scope(T targets) const
     {
-      return this->have_target_node_in_scope_(&TreeBuilder::k_table_scope_def_,
-                                              targets);
+      return this->open_elements.in_scope(SCOPE_SELECT, targets);
     }
 
 
   public:
     void push_formatting_marker(void);
-    bool same_parsed_elements(std::shared_ptr< DOM::Element> lhs,
-                              std::shared_ptr< DOM::Element> rhs) const;
-    void push_to_active_formatting_elements(std::shared_ptr< DOM::Element> element);
+    bool same_parsed_elements(struct formatting_entry const& lhs,
+                              struct formatting_entry const& rhs) const;
+    void push_to_active_formatting_elements(DOM::Element *element, struct tag_token const *tag);
     void reconstruct_active_formatting_elements(void);
     void clear_active_formatting_elements_to_marker(void);
 
     void acknowledge_self_closing_flag(struct tag_token *tag) const;
 
 
-    InsertionLocation appropriate_insertion_place(std::shared_ptr< DOM::Element> override_target = nullptr);
+    InsertionLocation appropriate_insertion_place(DOM::Element *override_target = nullptr);
 
     [[nodiscard]] std::shared_ptr< DOM::Element>
     create_element_for_token(struct tag_token const *tag,
                              enum InfraNamespace name_space,
                              std::shared_ptr< DOM::Node> intended_parent);
 
-    static std::shared_ptr< DOM::Node> node_before(InsertionLocation location);
+    static DOM::Node *node_before(InsertionLocation const& location);
 
     void insert_element_at_location(InsertionLocation location,
-                                    std::shared_ptr< DOM::Element> element) const;
+                                    std::shared_ptr< DOM::Element> element,
+                                    struct tag_token const *tag);
+
+    /*
+     * For the DOM operations on an element we only hold a plain pointer to
+     */
+    static std::shared_ptr< DOM::Element> share_element(DOM::Element *element);
 
-    void insert_element_at_adjusted_insertion_location(std::shared_ptr< DOM::Element>);
+    void insert_element_at_adjusted_insertion_location(std::shared_ptr< DOM::Element> element,
+                                                       struct tag_token const *tag);
 
     std::shared_ptr< DOM::Element> insert_foreign_element(struct tag_token const *tag,
      enum InfraNamespace name_space, bool only_add_to_element_stack);
 
     std::shared_ptr< DOM::Element> insert_html_element(struct tag_token const *tag);
 
-    void insert_characters(std::vector< char32_t> const *vch);
+    void insert_characters(std::string_view data);
     void insert_character(char32_t ch);
 
-    void insert_comment(std::string *data, InsertionLocation where);
+    void flush_pending_text(void);
+
+    void insert_comment(QueequegLib::BorrowedString const *data, InsertionLocation where);
 
     inline void
-    insert_comment(std::string *data)
+    insert_comment(QueequegLib::BorrowedString const *data)
     {
       this->insert_comment(data, this->appropriate_insertion_place());
     }
 
+    void insert_doctype(struct doctype_token const *token);
+
+    /*
+     * The adoption agency algorithm makes elements before it knows where they
+     * go, and moves elements that are in the tree already
+     */
+    [[nodiscard]] std::shared_ptr< DOM::Element>
+    create_element_for_adoption(struct tag_token const *tag, DOM::Element *intended_parent);
+
+    void move_element(std::shared_ptr< DOM::Element> element, InsertionLocation location);
+    void move_children(DOM::Element *from, DOM::Element *to);
+
     [[nodiscard]] enum treebuilder_status generic_raw_text_parse(struct tag_token *tag);
 
     [[nodiscard]] enum treebuilder_status generic_rcdata_parse(struct tag_token *tag);
 
     void generate_implied_end_tags(uint16_t exclude_html = 0);
+    void generate_all_implied_end_tags_thoroughly(void);
 
 
   private:
-    void insert_character_array_(char32_t const *arr, size_t arr_len);
-
     [[nodiscard]] enum treebuilder_status tree_construction_dispatcher_(union token_data *token_data,
                                                                         enum token_type token_type);
 
-    static const insertion_mode_handler_cb_t k_insertion_mode_handlers_[NUM_MODES];
+    static const insertion_mode_handler_cb_t k_insertion_mode_handlers_[NUM_MODES][NUM_TOKEN_TYPES];
+
+    [[nodiscard]] size_t token_offset_(void) const;
+
+    /*
+     * The character run being processed, which the insertion modes split up
+     * in place, and where it started out in the input
+     */
+    std::string_view const *run_ = nullptr;
+    char const *run_begin_ = nullptr;
+    size_t run_offset_ = 0;
+
+    /*
+     * With events, every element the tree builder made that may still be on
+     * the stack of open elements or in the list of active formatting elements.
+     * The others are released once there are twice as many entries as after
+     * the last time, and at least k_min_live_elements_.
+     */
+    void keep_element_(std::shared_ptr< DOM::Element> element);
+    void release_dead_elements_(void);
+
+    static constexpr size_t k_min_live_elements_ = 64;
+
+    std::vector< std::shared_ptr< DOM::Element>> live_elements_;
+    size_t release_at_ = k_min_live_elements_;
+
+    /*
+     * Characters inserted in a row end up in the same Text node. As long as
+     * the insertion location stays the same (same target, text node still
+     * its parent's last child), they are only buffered here and go into the
+     * node in one go on flush_pending_text(): before any other token, and at
+     * the end of every input chunk. With events, there is no node to put them
+     * into, and they are reported right away.
+     */
+    struct {
+      DOM::Node *target = nullptr;
+      DOM::Node *parent = nullptr;
+      DOM::Text *text   = nullptr;
+      std::string data  = { };
+    } pending_text_;
 };
 
 
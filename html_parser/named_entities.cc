@@ -1,2249 +0,0 @@
-/*
- * This file was automatically generated by a script I can't find anymore
- * It gets included by "html_parser/tokenizer_states.cc"
- */
-
-#define S(c_str) \
-  (c_str), sizeof (c_str) - 1
-
-static const struct {
-  char const * name;
-  size_t       name_len;
-  char const * utf8;
-  size_t       utf8_len;
-} k_named_char_refs_[] = {
-  { S("&zwnj;"), S("\xE2\x80\x8C") },
-  { S("&zwj;"), S("\xE2\x80\x8D") },
-  { S("&zscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&zopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&zigrarr;"), S("\xE2\x87\x9D") },
-  { S("&zhcy;"), S("\xD0\xB6") },
-  { S("&zfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&zeta;"), S("\xCE\xB6") },
-  { S("&zeetrf;"), S("\xE2\x84\xA8") },
-  { S("&zdot;"), S("\xC5\xBC") },
-  { S("&zcy;"), S("\xD0\xB7") },
-  { S("&zcaron;"), S("\xC5\xBE") },
-  { S("&zacute;"), S("\xC5\xBA") },
-  { S("&yuml;"), S("\xC3\xBF") },
-  { S("&yuml"), S("\xC3\xBF") },
-  { S("&yucy;"), S("\xD1\x8E") },
-  { S("&yscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&yopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&yicy;"), S("\xD1\x97") },
-  { S("&yfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&yen;"), S("\xC2\xA5") },
-  { S("&yen"), S("\xC2\xA5") },
-  { S("&ycy;"), S("\xD1\x8B") },
-  { S("&ycirc;"), S("\xC5\xB7") },
-  { S("&yacy;"), S("\xD1\x8F") },
-  { S("&yacute;"), S("\xC3\xBD") },
-  { S("&yacute"), S("\xC3\xBD") },
-  { S("&xwedge;"), S("\xE2\x8B\x80") },
-  { S("&xvee;"), S("\xE2\x8B\x81") },
-  { S("&xutri;"), S("\xE2\x96\xB3") },
-  { S("&xuplus;"), S("\xE2\xA8\x84") },
-  { S("&xsqcup;"), S("\xE2\xA8\x86") },
-  { S("&xscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&xrarr;"), S("\xE2\x9F\xB6") },
-  { S("&xrArr;"), S("\xE2\x9F\xB9") },
-  { S("&xotime;"), S("\xE2\xA8\x82") },
-  { S("&xoplus;"), S("\xE2\xA8\x81") },
-  { S("&xopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&xodot;"), S("\xE2\xA8\x80") },
-  { S("&xnis;"), S("\xE2\x8B\xBB") },
-  { S("&xmap;"), S("\xE2\x9F\xBC") },
-  { S("&xlarr;"), S("\xE2\x9F\xB5") },
-  { S("&xlArr;"), S("\xE2\x9F\xB8") },
-  { S("&xi;"), S("\xCE\xBE") },
-  { S("&xharr;"), S("\xE2\x9F\xB7") },
-  { S("&xhArr;"), S("\xE2\x9F\xBA") },
-  { S("&xfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&xdtri;"), S("\xE2\x96\xBD") },
-  { S("&xcup;"), S("\xE2\x8B\x83") },
-  { S("&xcirc;"), S("\xE2\x97\xAF") },
-  { S("&xcap;"), S("\xE2\x8B\x82") },
-  { S("&wscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&wreath;"), S("\xE2\x89\x80") },
-  { S("&wr;"), S("\xE2\x89\x80") },
-  { S("&wp;"), S("\xE2\x84\x98") },
-  { S("&wopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&wfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&weierp;"), S("\xE2\x84\x98") },
-  { S("&wedgeq;"), S("\xE2\x89\x99") },
-  { S("&wedge;"), S("\xE2\x88\xA7") },
-  { S("&wedbar;"), S("\xE2\xA9\x9F") },
-  { S("&wcirc;"), S("\xC5\xB5") },
-  { S("&vzigzag;"), S("\xE2\xA6\x9A") },
-  { S("&vsupne;"), S("\xE2\x8A\x8B\xEF\xB8\x80") },
-  { S("&vsupnE;"), S("\xE2\xAB\x8C\xEF\xB8\x80") },
-  { S("&vsubne;"), S("\xE2\x8A\x8A\xEF\xB8\x80") },
-  { S("&vsubnE;"), S("\xE2\xAB\x8B\xEF\xB8\x80") },
-  { S("&vscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&vrtri;"), S("\xE2\x8A\xB3") },
-  { S("&vprop;"), S("\xE2\x88\x9D") },
-  { S("&vopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&vnsup;"), S("\xE2\x8A\x83\xE2\x83\x92") },
-  { S("&vnsub;"), S("\xE2\x8A\x82\xE2\x83\x92") },
-  { S("&vltri;"), S("\xE2\x8A\xB2") },
-  { S("&vfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&vert;"), S("\x7C") },
-  { S("&verbar;"), S("\x7C") },
-  { S("&vellip;"), S("\xE2\x8B\xAE") },
-  { S("&veeeq;"), S("\xE2\x89\x9A") },
-  { S("&veebar;"), S("\xE2\x8A\xBB") },
-  { S("&vee;"), S("\xE2\x88\xA8") },
-  { S("&vdash;"), S("\xE2\x8A\xA2") },
-  { S("&vcy;"), S("\xD0\xB2") },
-  { S("&vartriangleright;"), S("\xE2\x8A\xB3") },
-  { S("&vartriangleleft;"), S("\xE2\x8A\xB2") },
-  { S("&vartheta;"), S("\xCF\x91") },
-  { S("&varsupsetneqq;"), S("\xE2\xAB\x8C\xEF\xB8\x80") },
-  { S("&varsupsetneq;"), S("\xE2\x8A\x8B\xEF\xB8\x80") },
-  { S("&varsubsetneqq;"), S("\xE2\xAB\x8B\xEF\xB8\x80") },
-  { S("&varsubsetneq;"), S("\xE2\x8A\x8A\xEF\xB8\x80") },
-  { S("&varsigma;"), S("\xCF\x82") },
-  { S("&varrho;"), S("\xCF\xB1") },
-  { S("&varr;"), S("\xE2\x86\x95") },
-  { S("&varpropto;"), S("\xE2\x88\x9D") },
-  { S("&varpi;"), S("\xCF\x96") },
-  { S("&varphi;"), S("\xCF\x95") },
-  { S("&varnothing;"), S("\xE2\x88\x85") },
-  { S("&varkappa;"), S("\xCF\xB0") },
-  { S("&varepsilon;"), S("\xCF\xB5") },
-  { S("&vangrt;"), S("\xE2\xA6\x9C") },
-  { S("&vDash;"), S("\xE2\x8A\xA8") },
-  { S("&vBarv;"), S("\xE2\xAB\xA9") },
-  { S("&vBar;"), S("\xE2\xAB\xA8") },
-  { S("&vArr;"), S("\xE2\x87\x95") },
-  { S("&uwangle;"), S("\xE2\xA6\xA7") },
-  { S("&uuml;"), S("\xC3\xBC") },
-  { S("&uuml"), S("\xC3\xBC") },
-  { S("&uuarr;"), S("\xE2\x87\x88") },
-  { S("&utrif;"), S("\xE2\x96\xB4") },
-  { S("&utri;"), S("\xE2\x96\xB5") },
-  { S("&utilde;"), S("\xC5\xA9") },
-  { S("&utdot;"), S("\xE2\x8B\xB0") },
-  { S("&uscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&urtri;"), S("\xE2\x97\xB9") },
-  { S("&uring;"), S("\xC5\xAF") },
-  { S("&urcrop;"), S("\xE2\x8C\x8E") },
-  { S("&urcorner;"), S("\xE2\x8C\x9D") },
-  { S("&urcorn;"), S("\xE2\x8C\x9D") },
-  { S("&upuparrows;"), S("\xE2\x87\x88") },
-  { S("&upsilon;"), S("\xCF\x85") },
-  { S("&upsih;"), S("\xCF\x92") },
-  { S("&upsi;"), S("\xCF\x85") },
-  { S("&uplus;"), S("\xE2\x8A\x8E") },
-  { S("&upharpoonright;"), S("\xE2\x86\xBE") },
-  { S("&upharpoonleft;"), S("\xE2\x86\xBF") },
-  { S("&updownarrow;"), S("\xE2\x86\x95") },
-  { S("&uparrow;"), S("\xE2\x86\x91") },
-  { S("&uopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&uogon;"), S("\xC5\xB3") },
-  { S("&uml;"), S("\xC2\xA8") },
-  { S("&uml"), S("\xC2\xA8") },
-  { S("&umacr;"), S("\xC5\xAB") },
-  { S("&ultri;"), S("\xE2\x97\xB8") },
-  { S("&ulcrop;"), S("\xE2\x8C\x8F") },
-  { S("&ulcorner;"), S("\xE2\x8C\x9C") },
-  { S("&ulcorn;"), S("\xE2\x8C\x9C") },
-  { S("&uhblk;"), S("\xE2\x96\x80") },
-  { S("&uharr;"), S("\xE2\x86\xBE") },
-  { S("&uharl;"), S("\xE2\x86\xBF") },
-  { S("&ugrave;"), S("\xC3\xB9") },
-  { S("&ugrave"), S("\xC3\xB9") },
-  { S("&ufr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&ufisht;"), S("\xE2\xA5\xBE") },
-  { S("&udhar;"), S("\xE2\xA5\xAE") },
-  { S("&udblac;"), S("\xC5\xB1") },
-  { S("&udarr;"), S("\xE2\x87\x85") },
-  { S("&ucy;"), S("\xD1\x83") },
-  { S("&ucirc;"), S("\xC3\xBB") },
-  { S("&ucirc"), S("\xC3\xBB") },
-  { S("&ubreve;"), S("\xC5\xAD") },
-  { S("&ubrcy;"), S("\xD1\x9E") },
-  { S("&uarr;"), S("\xE2\x86\x91") },
-  { S("&uacute;"), S("\xC3\xBA") },
-  { S("&uacute"), S("\xC3\xBA") },
-  { S("&uHar;"), S("\xE2\xA5\xA3") },
-  { S("&uArr;"), S("\xE2\x87\x91") },
-  { S("&twoheadrightarrow;"), S("\xE2\x86\xA0") },
-  { S("&twoheadleftarrow;"), S("\xE2\x86\x9E") },
-  { S("&twixt;"), S("\xE2\x89\xAC") },
-  { S("&tstrok;"), S("\xC5\xA7") },
-  { S("&tshcy;"), S("\xD1\x9B") },
-  { S("&tscy;"), S("\xD1\x86") },
-  { S("&tscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&trpezium;"), S("\xE2\x8F\xA2") },
-  { S("&tritime;"), S("\xE2\xA8\xBB") },
-  { S("&trisb;"), S("\xE2\xA7\x8D") },
-  { S("&triplus;"), S("\xE2\xA8\xB9") },
-  { S("&triminus;"), S("\xE2\xA8\xBA") },
-  { S("&trie;"), S("\xE2\x89\x9C") },
-  { S("&tridot;"), S("\xE2\x97\xAC") },
-  { S("&trianglerighteq;"), S("\xE2\x8A\xB5") },
-  { S("&triangleright;"), S("\xE2\x96\xB9") },
-  { S("&triangleq;"), S("\xE2\x89\x9C") },
-  { S("&trianglelefteq;"), S("\xE2\x8A\xB4") },
-  { S("&triangleleft;"), S("\xE2\x97\x83") },
-  { S("&triangledown;"), S("\xE2\x96\xBF") },
-  { S("&triangle;"), S("\xE2\x96\xB5") },
-  { S("&trade;"), S("\xE2\x84\xA2") },
-  { S("&tprime;"), S("\xE2\x80\xB4") },
-  { S("&tosa;"), S("\xE2\xA4\xA9") },
-  { S("&topfork;"), S("\xE2\xAB\x9A") },
-  { S("&topf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&topcir;"), S("\xE2\xAB\xB1") },
-  { S("&topbot;"), S("\xE2\x8C\xB6") },
-  { S("&top;"), S("\xE2\x8A\xA4") },
-  { S("&toea;"), S("\xE2\xA4\xA8") },
-  { S("&tint;"), S("\xE2\x88\xAD") },
-  { S("&timesd;"), S("\xE2\xA8\xB0") },
-  { S("&timesbar;"), S("\xE2\xA8\xB1") },
-  { S("&timesb;"), S("\xE2\x8A\xA0") },
-  { S("&times;"), S("\xC3\x97") },
-  { S("&times"), S("\xC3\x97") },
-  { S("&tilde;"), S("\xCB\x9C") },
-  { S("&thorn;"), S("\xC3\xBE") },
-  { S("&thorn"), S("\xC3\xBE") },
-  { S("&thksim;"), S("\xE2\x88\xBC") },
-  { S("&thkap;"), S("\xE2\x89\x88") },
-  { S("&thinsp;"), S("\xE2\x80\x89") },
-  { S("&thicksim;"), S("\xE2\x88\xBC") },
-  { S("&thickapprox;"), S("\xE2\x89\x88") },
-  { S("&thetav;"), S("\xCF\x91") },
-  { S("&thetasym;"), S("\xCF\x91") },
-  { S("&theta;"), S("\xCE\xB8") },
-  { S("&therefore;"), S("\xE2\x88\xB4") },
-  { S("&there4;"), S("\xE2\x88\xB4") },
-  { S("&tfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&telrec;"), S("\xE2\x8C\x95") },
-  { S("&tdot;"), S("\xE2\x83\x9B") },
-  { S("&tcy;"), S("\xD1\x82") },
-  { S("&tcedil;"), S("\xC5\xA3") },
-  { S("&tcaron;"), S("\xC5\xA5") },
-  { S("&tbrk;"), S("\xE2\x8E\xB4") },
-  { S("&tau;"), S("\xCF\x84") },
-  { S("&target;"), S("\xE2\x8C\x96") },
-  { S("&szlig;"), S("\xC3\x9F") },
-  { S("&szlig"), S("\xC3\x9F") },
-  { S("&swnwar;"), S("\xE2\xA4\xAA") },
-  { S("&swarrow;"), S("\xE2\x86\x99") },
-  { S("&swarr;"), S("\xE2\x86\x99") },
-  { S("&swarhk;"), S("\xE2\xA4\xA6") },
-  { S("&swArr;"), S("\xE2\x87\x99") },
-  { S("&supsup;"), S("\xE2\xAB\x96") },
-  { S("&supsub;"), S("\xE2\xAB\x94") },
-  { S("&supsim;"), S("\xE2\xAB\x88") },
-  { S("&supsetneqq;"), S("\xE2\xAB\x8C") },
-  { S("&supsetneq;"), S("\xE2\x8A\x8B") },
-  { S("&supseteqq;"), S("\xE2\xAB\x86") },
-  { S("&supseteq;"), S("\xE2\x8A\x87") },
-  { S("&supset;"), S("\xE2\x8A\x83") },
-  { S("&supplus;"), S("\xE2\xAB\x80") },
-  { S("&supne;"), S("\xE2\x8A\x8B") },
-  { S("&supnE;"), S("\xE2\xAB\x8C") },
-  { S("&supmult;"), S("\xE2\xAB\x82") },
-  { S("&suplarr;"), S("\xE2\xA5\xBB") },
-  { S("&suphsub;"), S("\xE2\xAB\x97") },
-  { S("&suphsol;"), S("\xE2\x9F\x89") },
-  { S("&supedot;"), S("\xE2\xAB\x84") },
-  { S("&supe;"), S("\xE2\x8A\x87") },
-  { S("&supdsub;"), S("\xE2\xAB\x98") },
-  { S("&supdot;"), S("\xE2\xAA\xBE") },
-  { S("&supE;"), S("\xE2\xAB\x86") },
-  { S("&sup;"), S("\xE2\x8A\x83") },
-  { S("&sup3;"), S("\xC2\xB3") },
-  { S("&sup3"), S("\xC2\xB3") },
-  { S("&sup2;"), S("\xC2\xB2") },
-  { S("&sup2"), S("\xC2\xB2") },
-  { S("&sup1;"), S("\xC2\xB9") },
-  { S("&sup1"), S("\xC2\xB9") },
-  { S("&sung;"), S("\xE2\x99\xAA") },
-  { S("&sum;"), S("\xE2\x88\x91") },
-  { S("&succsim;"), S("\xE2\x89\xBF") },
-  { S("&succnsim;"), S("\xE2\x8B\xA9") },
-  { S("&succneqq;"), S("\xE2\xAA\xB6") },
-  { S("&succnapprox;"), S("\xE2\xAA\xBA") },
-  { S("&succeq;"), S("\xE2\xAA\xB0") },
-  { S("&succcurlyeq;"), S("\xE2\x89\xBD") },
-  { S("&succapprox;"), S("\xE2\xAA\xB8") },
-  { S("&succ;"), S("\xE2\x89\xBB") },
-  { S("&subsup;"), S("\xE2\xAB\x93") },
-  { S("&subsub;"), S("\xE2\xAB\x95") },
-  { S("&subsim;"), S("\xE2\xAB\x87") },
-  { S("&subsetneqq;"), S("\xE2\xAB\x8B") },
-  { S("&subsetneq;"), S("\xE2\x8A\x8A") },
-  { S("&subseteqq;"), S("\xE2\xAB\x85") },
-  { S("&subseteq;"), S("\xE2\x8A\x86") },
-  { S("&subset;"), S("\xE2\x8A\x82") },
-  { S("&subrarr;"), S("\xE2\xA5\xB9") },
-  { S("&subplus;"), S("\xE2\xAA\xBF") },
-  { S("&subne;"), S("\xE2\x8A\x8A") },
-  { S("&subnE;"), S("\xE2\xAB\x8B") },
-  { S("&submult;"), S("\xE2\xAB\x81") },
-  { S("&subedot;"), S("\xE2\xAB\x83") },
-  { S("&sube;"), S("\xE2\x8A\x86") },
-  { S("&subdot;"), S("\xE2\xAA\xBD") },
-  { S("&subE;"), S("\xE2\xAB\x85") },
-  { S("&sub;"), S("\xE2\x8A\x82") },
-  { S("&strns;"), S("\xC2\xAF") },
-  { S("&straightphi;"), S("\xCF\x95") },
-  { S("&straightepsilon;"), S("\xCF\xB5") },
-  { S("&starf;"), S("\xE2\x98\x85") },
-  { S("&star;"), S("\xE2\x98\x86") },
-  { S("&sstarf;"), S("\xE2\x8B\x86") },
-  { S("&ssmile;"), S("\xE2\x8C\xA3") },
-  { S("&ssetmn;"), S("\xE2\x88\x96") },
-  { S("&sscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&srarr;"), S("\xE2\x86\x92") },
-  { S("&squf;"), S("\xE2\x96\xAA") },
-  { S("&squarf;"), S("\xE2\x96\xAA") },
-  { S("&square;"), S("\xE2\x96\xA1") },
-  { S("&squ;"), S("\xE2\x96\xA1") },
-  { S("&sqsupseteq;"), S("\xE2\x8A\x92") },
-  { S("&sqsupset;"), S("\xE2\x8A\x90") },
-  { S("&sqsupe;"), S("\xE2\x8A\x92") },
-  { S("&sqsup;"), S("\xE2\x8A\x90") },
-  { S("&sqsubseteq;"), S("\xE2\x8A\x91") },
-  { S("&sqsubset;"), S("\xE2\x8A\x8F") },
-  { S("&sqsube;"), S("\xE2\x8A\x91") },
-  { S("&sqsub;"), S("\xE2\x8A\x8F") },
-  { S("&sqcups;"), S("\xE2\x8A\x94\xEF\xB8\x80") },
-  { S("&sqcup;"), S("\xE2\x8A\x94") },
-  { S("&sqcaps;"), S("\xE2\x8A\x93\xEF\xB8\x80") },
-  { S("&sqcap;"), S("\xE2\x8A\x93") },
-  { S("&spar;"), S("\xE2\x88\xA5") },
-  { S("&spadesuit;"), S("\xE2\x99\xA0") },
-  { S("&spades;"), S("\xE2\x99\xA0") },
-  { S("&sopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&solbar;"), S("\xE2\x8C\xBF") },
-  { S("&solb;"), S("\xE2\xA7\x84") },
-  { S("&sol;"), S("\x2F") },
-  { S("&softcy;"), S("\xD1\x8C") },
-  { S("&smtes;"), S("\xE2\xAA\xAC\xEF\xB8\x80") },
-  { S("&smte;"), S("\xE2\xAA\xAC") },
-  { S("&smt;"), S("\xE2\xAA\xAA") },
-  { S("&smile;"), S("\xE2\x8C\xA3") },
-  { S("&smid;"), S("\xE2\x88\xA3") },
-  { S("&smeparsl;"), S("\xE2\xA7\xA4") },
-  { S("&smashp;"), S("\xE2\xA8\xB3") },
-  { S("&smallsetminus;"), S("\xE2\x88\x96") },
-  { S("&slarr;"), S("\xE2\x86\x90") },
-  { S("&simrarr;"), S("\xE2\xA5\xB2") },
-  { S("&simplus;"), S("\xE2\xA8\xA4") },
-  { S("&simne;"), S("\xE2\x89\x86") },
-  { S("&simlE;"), S("\xE2\xAA\x9F") },
-  { S("&siml;"), S("\xE2\xAA\x9D") },
-  { S("&simgE;"), S("\xE2\xAA\xA0") },
-  { S("&simg;"), S("\xE2\xAA\x9E") },
-  { S("&simeq;"), S("\xE2\x89\x83") },
-  { S("&sime;"), S("\xE2\x89\x83") },
-  { S("&simdot;"), S("\xE2\xA9\xAA") },
-  { S("&sim;"), S("\xE2\x88\xBC") },
-  { S("&sigmav;"), S("\xCF\x82") },
-  { S("&sigmaf;"), S("\xCF\x82") },
-  { S("&sigma;"), S("\xCF\x83") },
-  { S("&shy;"), S("\xC2\xAD") },
-  { S("&shy"), S("\xC2\xAD") },
-  { S("&shortparallel;"), S("\xE2\x88\xA5") },
-  { S("&shortmid;"), S("\xE2\x88\xA3") },
-  { S("&shcy;"), S("\xD1\x88") },
-  { S("&shchcy;"), S("\xD1\x89") },
-  { S("&sharp;"), S("\xE2\x99\xAF") },
-  { S("&sfrown;"), S("\xE2\x8C\xA2") },
-  { S("&sfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&sext;"), S("\xE2\x9C\xB6") },
-  { S("&setmn;"), S("\xE2\x88\x96") },
-  { S("&setminus;"), S("\xE2\x88\x96") },
-  { S("&seswar;"), S("\xE2\xA4\xA9") },
-  { S("&semi;"), S("\x3B") },
-  { S("&sect;"), S("\xC2\xA7") },
-  { S("&sect"), S("\xC2\xA7") },
-  { S("&searrow;"), S("\xE2\x86\x98") },
-  { S("&searr;"), S("\xE2\x86\x98") },
-  { S("&searhk;"), S("\xE2\xA4\xA5") },
-  { S("&seArr;"), S("\xE2\x87\x98") },
-  { S("&sdote;"), S("\xE2\xA9\xA6") },
-  { S("&sdotb;"), S("\xE2\x8A\xA1") },
-  { S("&sdot;"), S("\xE2\x8B\x85") },
-  { S("&scy;"), S("\xD1\x81") },
-  { S("&scsim;"), S("\xE2\x89\xBF") },
-  { S("&scpolint;"), S("\xE2\xA8\x93") },
-  { S("&scnsim;"), S("\xE2\x8B\xA9") },
-  { S("&scnap;"), S("\xE2\xAA\xBA") },
-  { S("&scnE;"), S("\xE2\xAA\xB6") },
-  { S("&scirc;"), S("\xC5\x9D") },
-  { S("&scedil;"), S("\xC5\x9F") },
-  { S("&sce;"), S("\xE2\xAA\xB0") },
-  { S("&sccue;"), S("\xE2\x89\xBD") },
-  { S("&scaron;"), S("\xC5\xA1") },
-  { S("&scap;"), S("\xE2\xAA\xB8") },
-  { S("&scE;"), S("\xE2\xAA\xB4") },
-  { S("&sc;"), S("\xE2\x89\xBB") },
-  { S("&sbquo;"), S("\xE2\x80\x9A") },
-  { S("&sacute;"), S("\xC5\x9B") },
-  { S("&rx;"), S("\xE2\x84\x9E") },
-  { S("&ruluhar;"), S("\xE2\xA5\xA8") },
-  { S("&rtriltri;"), S("\xE2\xA7\x8E") },
-  { S("&rtrif;"), S("\xE2\x96\xB8") },
-  { S("&rtrie;"), S("\xE2\x8A\xB5") },
-  { S("&rtri;"), S("\xE2\x96\xB9") },
-  { S("&rtimes;"), S("\xE2\x8B\x8A") },
-  { S("&rthree;"), S("\xE2\x8B\x8C") },
-  { S("&rsquor;"), S("\xE2\x80\x99") },
-  { S("&rsquo;"), S("\xE2\x80\x99") },
-  { S("&rsqb;"), S("\x5D") },
-  { S("&rsh;"), S("\xE2\x86\xB1") },
-  { S("&rscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&rsaquo;"), S("\xE2\x80\xBA") },
-  { S("&rrarr;"), S("\xE2\x87\x89") },
-  { S("&rppolint;"), S("\xE2\xA8\x92") },
-  { S("&rpargt;"), S("\xE2\xA6\x94") },
-  { S("&rpar;"), S("\x29") },
-  { S("&rotimes;"), S("\xE2\xA8\xB5") },
-  { S("&roplus;"), S("\xE2\xA8\xAE") },
-  { S("&ropf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&ropar;"), S("\xE2\xA6\x86") },
-  { S("&robrk;"), S("\xE2\x9F\xA7") },
-  { S("&roarr;"), S("\xE2\x87\xBE") },
-  { S("&roang;"), S("\xE2\x9F\xAD") },
-  { S("&rnmid;"), S("\xE2\xAB\xAE") },
-  { S("&rmoustache;"), S("\xE2\x8E\xB1") },
-  { S("&rmoust;"), S("\xE2\x8E\xB1") },
-  { S("&rlm;"), S("\xE2\x80\x8F") },
-  { S("&rlhar;"), S("\xE2\x87\x8C") },
-  { S("&rlarr;"), S("\xE2\x87\x84") },
-  { S("&risingdotseq;"), S("\xE2\x89\x93") },
-  { S("&ring;"), S("\xCB\x9A") },
-  { S("&rightthreetimes;"), S("\xE2\x8B\x8C") },
-  { S("&rightsquigarrow;"), S("\xE2\x86\x9D") },
-  { S("&rightrightarrows;"), S("\xE2\x87\x89") },
-  { S("&rightleftharpoons;"), S("\xE2\x87\x8C") },
-  { S("&rightleftarrows;"), S("\xE2\x87\x84") },
-  { S("&rightharpoonup;"), S("\xE2\x87\x80") },
-  { S("&rightharpoondown;"), S("\xE2\x87\x81") },
-  { S("&rightarrowtail;"), S("\xE2\x86\xA3") },
-  { S("&rightarrow;"), S("\xE2\x86\x92") },
-  { S("&rhov;"), S("\xCF\xB1") },
-  { S("&rho;"), S("\xCF\x81") },
-  { S("&rharul;"), S("\xE2\xA5\xAC") },
-  { S("&rharu;"), S("\xE2\x87\x80") },
-  { S("&rhard;"), S("\xE2\x87\x81") },
-  { S("&rfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&rfloor;"), S("\xE2\x8C\x8B") },
-  { S("&rfisht;"), S("\xE2\xA5\xBD") },
-  { S("&reg;"), S("\xC2\xAE") },
-  { S("&reg"), S("\xC2\xAE") },
-  { S("&rect;"), S("\xE2\x96\xAD") },
-  { S("&reals;"), S("\xE2\x84\x9D") },
-  { S("&realpart;"), S("\xE2\x84\x9C") },
-  { S("&realine;"), S("\xE2\x84\x9B") },
-  { S("&real;"), S("\xE2\x84\x9C") },
-  { S("&rdsh;"), S("\xE2\x86\xB3") },
-  { S("&rdquor;"), S("\xE2\x80\x9D") },
-  { S("&rdquo;"), S("\xE2\x80\x9D") },
-  { S("&rdldhar;"), S("\xE2\xA5\xA9") },
-  { S("&rdca;"), S("\xE2\xA4\xB7") },
-  { S("&rcy;"), S("\xD1\x80") },
-  { S("&rcub;"), S("\x7D") },
-  { S("&rceil;"), S("\xE2\x8C\x89") },
-  { S("&rcedil;"), S("\xC5\x97") },
-  { S("&rcaron;"), S("\xC5\x99") },
-  { S("&rbrkslu;"), S("\xE2\xA6\x90") },
-  { S("&rbrksld;"), S("\xE2\xA6\x8E") },
-  { S("&rbrke;"), S("\xE2\xA6\x8C") },
-  { S("&rbrack;"), S("\x5D") },
-  { S("&rbrace;"), S("\x7D") },
-  { S("&rbbrk;"), S("\xE2\x9D\xB3") },
-  { S("&rbarr;"), S("\xE2\xA4\x8D") },
-  { S("&rationals;"), S("\xE2\x84\x9A") },
-  { S("&ratio;"), S("\xE2\x88\xB6") },
-  { S("&ratail;"), S("\xE2\xA4\x9A") },
-  { S("&rarrw;"), S("\xE2\x86\x9D") },
-  { S("&rarrtl;"), S("\xE2\x86\xA3") },
-  { S("&rarrsim;"), S("\xE2\xA5\xB4") },
-  { S("&rarrpl;"), S("\xE2\xA5\x85") },
-  { S("&rarrlp;"), S("\xE2\x86\xAC") },
-  { S("&rarrhk;"), S("\xE2\x86\xAA") },
-  { S("&rarrfs;"), S("\xE2\xA4\x9E") },
-  { S("&rarrc;"), S("\xE2\xA4\xB3") },
-  { S("&rarrbfs;"), S("\xE2\xA4\xA0") },
-  { S("&rarrb;"), S("\xE2\x87\xA5") },
-  { S("&rarrap;"), S("\xE2\xA5\xB5") },
-  { S("&rarr;"), S("\xE2\x86\x92") },
-  { S("&raquo;"), S("\xC2\xBB") },
-  { S("&raquo"), S("\xC2\xBB") },
-  { S("&rangle;"), S("\xE2\x9F\xA9") },
-  { S("&range;"), S("\xE2\xA6\xA5") },
-  { S("&rangd;"), S("\xE2\xA6\x92") },
-  { S("&rang;"), S("\xE2\x9F\xA9") },
-  { S("&raemptyv;"), S("\xE2\xA6\xB3") },
-  { S("&radic;"), S("\xE2\x88\x9A") },
-  { S("&racute;"), S("\xC5\x95") },
-  { S("&race;"), S("\xE2\x88\xBD\xCC\xB1") },
-  { S("&rHar;"), S("\xE2\xA5\xA4") },
-  { S("&rBarr;"), S("\xE2\xA4\x8F") },
-  { S("&rAtail;"), S("\xE2\xA4\x9C") },
-  { S("&rArr;"), S("\xE2\x87\x92") },
-  { S("&rAarr;"), S("\xE2\x87\x9B") },
-  { S("&quot;"), S("\x22") },
-  { S("&quot"), S("\x22") },
-  { S("&questeq;"), S("\xE2\x89\x9F") },
-  { S("&quest;"), S("\x3F") },
-  { S("&quatint;"), S("\xE2\xA8\x96") },
-  { S("&quaternions;"), S("\xE2\x84\x8D") },
-  { S("&qscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&qprime;"), S("\xE2\x81\x97") },
-  { S("&qopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&qint;"), S("\xE2\xA8\x8C") },
-  { S("&qfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&puncsp;"), S("\xE2\x80\x88") },
-  { S("&psi;"), S("\xCF\x88") },
-  { S("&pscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&prurel;"), S("\xE2\x8A\xB0") },
-  { S("&prsim;"), S("\xE2\x89\xBE") },
-  { S("&propto;"), S("\xE2\x88\x9D") },
-  { S("&prop;"), S("\xE2\x88\x9D") },
-  { S("&profsurf;"), S("\xE2\x8C\x93") },
-  { S("&profline;"), S("\xE2\x8C\x92") },
-  { S("&profalar;"), S("\xE2\x8C\xAE") },
-  { S("&prod;"), S("\xE2\x88\x8F") },
-  { S("&prnsim;"), S("\xE2\x8B\xA8") },
-  { S("&prnap;"), S("\xE2\xAA\xB9") },
-  { S("&prnE;"), S("\xE2\xAA\xB5") },
-  { S("&primes;"), S("\xE2\x84\x99") },
-  { S("&prime;"), S("\xE2\x80\xB2") },
-  { S("&precsim;"), S("\xE2\x89\xBE") },
-  { S("&precnsim;"), S("\xE2\x8B\xA8") },
-  { S("&precneqq;"), S("\xE2\xAA\xB5") },
-  { S("&precnapprox;"), S("\xE2\xAA\xB9") },
-  { S("&preceq;"), S("\xE2\xAA\xAF") },
-  { S("&preccurlyeq;"), S("\xE2\x89\xBC") },
-  { S("&precapprox;"), S("\xE2\xAA\xB7") },
-  { S("&prec;"), S("\xE2\x89\xBA") },
-  { S("&pre;"), S("\xE2\xAA\xAF") },
-  { S("&prcue;"), S("\xE2\x89\xBC") },
-  { S("&prap;"), S("\xE2\xAA\xB7") },
-  { S("&prE;"), S("\xE2\xAA\xB3") },
-  { S("&pr;"), S("\xE2\x89\xBA") },
-  { S("&pound;"), S("\xC2\xA3") },
-  { S("&pound"), S("\xC2\xA3") },
-  { S("&popf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&pointint;"), S("\xE2\xA8\x95") },
-  { S("&pm;"), S("\xC2\xB1") },
-  { S("&plustwo;"), S("\xE2\xA8\xA7") },
-  { S("&plussim;"), S("\xE2\xA8\xA6") },
-  { S("&plusmn;"), S("\xC2\xB1") },
-  { S("&plusmn"), S("\xC2\xB1") },
-  { S("&pluse;"), S("\xE2\xA9\xB2") },
-  { S("&plusdu;"), S("\xE2\xA8\xA5") },
-  { S("&plusdo;"), S("\xE2\x88\x94") },
-  { S("&pluscir;"), S("\xE2\xA8\xA2") },
-  { S("&plusb;"), S("\xE2\x8A\x9E") },
-  { S("&plusacir;"), S("\xE2\xA8\xA3") },
-  { S("&plus;"), S("\x2B") },
-  { S("&plankv;"), S("\xE2\x84\x8F") },
-  { S("&planckh;"), S("\xE2\x84\x8E") },
-  { S("&planck;"), S("\xE2\x84\x8F") },
-  { S("&piv;"), S("\xCF\x96") },
-  { S("&pitchfork;"), S("\xE2\x8B\x94") },
-  { S("&pi;"), S("\xCF\x80") },
-  { S("&phone;"), S("\xE2\x98\x8E") },
-  { S("&phmmat;"), S("\xE2\x84\xB3") },
-  { S("&phiv;"), S("\xCF\x95") },
-  { S("&phi;"), S("\xCF\x86") },
-  { S("&pfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&pertenk;"), S("\xE2\x80\xB1") },
-  { S("&perp;"), S("\xE2\x8A\xA5") },
-  { S("&permil;"), S("\xE2\x80\xB0") },
-  { S("&period;"), S("\x2E") },
-  { S("&percnt;"), S("\x25") },
-  { S("&pcy;"), S("\xD0\xBF") },
-  { S("&part;"), S("\xE2\x88\x82") },
-  { S("&parsl;"), S("\xE2\xAB\xBD") },
-  { S("&parsim;"), S("\xE2\xAB\xB3") },
-  { S("&parallel;"), S("\xE2\x88\xA5") },
-  { S("&para;"), S("\xC2\xB6") },
-  { S("&para"), S("\xC2\xB6") },
-  { S("&par;"), S("\xE2\x88\xA5") },
-  { S("&ovbar;"), S("\xE2\x8C\xBD") },
-  { S("&ouml;"), S("\xC3\xB6") },
-  { S("&ouml"), S("\xC3\xB6") },
-  { S("&otimesas;"), S("\xE2\xA8\xB6") },
-  { S("&otimes;"), S("\xE2\x8A\x97") },
-  { S("&otilde;"), S("\xC3\xB5") },
-  { S("&otilde"), S("\xC3\xB5") },
-  { S("&osol;"), S("\xE2\x8A\x98") },
-  { S("&oslash;"), S("\xC3\xB8") },
-  { S("&oslash"), S("\xC3\xB8") },
-  { S("&oscr;"), S("\xE2\x84\xB4") },
-  { S("&orv;"), S("\xE2\xA9\x9B") },
-  { S("&orslope;"), S("\xE2\xA9\x97") },
-  { S("&oror;"), S("\xE2\xA9\x96") },
-  { S("&origof;"), S("\xE2\x8A\xB6") },
-  { S("&ordm;"), S("\xC2\xBA") },
-  { S("&ordm"), S("\xC2\xBA") },
-  { S("&ordf;"), S("\xC2\xAA") },
-  { S("&ordf"), S("\xC2\xAA") },
-  { S("&orderof;"), S("\xE2\x84\xB4") },
-  { S("&order;"), S("\xE2\x84\xB4") },
-  { S("&ord;"), S("\xE2\xA9\x9D") },
-  { S("&orarr;"), S("\xE2\x86\xBB") },
-  { S("&or;"), S("\xE2\x88\xA8") },
-  { S("&oplus;"), S("\xE2\x8A\x95") },
-  { S("&operp;"), S("\xE2\xA6\xB9") },
-  { S("&opar;"), S("\xE2\xA6\xB7") },
-  { S("&oopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&ominus;"), S("\xE2\x8A\x96") },
-  { S("&omid;"), S("\xE2\xA6\xB6") },
-  { S("&omicron;"), S("\xCE\xBF") },
-  { S("&omega;"), S("\xCF\x89") },
-  { S("&omacr;"), S("\xC5\x8D") },
-  { S("&olt;"), S("\xE2\xA7\x80") },
-  { S("&oline;"), S("\xE2\x80\xBE") },
-  { S("&olcross;"), S("\xE2\xA6\xBB") },
-  { S("&olcir;"), S("\xE2\xA6\xBE") },
-  { S("&olarr;"), S("\xE2\x86\xBA") },
-  { S("&oint;"), S("\xE2\x88\xAE") },
-  { S("&ohm;"), S("\xCE\xA9") },
-  { S("&ohbar;"), S("\xE2\xA6\xB5") },
-  { S("&ogt;"), S("\xE2\xA7\x81") },
-  { S("&ograve;"), S("\xC3\xB2") },
-  { S("&ograve"), S("\xC3\xB2") },
-  { S("&ogon;"), S("\xCB\x9B") },
-  { S("&ofr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&ofcir;"), S("\xE2\xA6\xBF") },
-  { S("&oelig;"), S("\xC5\x93") },
-  { S("&odsold;"), S("\xE2\xA6\xBC") },
-  { S("&odot;"), S("\xE2\x8A\x99") },
-  { S("&odiv;"), S("\xE2\xA8\xB8") },
-  { S("&odblac;"), S("\xC5\x91") },
-  { S("&odash;"), S("\xE2\x8A\x9D") },
-  { S("&ocy;"), S("\xD0\xBE") },
-  { S("&ocirc;"), S("\xC3\xB4") },
-  { S("&ocirc"), S("\xC3\xB4") },
-  { S("&ocir;"), S("\xE2\x8A\x9A") },
-  { S("&oast;"), S("\xE2\x8A\x9B") },
-  { S("&oacute;"), S("\xC3\xB3") },
-  { S("&oacute"), S("\xC3\xB3") },
-  { S("&oS;"), S("\xE2\x93\x88") },
-  { S("&nwnear;"), S("\xE2\xA4\xA7") },
-  { S("&nwarrow;"), S("\xE2\x86\x96") },
-  { S("&nwarr;"), S("\xE2\x86\x96") },
-  { S("&nwarhk;"), S("\xE2\xA4\xA3") },
-  { S("&nwArr;"), S("\xE2\x87\x96") },
-  { S("&nvsim;"), S("\xE2\x88\xBC\xE2\x83\x92") },
-  { S("&nvrtrie;"), S("\xE2\x8A\xB5\xE2\x83\x92") },
-  { S("&nvrArr;"), S("\xE2\xA4\x83") },
-  { S("&nvltrie;"), S("\xE2\x8A\xB4\xE2\x83\x92") },
-  { S("&nvlt;"), S("\x3C\xE2\x83\x92") },
-  { S("&nvle;"), S("\xE2\x89\xA4\xE2\x83\x92") },
-  { S("&nvlArr;"), S("\xE2\xA4\x82") },
-  { S("&nvinfin;"), S("\xE2\xA7\x9E") },
-  { S("&nvgt;"), S("\x3E\xE2\x83\x92") },
-  { S("&nvge;"), S("\xE2\x89\xA5\xE2\x83\x92") },
-  { S("&nvdash;"), S("\xE2\x8A\xAC") },
-  { S("&nvap;"), S("\xE2\x89\x8D\xE2\x83\x92") },
-  { S("&nvHarr;"), S("\xE2\xA4\x84") },
-  { S("&nvDash;"), S("\xE2\x8A\xAD") },
-  { S("&numsp;"), S("\xE2\x80\x87") },
-  { S("&numero;"), S("\xE2\x84\x96") },
-  { S("&num;"), S("\x23") },
-  { S("&nu;"), S("\xCE\xBD") },
-  { S("&ntrianglerighteq;"), S("\xE2\x8B\xAD") },
-  { S("&ntriangleright;"), S("\xE2\x8B\xAB") },
-  { S("&ntrianglelefteq;"), S("\xE2\x8B\xAC") },
-  { S("&ntriangleleft;"), S("\xE2\x8B\xAA") },
-  { S("&ntlg;"), S("\xE2\x89\xB8") },
-  { S("&ntilde;"), S("\xC3\xB1") },
-  { S("&ntilde"), S("\xC3\xB1") },
-  { S("&ntgl;"), S("\xE2\x89\xB9") },
-  { S("&nsupseteqq;"), S("\xE2\xAB\x86\xCC\xB8") },
-  { S("&nsupseteq;"), S("\xE2\x8A\x89") },
-  { S("&nsupset;"), S("\xE2\x8A\x83\xE2\x83\x92") },
-  { S("&nsupe;"), S("\xE2\x8A\x89") },
-  { S("&nsupE;"), S("\xE2\xAB\x86\xCC\xB8") },
-  { S("&nsup;"), S("\xE2\x8A\x85") },
-  { S("&nsucceq;"), S("\xE2\xAA\xB0\xCC\xB8") },
-  { S("&nsucc;"), S("\xE2\x8A\x81") },
-  { S("&nsubseteqq;"), S("\xE2\xAB\x85\xCC\xB8") },
-  { S("&nsubseteq;"), S("\xE2\x8A\x88") },
-  { S("&nsubset;"), S("\xE2\x8A\x82\xE2\x83\x92") },
-  { S("&nsube;"), S("\xE2\x8A\x88") },
-  { S("&nsubE;"), S("\xE2\xAB\x85\xCC\xB8") },
-  { S("&nsub;"), S("\xE2\x8A\x84") },
-  { S("&nsqsupe;"), S("\xE2\x8B\xA3") },
-  { S("&nsqsube;"), S("\xE2\x8B\xA2") },
-  { S("&nspar;"), S("\xE2\x88\xA6") },
-  { S("&nsmid;"), S("\xE2\x88\xA4") },
-  { S("&nsimeq;"), S("\xE2\x89\x84") },
-  { S("&nsime;"), S("\xE2\x89\x84") },
-  { S("&nsim;"), S("\xE2\x89\x81") },
-  { S("&nshortparallel;"), S("\xE2\x88\xA6") },
-  { S("&nshortmid;"), S("\xE2\x88\xA4") },
-  { S("&nscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&nsce;"), S("\xE2\xAA\xB0\xCC\xB8") },
-  { S("&nsccue;"), S("\xE2\x8B\xA1") },
-  { S("&nsc;"), S("\xE2\x8A\x81") },
-  { S("&nrtrie;"), S("\xE2\x8B\xAD") },
-  { S("&nrtri;"), S("\xE2\x8B\xAB") },
-  { S("&nrightarrow;"), S("\xE2\x86\x9B") },
-  { S("&nrarrw;"), S("\xE2\x86\x9D\xCC\xB8") },
-  { S("&nrarrc;"), S("\xE2\xA4\xB3\xCC\xB8") },
-  { S("&nrarr;"), S("\xE2\x86\x9B") },
-  { S("&nrArr;"), S("\xE2\x87\x8F") },
-  { S("&npreceq;"), S("\xE2\xAA\xAF\xCC\xB8") },
-  { S("&nprec;"), S("\xE2\x8A\x80") },
-  { S("&npre;"), S("\xE2\xAA\xAF\xCC\xB8") },
-  { S("&nprcue;"), S("\xE2\x8B\xA0") },
-  { S("&npr;"), S("\xE2\x8A\x80") },
-  { S("&npolint;"), S("\xE2\xA8\x94") },
-  { S("&npart;"), S("\xE2\x88\x82\xCC\xB8") },
-  { S("&nparsl;"), S("\xE2\xAB\xBD\xE2\x83\xA5") },
-  { S("&nparallel;"), S("\xE2\x88\xA6") },
-  { S("&npar;"), S("\xE2\x88\xA6") },
-  { S("&notnivc;"), S("\xE2\x8B\xBD") },
-  { S("&notnivb;"), S("\xE2\x8B\xBE") },
-  { S("&notniva;"), S("\xE2\x88\x8C") },
-  { S("&notni;"), S("\xE2\x88\x8C") },
-  { S("&notinvc;"), S("\xE2\x8B\xB6") },
-  { S("&notinvb;"), S("\xE2\x8B\xB7") },
-  { S("&notinva;"), S("\xE2\x88\x89") },
-  { S("&notindot;"), S("\xE2\x8B\xB5\xCC\xB8") },
-  { S("&notinE;"), S("\xE2\x8B\xB9\xCC\xB8") },
-  { S("&notin;"), S("\xE2\x88\x89") },
-  { S("&not;"), S("\xC2\xAC") },
-  { S("&not"), S("\xC2\xAC") },
-  { S("&nopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&nmid;"), S("\xE2\x88\xA4") },
-  { S("&nltrie;"), S("\xE2\x8B\xAC") },
-  { S("&nltri;"), S("\xE2\x8B\xAA") },
-  { S("&nlt;"), S("\xE2\x89\xAE") },
-  { S("&nlsim;"), S("\xE2\x89\xB4") },
-  { S("&nless;"), S("\xE2\x89\xAE") },
-  { S("&nles;"), S("\xE2\xA9\xBD\xCC\xB8") },
-  { S("&nleqslant;"), S("\xE2\xA9\xBD\xCC\xB8") },
-  { S("&nleqq;"), S("\xE2\x89\xA6\xCC\xB8") },
-  { S("&nleq;"), S("\xE2\x89\xB0") },
-  { S("&nleftrightarrow;"), S("\xE2\x86\xAE") },
-  { S("&nleftarrow;"), S("\xE2\x86\x9A") },
-  { S("&nle;"), S("\xE2\x89\xB0") },
-  { S("&nldr;"), S("\xE2\x80\xA5") },
-  { S("&nlarr;"), S("\xE2\x86\x9A") },
-  { S("&nlE;"), S("\xE2\x89\xA6\xCC\xB8") },
-  { S("&nlArr;"), S("\xE2\x87\x8D") },
-  { S("&njcy;"), S("\xD1\x9A") },
-  { S("&niv;"), S("\xE2\x88\x8B") },
-  { S("&nisd;"), S("\xE2\x8B\xBA") },
-  { S("&nis;"), S("\xE2\x8B\xBC") },
-  { S("&ni;"), S("\xE2\x88\x8B") },
-  { S("&nhpar;"), S("\xE2\xAB\xB2") },
-  { S("&nharr;"), S("\xE2\x86\xAE") },
-  { S("&nhArr;"), S("\xE2\x87\x8E") },
-  { S("&ngtr;"), S("\xE2\x89\xAF") },
-  { S("&ngt;"), S("\xE2\x89\xAF") },
-  { S("&ngsim;"), S("\xE2\x89\xB5") },
-  { S("&nges;"), S("\xE2\xA9\xBE\xCC\xB8") },
-  { S("&ngeqslant;"), S("\xE2\xA9\xBE\xCC\xB8") },
-  { S("&ngeqq;"), S("\xE2\x89\xA7\xCC\xB8") },
-  { S("&ngeq;"), S("\xE2\x89\xB1") },
-  { S("&nge;"), S("\xE2\x89\xB1") },
-  { S("&ngE;"), S("\xE2\x89\xA7\xCC\xB8") },
-  { S("&nfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&nexists;"), S("\xE2\x88\x84") },
-  { S("&nexist;"), S("\xE2\x88\x84") },
-  { S("&nesim;"), S("\xE2\x89\x82\xCC\xB8") },
-  { S("&nesear;"), S("\xE2\xA4\xA8") },
-  { S("&nequiv;"), S("\xE2\x89\xA2") },
-  { S("&nedot;"), S("\xE2\x89\x90\xCC\xB8") },
-  { S("&nearrow;"), S("\xE2\x86\x97") },
-  { S("&nearr;"), S("\xE2\x86\x97") },
-  { S("&nearhk;"), S("\xE2\xA4\xA4") },
-  { S("&neArr;"), S("\xE2\x87\x97") },
-  { S("&ne;"), S("\xE2\x89\xA0") },
-  { S("&ndash;"), S("\xE2\x80\x93") },
-  { S("&ncy;"), S("\xD0\xBD") },
-  { S("&ncup;"), S("\xE2\xA9\x82") },
-  { S("&ncongdot;"), S("\xE2\xA9\xAD\xCC\xB8") },
-  { S("&ncong;"), S("\xE2\x89\x87") },
-  { S("&ncedil;"), S("\xC5\x86") },
-  { S("&ncaron;"), S("\xC5\x88") },
-  { S("&ncap;"), S("\xE2\xA9\x83") },
-  { S("&nbumpe;"), S("\xE2\x89\x8F\xCC\xB8") },
-  { S("&nbump;"), S("\xE2\x89\x8E\xCC\xB8") },
-  { S("&nbsp;"), S("\xC2\xA0") },
-  { S("&nbsp"), S("\xC2\xA0") },
-  { S("&naturals;"), S("\xE2\x84\x95") },
-  { S("&natural;"), S("\xE2\x99\xAE") },
-  { S("&natur;"), S("\xE2\x99\xAE") },
-  { S("&napprox;"), S("\xE2\x89\x89") },
-  { S("&napos;"), S("\xC5\x89") },
-  { S("&napid;"), S("\xE2\x89\x8B\xCC\xB8") },
-  { S("&napE;"), S("\xE2\xA9\xB0\xCC\xB8") },
-  { S("&nap;"), S("\xE2\x89\x89") },
-  { S("&nang;"), S("\xE2\x88\xA0\xE2\x83\x92") },
-  { S("&nacute;"), S("\xC5\x84") },
-  { S("&nabla;"), S("\xE2\x88\x87") },
-  { S("&nVdash;"), S("\xE2\x8A\xAE") },
-  { S("&nVDash;"), S("\xE2\x8A\xAF") },
-  { S("&nRightarrow;"), S("\xE2\x87\x8F") },
-  { S("&nLtv;"), S("\xE2\x89\xAA\xCC\xB8") },
-  { S("&nLt;"), S("\xE2\x89\xAA\xE2\x83\x92") },
-  { S("&nLl;"), S("\xE2\x8B\x98\xCC\xB8") },
-  { S("&nLeftrightarrow;"), S("\xE2\x87\x8E") },
-  { S("&nLeftarrow;"), S("\xE2\x87\x8D") },
-  { S("&nGtv;"), S("\xE2\x89\xAB\xCC\xB8") },
-  { S("&nGt;"), S("\xE2\x89\xAB\xE2\x83\x92") },
-  { S("&nGg;"), S("\xE2\x8B\x99\xCC\xB8") },
-  { S("&mumap;"), S("\xE2\x8A\xB8") },
-  { S("&multimap;"), S("\xE2\x8A\xB8") },
-  { S("&mu;"), S("\xCE\xBC") },
-  { S("&mstpos;"), S("\xE2\x88\xBE") },
-  { S("&mscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&mp;"), S("\xE2\x88\x93") },
-  { S("&mopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&models;"), S("\xE2\x8A\xA7") },
-  { S("&mnplus;"), S("\xE2\x88\x93") },
-  { S("&mldr;"), S("\xE2\x80\xA6") },
-  { S("&mlcp;"), S("\xE2\xAB\x9B") },
-  { S("&minusdu;"), S("\xE2\xA8\xAA") },
-  { S("&minusd;"), S("\xE2\x88\xB8") },
-  { S("&minusb;"), S("\xE2\x8A\x9F") },
-  { S("&minus;"), S("\xE2\x88\x92") },
-  { S("&middot;"), S("\xC2\xB7") },
-  { S("&middot"), S("\xC2\xB7") },
-  { S("&midcir;"), S("\xE2\xAB\xB0") },
-  { S("&midast;"), S("\x2A") },
-  { S("&mid;"), S("\xE2\x88\xA3") },
-  { S("&micro;"), S("\xC2\xB5") },
-  { S("&micro"), S("\xC2\xB5") },
-  { S("&mho;"), S("\xE2\x84\xA7") },
-  { S("&mfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&measuredangle;"), S("\xE2\x88\xA1") },
-  { S("&mdash;"), S("\xE2\x80\x94") },
-  { S("&mcy;"), S("\xD0\xBC") },
-  { S("&mcomma;"), S("\xE2\xA8\xA9") },
-  { S("&marker;"), S("\xE2\x96\xAE") },
-  { S("&mapstoup;"), S("\xE2\x86\xA5") },
-  { S("&mapstoleft;"), S("\xE2\x86\xA4") },
-  { S("&mapstodown;"), S("\xE2\x86\xA7") },
-  { S("&mapsto;"), S("\xE2\x86\xA6") },
-  { S("&map;"), S("\xE2\x86\xA6") },
-  { S("&maltese;"), S("\xE2\x9C\xA0") },
-  { S("&malt;"), S("\xE2\x9C\xA0") },
-  { S("&male;"), S("\xE2\x99\x82") },
-  { S("&macr;"), S("\xC2\xAF") },
-  { S("&macr"), S("\xC2\xAF") },
-  { S("&mDDot;"), S("\xE2\x88\xBA") },
-  { S("&lvnE;"), S("\xE2\x89\xA8\xEF\xB8\x80") },
-  { S("&lvertneqq;"), S("\xE2\x89\xA8\xEF\xB8\x80") },
-  { S("&luruhar;"), S("\xE2\xA5\xA6") },
-  { S("&lurdshar;"), S("\xE2\xA5\x8A") },
-  { S("&ltrif;"), S("\xE2\x97\x82") },
-  { S("&ltrie;"), S("\xE2\x8A\xB4") },
-  { S("&ltri;"), S("\xE2\x97\x83") },
-  { S("&ltrPar;"), S("\xE2\xA6\x96") },
-  { S("&ltquest;"), S("\xE2\xA9\xBB") },
-  { S("&ltlarr;"), S("\xE2\xA5\xB6") },
-  { S("&ltimes;"), S("\xE2\x8B\x89") },
-  { S("&lthree;"), S("\xE2\x8B\x8B") },
-  { S("&ltdot;"), S("\xE2\x8B\x96") },
-  { S("&ltcir;"), S("\xE2\xA9\xB9") },
-  { S("&ltcc;"), S("\xE2\xAA\xA6") },
-  { S("&lt;"), S("\x3C") },
-  { S("&lt"), S("\x3C") },
-  { S("&lstrok;"), S("\xC5\x82") },
-  { S("&lsquor;"), S("\xE2\x80\x9A") },
-  { S("&lsquo;"), S("\xE2\x80\x98") },
-  { S("&lsqb;"), S("\x5B") },
-  { S("&lsimg;"), S("\xE2\xAA\x8F") },
-  { S("&lsime;"), S("\xE2\xAA\x8D") },
-  { S("&lsim;"), S("\xE2\x89\xB2") },
-  { S("&lsh;"), S("\xE2\x86\xB0") },
-  { S("&lscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&lsaquo;"), S("\xE2\x80\xB9") },
-  { S("&lrtri;"), S("\xE2\x8A\xBF") },
-  { S("&lrm;"), S("\xE2\x80\x8E") },
-  { S("&lrhard;"), S("\xE2\xA5\xAD") },
-  { S("&lrhar;"), S("\xE2\x87\x8B") },
-  { S("&lrcorner;"), S("\xE2\x8C\x9F") },
-  { S("&lrarr;"), S("\xE2\x87\x86") },
-  { S("&lparlt;"), S("\xE2\xA6\x93") },
-  { S("&lpar;"), S("\x28") },
-  { S("&lozf;"), S("\xE2\xA7\xAB") },
-  { S("&lozenge;"), S("\xE2\x97\x8A") },
-  { S("&loz;"), S("\xE2\x97\x8A") },
-  { S("&lowbar;"), S("\x5F") },
-  { S("&lowast;"), S("\xE2\x88\x97") },
-  { S("&lotimes;"), S("\xE2\xA8\xB4") },
-  { S("&loplus;"), S("\xE2\xA8\xAD") },
-  { S("&lopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&lopar;"), S("\xE2\xA6\x85") },
-  { S("&looparrowright;"), S("\xE2\x86\xAC") },
-  { S("&looparrowleft;"), S("\xE2\x86\xAB") },
-  { S("&longrightarrow;"), S("\xE2\x9F\xB6") },
-  { S("&longmapsto;"), S("\xE2\x9F\xBC") },
-  { S("&longleftrightarrow;"), S("\xE2\x9F\xB7") },
-  { S("&longleftarrow;"), S("\xE2\x9F\xB5") },
-  { S("&lobrk;"), S("\xE2\x9F\xA6") },
-  { S("&loarr;"), S("\xE2\x87\xBD") },
-  { S("&loang;"), S("\xE2\x9F\xAC") },
-  { S("&lnsim;"), S("\xE2\x8B\xA6") },
-  { S("&lneqq;"), S("\xE2\x89\xA8") },
-  { S("&lneq;"), S("\xE2\xAA\x87") },
-  { S("&lne;"), S("\xE2\xAA\x87") },
-  { S("&lnapprox;"), S("\xE2\xAA\x89") },
-  { S("&lnap;"), S("\xE2\xAA\x89") },
-  { S("&lnE;"), S("\xE2\x89\xA8") },
-  { S("&lmoustache;"), S("\xE2\x8E\xB0") },
-  { S("&lmoust;"), S("\xE2\x8E\xB0") },
-  { S("&lmidot;"), S("\xC5\x80") },
-  { S("&lltri;"), S("\xE2\x97\xBA") },
-  { S("&llhard;"), S("\xE2\xA5\xAB") },
-  { S("&llcorner;"), S("\xE2\x8C\x9E") },
-  { S("&llarr;"), S("\xE2\x87\x87") },
-  { S("&ll;"), S("\xE2\x89\xAA") },
-  { S("&ljcy;"), S("\xD1\x99") },
-  { S("&lhblk;"), S("\xE2\x96\x84") },
-  { S("&lharul;"), S("\xE2\xA5\xAA") },
-  { S("&lharu;"), S("\xE2\x86\xBC") },
-  { S("&lhard;"), S("\xE2\x86\xBD") },
-  { S("&lgE;"), S("\xE2\xAA\x91") },
-  { S("&lg;"), S("\xE2\x89\xB6") },
-  { S("&lfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&lfloor;"), S("\xE2\x8C\x8A") },
-  { S("&lfisht;"), S("\xE2\xA5\xBC") },
-  { S("&lesssim;"), S("\xE2\x89\xB2") },
-  { S("&lessgtr;"), S("\xE2\x89\xB6") },
-  { S("&lesseqqgtr;"), S("\xE2\xAA\x8B") },
-  { S("&lesseqgtr;"), S("\xE2\x8B\x9A") },
-  { S("&lessdot;"), S("\xE2\x8B\x96") },
-  { S("&lessapprox;"), S("\xE2\xAA\x85") },
-  { S("&lesges;"), S("\xE2\xAA\x93") },
-  { S("&lesg;"), S("\xE2\x8B\x9A\xEF\xB8\x80") },
-  { S("&lesdotor;"), S("\xE2\xAA\x83") },
-  { S("&lesdoto;"), S("\xE2\xAA\x81") },
-  { S("&lesdot;"), S("\xE2\xA9\xBF") },
-  { S("&lescc;"), S("\xE2\xAA\xA8") },
-  { S("&les;"), S("\xE2\xA9\xBD") },
-  { S("&leqslant;"), S("\xE2\xA9\xBD") },
-  { S("&leqq;"), S("\xE2\x89\xA6") },
-  { S("&leq;"), S("\xE2\x89\xA4") },
-  { S("&leg;"), S("\xE2\x8B\x9A") },
-  { S("&leftthreetimes;"), S("\xE2\x8B\x8B") },
-  { S("&leftrightsquigarrow;"), S("\xE2\x86\xAD") },
-  { S("&leftrightharpoons;"), S("\xE2\x87\x8B") },
-  { S("&leftrightarrows;"), S("\xE2\x87\x86") },
-  { S("&leftrightarrow;"), S("\xE2\x86\x94") },
-  { S("&leftleftarrows;"), S("\xE2\x87\x87") },
-  { S("&leftharpoonup;"), S("\xE2\x86\xBC") },
-  { S("&leftharpoondown;"), S("\xE2\x86\xBD") },
-  { S("&leftarrowtail;"), S("\xE2\x86\xA2") },
-  { S("&leftarrow;"), S("\xE2\x86\x90") },
-  { S("&le;"), S("\xE2\x89\xA4") },
-  { S("&ldsh;"), S("\xE2\x86\xB2") },
-  { S("&ldrushar;"), S("\xE2\xA5\x8B") },
-  { S("&ldrdhar;"), S("\xE2\xA5\xA7") },
-  { S("&ldquor;"), S("\xE2\x80\x9E") },
-  { S("&ldquo;"), S("\xE2\x80\x9C") },
-  { S("&ldca;"), S("\xE2\xA4\xB6") },
-  { S("&lcy;"), S("\xD0\xBB") },
-  { S("&lcub;"), S("\x7B") },
-  { S("&lceil;"), S("\xE2\x8C\x88") },
-  { S("&lcedil;"), S("\xC4\xBC") },
-  { S("&lcaron;"), S("\xC4\xBE") },
-  { S("&lbrkslu;"), S("\xE2\xA6\x8D") },
-  { S("&lbrksld;"), S("\xE2\xA6\x8F") },
-  { S("&lbrke;"), S("\xE2\xA6\x8B") },
-  { S("&lbrack;"), S("\x5B") },
-  { S("&lbrace;"), S("\x7B") },
-  { S("&lbbrk;"), S("\xE2\x9D\xB2") },
-  { S("&lbarr;"), S("\xE2\xA4\x8C") },
-  { S("&lates;"), S("\xE2\xAA\xAD\xEF\xB8\x80") },
-  { S("&late;"), S("\xE2\xAA\xAD") },
-  { S("&latail;"), S("\xE2\xA4\x99") },
-  { S("&lat;"), S("\xE2\xAA\xAB") },
-  { S("&larrtl;"), S("\xE2\x86\xA2") },
-  { S("&larrsim;"), S("\xE2\xA5\xB3") },
-  { S("&larrpl;"), S("\xE2\xA4\xB9") },
-  { S("&larrlp;"), S("\xE2\x86\xAB") },
-  { S("&larrhk;"), S("\xE2\x86\xA9") },
-  { S("&larrfs;"), S("\xE2\xA4\x9D") },
-  { S("&larrbfs;"), S("\xE2\xA4\x9F") },
-  { S("&larrb;"), S("\xE2\x87\xA4") },
-  { S("&larr;"), S("\xE2\x86\x90") },
-  { S("&laquo;"), S("\xC2\xAB") },
-  { S("&laquo"), S("\xC2\xAB") },
-  { S("&lap;"), S("\xE2\xAA\x85") },
-  { S("&langle;"), S("\xE2\x9F\xA8") },
-  { S("&langd;"), S("\xE2\xA6\x91") },
-  { S("&lang;"), S("\xE2\x9F\xA8") },
-  { S("&lambda;"), S("\xCE\xBB") },
-  { S("&lagran;"), S("\xE2\x84\x92") },
-  { S("&laemptyv;"), S("\xE2\xA6\xB4") },
-  { S("&lacute;"), S("\xC4\xBA") },
-  { S("&lHar;"), S("\xE2\xA5\xA2") },
-  { S("&lEg;"), S("\xE2\xAA\x8B") },
-  { S("&lE;"), S("\xE2\x89\xA6") },
-  { S("&lBarr;"), S("\xE2\xA4\x8E") },
-  { S("&lAtail;"), S("\xE2\xA4\x9B") },
-  { S("&lArr;"), S("\xE2\x87\x90") },
-  { S("&lAarr;"), S("\xE2\x87\x9A") },
-  { S("&kscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&kopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&kjcy;"), S("\xD1\x9C") },
-  { S("&khcy;"), S("\xD1\x85") },
-  { S("&kgreen;"), S("\xC4\xB8") },
-  { S("&kfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&kcy;"), S("\xD0\xBA") },
-  { S("&kcedil;"), S("\xC4\xB7") },
-  { S("&kappav;"), S("\xCF\xB0") },
-  { S("&kappa;"), S("\xCE\xBA") },
-  { S("&jukcy;"), S("\xD1\x94") },
-  { S("&jsercy;"), S("\xD1\x98") },
-  { S("&jscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&jopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&jmath;"), S("\xC8\xB7") },
-  { S("&jfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&jcy;"), S("\xD0\xB9") },
-  { S("&jcirc;"), S("\xC4\xB5") },
-  { S("&iuml;"), S("\xC3\xAF") },
-  { S("&iuml"), S("\xC3\xAF") },
-  { S("&iukcy;"), S("\xD1\x96") },
-  { S("&itilde;"), S("\xC4\xA9") },
-  { S("&it;"), S("\xE2\x81\xA2") },
-  { S("&isinv;"), S("\xE2\x88\x88") },
-  { S("&isinsv;"), S("\xE2\x8B\xB3") },
-  { S("&isins;"), S("\xE2\x8B\xB4") },
-  { S("&isindot;"), S("\xE2\x8B\xB5") },
-  { S("&isinE;"), S("\xE2\x8B\xB9") },
-  { S("&isin;"), S("\xE2\x88\x88") },
-  { S("&iscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&iquest;"), S("\xC2\xBF") },
-  { S("&iquest"), S("\xC2\xBF") },
-  { S("&iprod;"), S("\xE2\xA8\xBC") },
-  { S("&iota;"), S("\xCE\xB9") },
-  { S("&iopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&iogon;"), S("\xC4\xAF") },
-  { S("&iocy;"), S("\xD1\x91") },
-  { S("&intprod;"), S("\xE2\xA8\xBC") },
-  { S("&intlarhk;"), S("\xE2\xA8\x97") },
-  { S("&intercal;"), S("\xE2\x8A\xBA") },
-  { S("&integers;"), S("\xE2\x84\xA4") },
-  { S("&intcal;"), S("\xE2\x8A\xBA") },
-  { S("&int;"), S("\xE2\x88\xAB") },
-  { S("&inodot;"), S("\xC4\xB1") },
-  { S("&infintie;"), S("\xE2\xA7\x9D") },
-  { S("&infin;"), S("\xE2\x88\x9E") },
-  { S("&incare;"), S("\xE2\x84\x85") },
-  { S("&in;"), S("\xE2\x88\x88") },
-  { S("&imped;"), S("\xC6\xB5") },
-  { S("&imof;"), S("\xE2\x8A\xB7") },
-  { S("&imath;"), S("\xC4\xB1") },
-  { S("&imagpart;"), S("\xE2\x84\x91") },
-  { S("&imagline;"), S("\xE2\x84\x90") },
-  { S("&image;"), S("\xE2\x84\x91") },
-  { S("&imacr;"), S("\xC4\xAB") },
-  { S("&ijlig;"), S("\xC4\xB3") },
-  { S("&iiota;"), S("\xE2\x84\xA9") },
-  { S("&iinfin;"), S("\xE2\xA7\x9C") },
-  { S("&iiint;"), S("\xE2\x88\xAD") },
-  { S("&iiiint;"), S("\xE2\xA8\x8C") },
-  { S("&ii;"), S("\xE2\x85\x88") },
-  { S("&igrave;"), S("\xC3\xAC") },
-  { S("&igrave"), S("\xC3\xAC") },
-  { S("&ifr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&iff;"), S("\xE2\x87\x94") },
-  { S("&iexcl;"), S("\xC2\xA1") },
-  { S("&iexcl"), S("\xC2\xA1") },
-  { S("&iecy;"), S("\xD0\xB5") },
-  { S("&icy;"), S("\xD0\xB8") },
-  { S("&icirc;"), S("\xC3\xAE") },
-  { S("&icirc"), S("\xC3\xAE") },
-  { S("&ic;"), S("\xE2\x81\xA3") },
-  { S("&iacute;"), S("\xC3\xAD") },
-  { S("&iacute"), S("\xC3\xAD") },
-  { S("&hyphen;"), S("\xE2\x80\x90") },
-  { S("&hybull;"), S("\xE2\x81\x83") },
-  { S("&hstrok;"), S("\xC4\xA7") },
-  { S("&hslash;"), S("\xE2\x84\x8F") },
-  { S("&hscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&horbar;"), S("\xE2\x80\x95") },
-  { S("&hopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&hookrightarrow;"), S("\xE2\x86\xAA") },
-  { S("&hookleftarrow;"), S("\xE2\x86\xA9") },
-  { S("&homtht;"), S("\xE2\x88\xBB") },
-  { S("&hoarr;"), S("\xE2\x87\xBF") },
-  { S("&hkswarow;"), S("\xE2\xA4\xA6") },
-  { S("&hksearow;"), S("\xE2\xA4\xA5") },
-  { S("&hfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&hercon;"), S("\xE2\x8A\xB9") },
-  { S("&hellip;"), S("\xE2\x80\xA6") },
-  { S("&heartsuit;"), S("\xE2\x99\xA5") },
-  { S("&hearts;"), S("\xE2\x99\xA5") },
-  { S("&hcirc;"), S("\xC4\xA5") },
-  { S("&hbar;"), S("\xE2\x84\x8F") },
-  { S("&harrw;"), S("\xE2\x86\xAD") },
-  { S("&harrcir;"), S("\xE2\xA5\x88") },
-  { S("&harr;"), S("\xE2\x86\x94") },
-  { S("&hardcy;"), S("\xD1\x8A") },
-  { S("&hamilt;"), S("\xE2\x84\x8B") },
-  { S("&half;"), S("\xC2\xBD") },
-  { S("&hairsp;"), S("\xE2\x80\x8A") },
-  { S("&hArr;"), S("\xE2\x87\x94") },
-  { S("&gvnE;"), S("\xE2\x89\xA9\xEF\xB8\x80") },
-  { S("&gvertneqq;"), S("\xE2\x89\xA9\xEF\xB8\x80") },
-  { S("&gtrsim;"), S("\xE2\x89\xB3") },
-  { S("&gtrless;"), S("\xE2\x89\xB7") },
-  { S("&gtreqqless;"), S("\xE2\xAA\x8C") },
-  { S("&gtreqless;"), S("\xE2\x8B\x9B") },
-  { S("&gtrdot;"), S("\xE2\x8B\x97") },
-  { S("&gtrarr;"), S("\xE2\xA5\xB8") },
-  { S("&gtrapprox;"), S("\xE2\xAA\x86") },
-  { S("&gtquest;"), S("\xE2\xA9\xBC") },
-  { S("&gtlPar;"), S("\xE2\xA6\x95") },
-  { S("&gtdot;"), S("\xE2\x8B\x97") },
-  { S("&gtcir;"), S("\xE2\xA9\xBA") },
-  { S("&gtcc;"), S("\xE2\xAA\xA7") },
-  { S("&gt;"), S("\x3E") },
-  { S("&gt"), S("\x3E") },
-  { S("&gsiml;"), S("\xE2\xAA\x90") },
-  { S("&gsime;"), S("\xE2\xAA\x8E") },
-  { S("&gsim;"), S("\xE2\x89\xB3") },
-  { S("&gscr;"), S("\xE2\x84\x8A") },
-  { S("&grave;"), S("\x60") },
-  { S("&gopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&gnsim;"), S("\xE2\x8B\xA7") },
-  { S("&gneqq;"), S("\xE2\x89\xA9") },
-  { S("&gneq;"), S("\xE2\xAA\x88") },
-  { S("&gne;"), S("\xE2\xAA\x88") },
-  { S("&gnapprox;"), S("\xE2\xAA\x8A") },
-  { S("&gnap;"), S("\xE2\xAA\x8A") },
-  { S("&gnE;"), S("\xE2\x89\xA9") },
-  { S("&glj;"), S("\xE2\xAA\xA4") },
-  { S("&gla;"), S("\xE2\xAA\xA5") },
-  { S("&glE;"), S("\xE2\xAA\x92") },
-  { S("&gl;"), S("\xE2\x89\xB7") },
-  { S("&gjcy;"), S("\xD1\x93") },
-  { S("&gimel;"), S("\xE2\x84\xB7") },
-  { S("&ggg;"), S("\xE2\x8B\x99") },
-  { S("&gg;"), S("\xE2\x89\xAB") },
-  { S("&gfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&gesles;"), S("\xE2\xAA\x94") },
-  { S("&gesl;"), S("\xE2\x8B\x9B\xEF\xB8\x80") },
-  { S("&gesdotol;"), S("\xE2\xAA\x84") },
-  { S("&gesdoto;"), S("\xE2\xAA\x82") },
-  { S("&gesdot;"), S("\xE2\xAA\x80") },
-  { S("&gescc;"), S("\xE2\xAA\xA9") },
-  { S("&ges;"), S("\xE2\xA9\xBE") },
-  { S("&geqslant;"), S("\xE2\xA9\xBE") },
-  { S("&geqq;"), S("\xE2\x89\xA7") },
-  { S("&geq;"), S("\xE2\x89\xA5") },
-  { S("&gel;"), S("\xE2\x8B\x9B") },
-  { S("&ge;"), S("\xE2\x89\xA5") },
-  { S("&gdot;"), S("\xC4\xA1") },
-  { S("&gcy;"), S("\xD0\xB3") },
-  { S("&gcirc;"), S("\xC4\x9D") },
-  { S("&gbreve;"), S("\xC4\x9F") },
-  { S("&gap;"), S("\xE2\xAA\x86") },
-  { S("&gammad;"), S("\xCF\x9D") },
-  { S("&gamma;"), S("\xCE\xB3") },
-  { S("&gacute;"), S("\xC7\xB5") },
-  { S("&gEl;"), S("\xE2\xAA\x8C") },
-  { S("&gE;"), S("\xE2\x89\xA7") },
-  { S("&fscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&frown;"), S("\xE2\x8C\xA2") },
-  { S("&frasl;"), S("\xE2\x81\x84") },
-  { S("&frac78;"), S("\xE2\x85\x9E") },
-  { S("&frac58;"), S("\xE2\x85\x9D") },
-  { S("&frac56;"), S("\xE2\x85\x9A") },
-  { S("&frac45;"), S("\xE2\x85\x98") },
-  { S("&frac38;"), S("\xE2\x85\x9C") },
-  { S("&frac35;"), S("\xE2\x85\x97") },
-  { S("&frac34;"), S("\xC2\xBE") },
-  { S("&frac34"), S("\xC2\xBE") },
-  { S("&frac25;"), S("\xE2\x85\x96") },
-  { S("&frac23;"), S("\xE2\x85\x94") },
-  { S("&frac18;"), S("\xE2\x85\x9B") },
-  { S("&frac16;"), S("\xE2\x85\x99") },
-  { S("&frac15;"), S("\xE2\x85\x95") },
-  { S("&frac14;"), S("\xC2\xBC") },
-  { S("&frac14"), S("\xC2\xBC") },
-  { S("&frac13;"), S("\xE2\x85\x93") },
-  { S("&frac12;"), S("\xC2\xBD") },
-  { S("&frac12"), S("\xC2\xBD") },
-  { S("&fpartint;"), S("\xE2\xA8\x8D") },
-  { S("&forkv;"), S("\xE2\xAB\x99") },
-  { S("&fork;"), S("\xE2\x8B\x94") },
-  { S("&forall;"), S("\xE2\x88\x80") },
-  { S("&fopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&fnof;"), S("\xC6\x92") },
-  { S("&fltns;"), S("\xE2\x96\xB1") },
-  { S("&fllig;"), S("\xEF\xAC\x82") },
-  { S("&flat;"), S("\xE2\x99\xAD") },
-  { S("&fjlig;"), S("\x66\x6A") },
-  { S("&filig;"), S("\xEF\xAC\x81") },
-  { S("&ffr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&ffllig;"), S("\xEF\xAC\x84") },
-  { S("&fflig;"), S("\xEF\xAC\x80") },
-  { S("&ffilig;"), S("\xEF\xAC\x83") },
-  { S("&female;"), S("\xE2\x99\x80") },
-  { S("&fcy;"), S("\xD1\x84") },
-  { S("&fallingdotseq;"), S("\xE2\x89\x92") },
-  { S("&exponentiale;"), S("\xE2\x85\x87") },
-  { S("&expectation;"), S("\xE2\x84\xB0") },
-  { S("&exist;"), S("\xE2\x88\x83") },
-  { S("&excl;"), S("\x21") },
-  { S("&euro;"), S("\xE2\x82\xAC") },
-  { S("&euml;"), S("\xC3\xAB") },
-  { S("&euml"), S("\xC3\xAB") },
-  { S("&eth;"), S("\xC3\xB0") },
-  { S("&eth"), S("\xC3\xB0") },
-  { S("&eta;"), S("\xCE\xB7") },
-  { S("&esim;"), S("\xE2\x89\x82") },
-  { S("&esdot;"), S("\xE2\x89\x90") },
-  { S("&escr;"), S("\xE2\x84\xAF") },
-  { S("&erarr;"), S("\xE2\xA5\xB1") },
-  { S("&erDot;"), S("\xE2\x89\x93") },
-  { S("&eqvparsl;"), S("\xE2\xA7\xA5") },
-  { S("&equivDD;"), S("\xE2\xA9\xB8") },
-  { S("&equiv;"), S("\xE2\x89\xA1") },
-  { S("&equest;"), S("\xE2\x89\x9F") },
-  { S("&equals;"), S("\x3D") },
-  { S("&eqslantless;"), S("\xE2\xAA\x95") },
-  { S("&eqslantgtr;"), S("\xE2\xAA\x96") },
-  { S("&eqsim;"), S("\xE2\x89\x82") },
-  { S("&eqcolon;"), S("\xE2\x89\x95") },
-  { S("&eqcirc;"), S("\xE2\x89\x96") },
-  { S("&epsiv;"), S("\xCF\xB5") },
-  { S("&epsilon;"), S("\xCE\xB5") },
-  { S("&epsi;"), S("\xCE\xB5") },
-  { S("&eplus;"), S("\xE2\xA9\xB1") },
-  { S("&eparsl;"), S("\xE2\xA7\xA3") },
-  { S("&epar;"), S("\xE2\x8B\x95") },
-  { S("&eopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&eogon;"), S("\xC4\x99") },
-  { S("&ensp;"), S("\xE2\x80\x82") },
-  { S("&eng;"), S("\xC5\x8B") },
-  { S("&emsp;"), S("\xE2\x80\x83") },
-  { S("&emsp14;"), S("\xE2\x80\x85") },
-  { S("&emsp13;"), S("\xE2\x80\x84") },
-  { S("&emptyv;"), S("\xE2\x88\x85") },
-  { S("&emptyset;"), S("\xE2\x88\x85") },
-  { S("&empty;"), S("\xE2\x88\x85") },
-  { S("&emacr;"), S("\xC4\x93") },
-  { S("&elsdot;"), S("\xE2\xAA\x97") },
-  { S("&els;"), S("\xE2\xAA\x95") },
-  { S("&ell;"), S("\xE2\x84\x93") },
-  { S("&elinters;"), S("\xE2\x8F\xA7") },
-  { S("&el;"), S("\xE2\xAA\x99") },
-  { S("&egsdot;"), S("\xE2\xAA\x98") },
-  { S("&egs;"), S("\xE2\xAA\x96") },
-  { S("&egrave;"), S("\xC3\xA8") },
-  { S("&egrave"), S("\xC3\xA8") },
-  { S("&eg;"), S("\xE2\xAA\x9A") },
-  { S("&efr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&efDot;"), S("\xE2\x89\x92") },
-  { S("&ee;"), S("\xE2\x85\x87") },
-  { S("&edot;"), S("\xC4\x97") },
-  { S("&ecy;"), S("\xD1\x8D") },
-  { S("&ecolon;"), S("\xE2\x89\x95") },
-  { S("&ecirc;"), S("\xC3\xAA") },
-  { S("&ecirc"), S("\xC3\xAA") },
-  { S("&ecir;"), S("\xE2\x89\x96") },
-  { S("&ecaron;"), S("\xC4\x9B") },
-  { S("&easter;"), S("\xE2\xA9\xAE") },
-  { S("&eacute;"), S("\xC3\xA9") },
-  { S("&eacute"), S("\xC3\xA9") },
-  { S("&eDot;"), S("\xE2\x89\x91") },
-  { S("&eDDot;"), S("\xE2\xA9\xB7") },
-  { S("&dzigrarr;"), S("\xE2\x9F\xBF") },
-  { S("&dzcy;"), S("\xD1\x9F") },
-  { S("&dwangle;"), S("\xE2\xA6\xA6") },
-  { S("&duhar;"), S("\xE2\xA5\xAF") },
-  { S("&duarr;"), S("\xE2\x87\xB5") },
-  { S("&dtrif;"), S("\xE2\x96\xBE") },
-  { S("&dtri;"), S("\xE2\x96\xBF") },
-  { S("&dtdot;"), S("\xE2\x8B\xB1") },
-  { S("&dstrok;"), S("\xC4\x91") },
-  { S("&dsol;"), S("\xE2\xA7\xB6") },
-  { S("&dscy;"), S("\xD1\x95") },
-  { S("&dscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&drcrop;"), S("\xE2\x8C\x8C") },
-  { S("&drcorn;"), S("\xE2\x8C\x9F") },
-  { S("&drbkarow;"), S("\xE2\xA4\x90") },
-  { S("&downharpoonright;"), S("\xE2\x87\x82") },
-  { S("&downharpoonleft;"), S("\xE2\x87\x83") },
-  { S("&downdownarrows;"), S("\xE2\x87\x8A") },
-  { S("&downarrow;"), S("\xE2\x86\x93") },
-  { S("&doublebarwedge;"), S("\xE2\x8C\x86") },
-  { S("&dotsquare;"), S("\xE2\x8A\xA1") },
-  { S("&dotplus;"), S("\xE2\x88\x94") },
-  { S("&dotminus;"), S("\xE2\x88\xB8") },
-  { S("&doteqdot;"), S("\xE2\x89\x91") },
-  { S("&doteq;"), S("\xE2\x89\x90") },
-  { S("&dot;"), S("\xCB\x99") },
-  { S("&dopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&dollar;"), S("\x24") },
-  { S("&dlcrop;"), S("\xE2\x8C\x8D") },
-  { S("&dlcorn;"), S("\xE2\x8C\x9E") },
-  { S("&djcy;"), S("\xD1\x92") },
-  { S("&divonx;"), S("\xE2\x8B\x87") },
-  { S("&divideontimes;"), S("\xE2\x8B\x87") },
-  { S("&divide;"), S("\xC3\xB7") },
-  { S("&divide"), S("\xC3\xB7") },
-  { S("&div;"), S("\xC3\xB7") },
-  { S("&disin;"), S("\xE2\x8B\xB2") },
-  { S("&digamma;"), S("\xCF\x9D") },
-  { S("&die;"), S("\xC2\xA8") },
-  { S("&diams;"), S("\xE2\x99\xA6") },
-  { S("&diamondsuit;"), S("\xE2\x99\xA6") },
-  { S("&diamond;"), S("\xE2\x8B\x84") },
-  { S("&diam;"), S("\xE2\x8B\x84") },
-  { S("&dharr;"), S("\xE2\x87\x82") },
-  { S("&dharl;"), S("\xE2\x87\x83") },
-  { S("&dfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&dfisht;"), S("\xE2\xA5\xBF") },
-  { S("&demptyv;"), S("\xE2\xA6\xB1") },
-  { S("&delta;"), S("\xCE\xB4") },
-  { S("&deg;"), S("\xC2\xB0") },
-  { S("&deg"), S("\xC2\xB0") },
-  { S("&ddotseq;"), S("\xE2\xA9\xB7") },
-  { S("&ddarr;"), S("\xE2\x87\x8A") },
-  { S("&ddagger;"), S("\xE2\x80\xA1") },
-  { S("&dd;"), S("\xE2\x85\x86") },
-  { S("&dcy;"), S("\xD0\xB4") },
-  { S("&dcaron;"), S("\xC4\x8F") },
-  { S("&dblac;"), S("\xCB\x9D") },
-  { S("&dbkarow;"), S("\xE2\xA4\x8F") },
-  { S("&dashv;"), S("\xE2\x8A\xA3") },
-  { S("&dash;"), S("\xE2\x80\x90") },
-  { S("&darr;"), S("\xE2\x86\x93") },
-  { S("&daleth;"), S("\xE2\x84\xB8") },
-  { S("&dagger;"), S("\xE2\x80\xA0") },
-  { S("&dHar;"), S("\xE2\xA5\xA5") },
-  { S("&dArr;"), S("\xE2\x87\x93") },
-  { S("&cylcty;"), S("\xE2\x8C\xAD") },
-  { S("&cwint;"), S("\xE2\x88\xB1") },
-  { S("&cwconint;"), S("\xE2\x88\xB2") },
-  { S("&cuwed;"), S("\xE2\x8B\x8F") },
-  { S("&cuvee;"), S("\xE2\x8B\x8E") },
-  { S("&curvearrowright;"), S("\xE2\x86\xB7") },
-  { S("&curvearrowleft;"), S("\xE2\x86\xB6") },
-  { S("&curren;"), S("\xC2\xA4") },
-  { S("&curren"), S("\xC2\xA4") },
-  { S("&curlywedge;"), S("\xE2\x8B\x8F") },
-  { S("&curlyvee;"), S("\xE2\x8B\x8E") },
-  { S("&curlyeqsucc;"), S("\xE2\x8B\x9F") },
-  { S("&curlyeqprec;"), S("\xE2\x8B\x9E") },
-  { S("&curarrm;"), S("\xE2\xA4\xBC") },
-  { S("&curarr;"), S("\xE2\x86\xB7") },
-  { S("&cups;"), S("\xE2\x88\xAA\xEF\xB8\x80") },
-  { S("&cupor;"), S("\xE2\xA9\x85") },
-  { S("&cupdot;"), S("\xE2\x8A\x8D") },
-  { S("&cupcup;"), S("\xE2\xA9\x8A") },
-  { S("&cupcap;"), S("\xE2\xA9\x86") },
-  { S("&cupbrcap;"), S("\xE2\xA9\x88") },
-  { S("&cup;"), S("\xE2\x88\xAA") },
-  { S("&cularrp;"), S("\xE2\xA4\xBD") },
-  { S("&cularr;"), S("\xE2\x86\xB6") },
-  { S("&cuesc;"), S("\xE2\x8B\x9F") },
-  { S("&cuepr;"), S("\xE2\x8B\x9E") },
-  { S("&cudarrr;"), S("\xE2\xA4\xB5") },
-  { S("&cudarrl;"), S("\xE2\xA4\xB8") },
-  { S("&ctdot;"), S("\xE2\x8B\xAF") },
-  { S("&csupe;"), S("\xE2\xAB\x92") },
-  { S("&csup;"), S("\xE2\xAB\x90") },
-  { S("&csube;"), S("\xE2\xAB\x91") },
-  { S("&csub;"), S("\xE2\xAB\x8F") },
-  { S("&cscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&cross;"), S("\xE2\x9C\x97") },
-  { S("&crarr;"), S("\xE2\x86\xB5") },
-  { S("&copysr;"), S("\xE2\x84\x97") },
-  { S("&copy;"), S("\xC2\xA9") },
-  { S("&copy"), S("\xC2\xA9") },
-  { S("&coprod;"), S("\xE2\x88\x90") },
-  { S("&copf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&conint;"), S("\xE2\x88\xAE") },
-  { S("&congdot;"), S("\xE2\xA9\xAD") },
-  { S("&cong;"), S("\xE2\x89\x85") },
-  { S("&complexes;"), S("\xE2\x84\x82") },
-  { S("&complement;"), S("\xE2\x88\x81") },
-  { S("&compfn;"), S("\xE2\x88\x98") },
-  { S("&comp;"), S("\xE2\x88\x81") },
-  { S("&commat;"), S("\x40") },
-  { S("&comma;"), S("\x2C") },
-  { S("&coloneq;"), S("\xE2\x89\x94") },
-  { S("&colone;"), S("\xE2\x89\x94") },
-  { S("&colon;"), S("\x3A") },
-  { S("&clubsuit;"), S("\xE2\x99\xA3") },
-  { S("&clubs;"), S("\xE2\x99\xA3") },
-  { S("&cirscir;"), S("\xE2\xA7\x82") },
-  { S("&cirmid;"), S("\xE2\xAB\xAF") },
-  { S("&cirfnint;"), S("\xE2\xA8\x90") },
-  { S("&cire;"), S("\xE2\x89\x97") },
-  { S("&circleddash;"), S("\xE2\x8A\x9D") },
-  { S("&circledcirc;"), S("\xE2\x8A\x9A") },
-  { S("&circledast;"), S("\xE2\x8A\x9B") },
-  { S("&circledS;"), S("\xE2\x93\x88") },
-  { S("&circledR;"), S("\xC2\xAE") },
-  { S("&circlearrowright;"), S("\xE2\x86\xBB") },
-  { S("&circlearrowleft;"), S("\xE2\x86\xBA") },
-  { S("&circeq;"), S("\xE2\x89\x97") },
-  { S("&circ;"), S("\xCB\x86") },
-  { S("&cirE;"), S("\xE2\xA7\x83") },
-  { S("&cir;"), S("\xE2\x97\x8B") },
-  { S("&chi;"), S("\xCF\x87") },
-  { S("&checkmark;"), S("\xE2\x9C\x93") },
-  { S("&check;"), S("\xE2\x9C\x93") },
-  { S("&chcy;"), S("\xD1\x87") },
-  { S("&cfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&centerdot;"), S("\xC2\xB7") },
-  { S("&cent;"), S("\xC2\xA2") },
-  { S("&cent"), S("\xC2\xA2") },
-  { S("&cemptyv;"), S("\xE2\xA6\xB2") },
-  { S("&cedil;"), S("\xC2\xB8") },
-  { S("&cedil"), S("\xC2\xB8") },
-  { S("&cdot;"), S("\xC4\x8B") },
-  { S("&ccupssm;"), S("\xE2\xA9\x90") },
-  { S("&ccups;"), S("\xE2\xA9\x8C") },
-  { S("&ccirc;"), S("\xC4\x89") },
-  { S("&ccedil;"), S("\xC3\xA7") },
-  { S("&ccedil"), S("\xC3\xA7") },
-  { S("&ccaron;"), S("\xC4\x8D") },
-  { S("&ccaps;"), S("\xE2\xA9\x8D") },
-  { S("&caron;"), S("\xCB\x87") },
-  { S("&caret;"), S("\xE2\x81\x81") },
-  { S("&caps;"), S("\xE2\x88\xA9\xEF\xB8\x80") },
-  { S("&capdot;"), S("\xE2\xA9\x80") },
-  { S("&capcup;"), S("\xE2\xA9\x87") },
-  { S("&capcap;"), S("\xE2\xA9\x8B") },
-  { S("&capbrcup;"), S("\xE2\xA9\x89") },
-  { S("&capand;"), S("\xE2\xA9\x84") },
-  { S("&cap;"), S("\xE2\x88\xA9") },
-  { S("&cacute;"), S("\xC4\x87") },
-  { S("&bumpeq;"), S("\xE2\x89\x8F") },
-  { S("&bumpe;"), S("\xE2\x89\x8F") },
-  { S("&bumpE;"), S("\xE2\xAA\xAE") },
-  { S("&bump;"), S("\xE2\x89\x8E") },
-  { S("&bullet;"), S("\xE2\x80\xA2") },
-  { S("&bull;"), S("\xE2\x80\xA2") },
-  { S("&bsolhsub;"), S("\xE2\x9F\x88") },
-  { S("&bsolb;"), S("\xE2\xA7\x85") },
-  { S("&bsol;"), S("\x5C") },
-  { S("&bsime;"), S("\xE2\x8B\x8D") },
-  { S("&bsim;"), S("\xE2\x88\xBD") },
-  { S("&bsemi;"), S("\xE2\x81\x8F") },
-  { S("&bscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&brvbar;"), S("\xC2\xA6") },
-  { S("&brvbar"), S("\xC2\xA6") },
-  { S("&breve;"), S("\xCB\x98") },
-  { S("&bprime;"), S("\xE2\x80\xB5") },
-  { S("&boxvr;"), S("\xE2\x94\x9C") },
-  { S("&boxvl;"), S("\xE2\x94\xA4") },
-  { S("&boxvh;"), S("\xE2\x94\xBC") },
-  { S("&boxvR;"), S("\xE2\x95\x9E") },
-  { S("&boxvL;"), S("\xE2\x95\xA1") },
-  { S("&boxvH;"), S("\xE2\x95\xAA") },
-  { S("&boxv;"), S("\xE2\x94\x82") },
-  { S("&boxur;"), S("\xE2\x94\x94") },
-  { S("&boxul;"), S("\xE2\x94\x98") },
-  { S("&boxuR;"), S("\xE2\x95\x98") },
-  { S("&boxuL;"), S("\xE2\x95\x9B") },
-  { S("&boxtimes;"), S("\xE2\x8A\xA0") },
-  { S("&boxplus;"), S("\xE2\x8A\x9E") },
-  { S("&boxminus;"), S("\xE2\x8A\x9F") },
-  { S("&boxhu;"), S("\xE2\x94\xB4") },
-  { S("&boxhd;"), S("\xE2\x94\xAC") },
-  { S("&boxhU;"), S("\xE2\x95\xA8") },
-  { S("&boxhD;"), S("\xE2\x95\xA5") },
-  { S("&boxh;"), S("\xE2\x94\x80") },
-  { S("&boxdr;"), S("\xE2\x94\x8C") },
-  { S("&boxdl;"), S("\xE2\x94\x90") },
-  { S("&boxdR;"), S("\xE2\x95\x92") },
-  { S("&boxdL;"), S("\xE2\x95\x95") },
-  { S("&boxbox;"), S("\xE2\xA7\x89") },
-  { S("&boxVr;"), S("\xE2\x95\x9F") },
-  { S("&boxVl;"), S("\xE2\x95\xA2") },
-  { S("&boxVh;"), S("\xE2\x95\xAB") },
-  { S("&boxVR;"), S("\xE2\x95\xA0") },
-  { S("&boxVL;"), S("\xE2\x95\xA3") },
-  { S("&boxVH;"), S("\xE2\x95\xAC") },
-  { S("&boxV;"), S("\xE2\x95\x91") },
-  { S("&boxUr;"), S("\xE2\x95\x99") },
-  { S("&boxUl;"), S("\xE2\x95\x9C") },
-  { S("&boxUR;"), S("\xE2\x95\x9A") },
-  { S("&boxUL;"), S("\xE2\x95\x9D") },
-  { S("&boxHu;"), S("\xE2\x95\xA7") },
-  { S("&boxHd;"), S("\xE2\x95\xA4") },
-  { S("&boxHU;"), S("\xE2\x95\xA9") },
-  { S("&boxHD;"), S("\xE2\x95\xA6") },
-  { S("&boxH;"), S("\xE2\x95\x90") },
-  { S("&boxDr;"), S("\xE2\x95\x93") },
-  { S("&boxDl;"), S("\xE2\x95\x96") },
-  { S("&boxDR;"), S("\xE2\x95\x94") },
-  { S("&boxDL;"), S("\xE2\x95\x97") },
-  { S("&bowtie;"), S("\xE2\x8B\x88") },
-  { S("&bottom;"), S("\xE2\x8A\xA5") },
-  { S("&bot;"), S("\xE2\x8A\xA5") },
-  { S("&bopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&bnot;"), S("\xE2\x8C\x90") },
-  { S("&bnequiv;"), S("\xE2\x89\xA1\xE2\x83\xA5") },
-  { S("&bne;"), S("\x3D\xE2\x83\xA5") },
-  { S("&block;"), S("\xE2\x96\x88") },
-  { S("&blk34;"), S("\xE2\x96\x93") },
-  { S("&blk14;"), S("\xE2\x96\x91") },
-  { S("&blk12;"), S("\xE2\x96\x92") },
-  { S("&blank;"), S("\xE2\x90\xA3") },
-  { S("&blacktriangleright;"), S("\xE2\x96\xB8") },
-  { S("&blacktriangleleft;"), S("\xE2\x97\x82") },
-  { S("&blacktriangledown;"), S("\xE2\x96\xBE") },
-  { S("&blacktriangle;"), S("\xE2\x96\xB4") },
-  { S("&blacksquare;"), S("\xE2\x96\xAA") },
-  { S("&blacklozenge;"), S("\xE2\xA7\xAB") },
-  { S("&bkarow;"), S("\xE2\xA4\x8D") },
-  { S("&bigwedge;"), S("\xE2\x8B\x80") },
-  { S("&bigvee;"), S("\xE2\x8B\x81") },
-  { S("&biguplus;"), S("\xE2\xA8\x84") },
-  { S("&bigtriangleup;"), S("\xE2\x96\xB3") },
-  { S("&bigtriangledown;"), S("\xE2\x96\xBD") },
-  { S("&bigstar;"), S("\xE2\x98\x85") },
-  { S("&bigsqcup;"), S("\xE2\xA8\x86") },
-  { S("&bigotimes;"), S("\xE2\xA8\x82") },
-  { S("&bigoplus;"), S("\xE2\xA8\x81") },
-  { S("&bigodot;"), S("\xE2\xA8\x80") },
-  { S("&bigcup;"), S("\xE2\x8B\x83") },
-  { S("&bigcirc;"), S("\xE2\x97\xAF") },
-  { S("&bigcap;"), S("\xE2\x8B\x82") },
-  { S("&bfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&between;"), S("\xE2\x89\xAC") },
-  { S("&beth;"), S("\xE2\x84\xB6") },
-  { S("&beta;"), S("\xCE\xB2") },
-  { S("&bernou;"), S("\xE2\x84\xAC") },
-  { S("&bepsi;"), S("\xCF\xB6") },
-  { S("&bemptyv;"), S("\xE2\xA6\xB0") },
-  { S("&because;"), S("\xE2\x88\xB5") },
-  { S("&becaus;"), S("\xE2\x88\xB5") },
-  { S("&bdquo;"), S("\xE2\x80\x9E") },
-  { S("&bcy;"), S("\xD0\xB1") },
-  { S("&bcong;"), S("\xE2\x89\x8C") },
-  { S("&bbrktbrk;"), S("\xE2\x8E\xB6") },
-  { S("&bbrk;"), S("\xE2\x8E\xB5") },
-  { S("&barwedge;"), S("\xE2\x8C\x85") },
-  { S("&barwed;"), S("\xE2\x8C\x85") },
-  { S("&barvee;"), S("\xE2\x8A\xBD") },
-  { S("&backsimeq;"), S("\xE2\x8B\x8D") },
-  { S("&backsim;"), S("\xE2\x88\xBD") },
-  { S("&backprime;"), S("\xE2\x80\xB5") },
-  { S("&backepsilon;"), S("\xCF\xB6") },
-  { S("&backcong;"), S("\xE2\x89\x8C") },
-  { S("&bNot;"), S("\xE2\xAB\xAD") },
-  { S("&awint;"), S("\xE2\xA8\x91") },
-  { S("&awconint;"), S("\xE2\x88\xB3") },
-  { S("&auml;"), S("\xC3\xA4") },
-  { S("&auml"), S("\xC3\xA4") },
-  { S("&atilde;"), S("\xC3\xA3") },
-  { S("&atilde"), S("\xC3\xA3") },
-  { S("&asympeq;"), S("\xE2\x89\x8D") },
-  { S("&asymp;"), S("\xE2\x89\x88") },
-  { S("&ast;"), S("\x2A") },
-  { S("&ascr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&aring;"), S("\xC3\xA5") },
-  { S("&aring"), S("\xC3\xA5") },
-  { S("&approxeq;"), S("\xE2\x89\x8A") },
-  { S("&approx;"), S("\xE2\x89\x88") },
-  { S("&apos;"), S("\x27") },
-  { S("&apid;"), S("\xE2\x89\x8B") },
-  { S("&ape;"), S("\xE2\x89\x8A") },
-  { S("&apacir;"), S("\xE2\xA9\xAF") },
-  { S("&apE;"), S("\xE2\xA9\xB0") },
-  { S("&ap;"), S("\xE2\x89\x88") },
-  { S("&aopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&aogon;"), S("\xC4\x85") },
-  { S("&angzarr;"), S("\xE2\x8D\xBC") },
-  { S("&angst;"), S("\xC3\x85") },
-  { S("&angsph;"), S("\xE2\x88\xA2") },
-  { S("&angrtvbd;"), S("\xE2\xA6\x9D") },
-  { S("&angrtvb;"), S("\xE2\x8A\xBE") },
-  { S("&angrt;"), S("\xE2\x88\x9F") },
-  { S("&angmsdah;"), S("\xE2\xA6\xAF") },
-  { S("&angmsdag;"), S("\xE2\xA6\xAE") },
-  { S("&angmsdaf;"), S("\xE2\xA6\xAD") },
-  { S("&angmsdae;"), S("\xE2\xA6\xAC") },
-  { S("&angmsdad;"), S("\xE2\xA6\xAB") },
-  { S("&angmsdac;"), S("\xE2\xA6\xAA") },
-  { S("&angmsdab;"), S("\xE2\xA6\xA9") },
-  { S("&angmsdaa;"), S("\xE2\xA6\xA8") },
-  { S("&angmsd;"), S("\xE2\x88\xA1") },
-  { S("&angle;"), S("\xE2\x88\xA0") },
-  { S("&ange;"), S("\xE2\xA6\xA4") },
-  { S("&ang;"), S("\xE2\x88\xA0") },
-  { S("&andv;"), S("\xE2\xA9\x9A") },
-  { S("&andslope;"), S("\xE2\xA9\x98") },
-  { S("&andd;"), S("\xE2\xA9\x9C") },
-  { S("&andand;"), S("\xE2\xA9\x95") },
-  { S("&and;"), S("\xE2\x88\xA7") },
-  { S("&amp;"), S("\x26") },
-  { S("&amp"), S("\x26") },
-  { S("&amalg;"), S("\xE2\xA8\xBF") },
-  { S("&amacr;"), S("\xC4\x81") },
-  { S("&alpha;"), S("\xCE\xB1") },
-  { S("&aleph;"), S("\xE2\x84\xB5") },
-  { S("&alefsym;"), S("\xE2\x84\xB5") },
-  { S("&agrave;"), S("\xC3\xA0") },
-  { S("&agrave"), S("\xC3\xA0") },
-  { S("&afr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&af;"), S("\xE2\x81\xA1") },
-  { S("&aelig;"), S("\xC3\xA6") },
-  { S("&aelig"), S("\xC3\xA6") },
-  { S("&acy;"), S("\xD0\xB0") },
-  { S("&acute;"), S("\xC2\xB4") },
-  { S("&acute"), S("\xC2\xB4") },
-  { S("&acirc;"), S("\xC3\xA2") },
-  { S("&acirc"), S("\xC3\xA2") },
-  { S("&acd;"), S("\xE2\x88\xBF") },
-  { S("&acE;"), S("\xE2\x88\xBE\xCC\xB3") },
-  { S("&ac;"), S("\xE2\x88\xBE") },
-  { S("&abreve;"), S("\xC4\x83") },
-  { S("&aacute;"), S("\xC3\xA1") },
-  { S("&aacute"), S("\xC3\xA1") },
-  { S("&Zscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Zopf;"), S("\xE2\x84\xA4") },
-  { S("&Zfr;"), S("\xE2\x84\xA8") },
-  { S("&Zeta;"), S("\xCE\x96") },
-  { S("&ZeroWidthSpace;"), S("\xE2\x80\x8B") },
-  { S("&Zdot;"), S("\xC5\xBB") },
-  { S("&Zcy;"), S("\xD0\x97") },
-  { S("&Zcaron;"), S("\xC5\xBD") },
-  { S("&Zacute;"), S("\xC5\xB9") },
-  { S("&ZHcy;"), S("\xD0\x96") },
-  { S("&Yuml;"), S("\xC5\xB8") },
-  { S("&Yscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Yopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Yfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Ycy;"), S("\xD0\xAB") },
-  { S("&Ycirc;"), S("\xC5\xB6") },
-  { S("&Yacute;"), S("\xC3\x9D") },
-  { S("&Yacute"), S("\xC3\x9D") },
-  { S("&YUcy;"), S("\xD0\xAE") },
-  { S("&YIcy;"), S("\xD0\x87") },
-  { S("&YAcy;"), S("\xD0\xAF") },
-  { S("&Xscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Xopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Xi;"), S("\xCE\x9E") },
-  { S("&Xfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Wscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Wopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Wfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Wedge;"), S("\xE2\x8B\x80") },
-  { S("&Wcirc;"), S("\xC5\xB4") },
-  { S("&Vvdash;"), S("\xE2\x8A\xAA") },
-  { S("&Vscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Vopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Vfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&VeryThinSpace;"), S("\xE2\x80\x8A") },
-  { S("&VerticalTilde;"), S("\xE2\x89\x80") },
-  { S("&VerticalSeparator;"), S("\xE2\x9D\x98") },
-  { S("&VerticalLine;"), S("\x7C") },
-  { S("&VerticalBar;"), S("\xE2\x88\xA3") },
-  { S("&Vert;"), S("\xE2\x80\x96") },
-  { S("&Verbar;"), S("\xE2\x80\x96") },
-  { S("&Vee;"), S("\xE2\x8B\x81") },
-  { S("&Vdashl;"), S("\xE2\xAB\xA6") },
-  { S("&Vdash;"), S("\xE2\x8A\xA9") },
-  { S("&Vcy;"), S("\xD0\x92") },
-  { S("&Vbar;"), S("\xE2\xAB\xAB") },
-  { S("&VDash;"), S("\xE2\x8A\xAB") },
-  { S("&Uuml;"), S("\xC3\x9C") },
-  { S("&Uuml"), S("\xC3\x9C") },
-  { S("&Utilde;"), S("\xC5\xA8") },
-  { S("&Uscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Uring;"), S("\xC5\xAE") },
-  { S("&Upsilon;"), S("\xCE\xA5") },
-  { S("&Upsi;"), S("\xCF\x92") },
-  { S("&UpperRightArrow;"), S("\xE2\x86\x97") },
-  { S("&UpperLeftArrow;"), S("\xE2\x86\x96") },
-  { S("&Updownarrow;"), S("\xE2\x87\x95") },
-  { S("&Uparrow;"), S("\xE2\x87\x91") },
-  { S("&UpTeeArrow;"), S("\xE2\x86\xA5") },
-  { S("&UpTee;"), S("\xE2\x8A\xA5") },
-  { S("&UpEquilibrium;"), S("\xE2\xA5\xAE") },
-  { S("&UpDownArrow;"), S("\xE2\x86\x95") },
-  { S("&UpArrowDownArrow;"), S("\xE2\x87\x85") },
-  { S("&UpArrowBar;"), S("\xE2\xA4\x92") },
-  { S("&UpArrow;"), S("\xE2\x86\x91") },
-  { S("&Uopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Uogon;"), S("\xC5\xB2") },
-  { S("&UnionPlus;"), S("\xE2\x8A\x8E") },
-  { S("&Union;"), S("\xE2\x8B\x83") },
-  { S("&UnderParenthesis;"), S("\xE2\x8F\x9D") },
-  { S("&UnderBracket;"), S("\xE2\x8E\xB5") },
-  { S("&UnderBrace;"), S("\xE2\x8F\x9F") },
-  { S("&UnderBar;"), S("\x5F") },
-  { S("&Umacr;"), S("\xC5\xAA") },
-  { S("&Ugrave;"), S("\xC3\x99") },
-  { S("&Ugrave"), S("\xC3\x99") },
-  { S("&Ufr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Udblac;"), S("\xC5\xB0") },
-  { S("&Ucy;"), S("\xD0\xA3") },
-  { S("&Ucirc;"), S("\xC3\x9B") },
-  { S("&Ucirc"), S("\xC3\x9B") },
-  { S("&Ubreve;"), S("\xC5\xAC") },
-  { S("&Ubrcy;"), S("\xD0\x8E") },
-  { S("&Uarrocir;"), S("\xE2\xA5\x89") },
-  { S("&Uarr;"), S("\xE2\x86\x9F") },
-  { S("&Uacute;"), S("\xC3\x9A") },
-  { S("&Uacute"), S("\xC3\x9A") },
-  { S("&Tstrok;"), S("\xC5\xA6") },
-  { S("&Tscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&TripleDot;"), S("\xE2\x83\x9B") },
-  { S("&Topf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&TildeTilde;"), S("\xE2\x89\x88") },
-  { S("&TildeFullEqual;"), S("\xE2\x89\x85") },
-  { S("&TildeEqual;"), S("\xE2\x89\x83") },
-  { S("&Tilde;"), S("\xE2\x88\xBC") },
-  { S("&ThinSpace;"), S("\xE2\x80\x89") },
-  { S("&ThickSpace;"), S("\xE2\x81\x9F\xE2\x80\x8A") },
-  { S("&Theta;"), S("\xCE\x98") },
-  { S("&Therefore;"), S("\xE2\x88\xB4") },
-  { S("&Tfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Tcy;"), S("\xD0\xA2") },
-  { S("&Tcedil;"), S("\xC5\xA2") },
-  { S("&Tcaron;"), S("\xC5\xA4") },
-  { S("&Tau;"), S("\xCE\xA4") },
-  { S("&Tab;"), S("\x09") },
-  { S("&TScy;"), S("\xD0\xA6") },
-  { S("&TSHcy;"), S("\xD0\x8B") },
-  { S("&TRADE;"), S("\xE2\x84\xA2") },
-  { S("&THORN;"), S("\xC3\x9E") },
-  { S("&THORN"), S("\xC3\x9E") },
-  { S("&Supset;"), S("\xE2\x8B\x91") },
-  { S("&SupersetEqual;"), S("\xE2\x8A\x87") },
-  { S("&Superset;"), S("\xE2\x8A\x83") },
-  { S("&Sup;"), S("\xE2\x8B\x91") },
-  { S("&Sum;"), S("\xE2\x88\x91") },
-  { S("&SuchThat;"), S("\xE2\x88\x8B") },
-  { S("&SucceedsTilde;"), S("\xE2\x89\xBF") },
-  { S("&SucceedsSlantEqual;"), S("\xE2\x89\xBD") },
-  { S("&SucceedsEqual;"), S("\xE2\xAA\xB0") },
-  { S("&Succeeds;"), S("\xE2\x89\xBB") },
-  { S("&SubsetEqual;"), S("\xE2\x8A\x86") },
-  { S("&Subset;"), S("\xE2\x8B\x90") },
-  { S("&Sub;"), S("\xE2\x8B\x90") },
-  { S("&Star;"), S("\xE2\x8B\x86") },
-  { S("&Sscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&SquareUnion;"), S("\xE2\x8A\x94") },
-  { S("&SquareSupersetEqual;"), S("\xE2\x8A\x92") },
-  { S("&SquareSuperset;"), S("\xE2\x8A\x90") },
-  { S("&SquareSubsetEqual;"), S("\xE2\x8A\x91") },
-  { S("&SquareSubset;"), S("\xE2\x8A\x8F") },
-  { S("&SquareIntersection;"), S("\xE2\x8A\x93") },
-  { S("&Square;"), S("\xE2\x96\xA1") },
-  { S("&Sqrt;"), S("\xE2\x88\x9A") },
-  { S("&Sopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&SmallCircle;"), S("\xE2\x88\x98") },
-  { S("&Sigma;"), S("\xCE\xA3") },
-  { S("&ShortUpArrow;"), S("\xE2\x86\x91") },
-  { S("&ShortRightArrow;"), S("\xE2\x86\x92") },
-  { S("&ShortLeftArrow;"), S("\xE2\x86\x90") },
-  { S("&ShortDownArrow;"), S("\xE2\x86\x93") },
-  { S("&Sfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Scy;"), S("\xD0\xA1") },
-  { S("&Scirc;"), S("\xC5\x9C") },
-  { S("&Scedil;"), S("\xC5\x9E") },
-  { S("&Scaron;"), S("\xC5\xA0") },
-  { S("&Sc;"), S("\xE2\xAA\xBC") },
-  { S("&Sacute;"), S("\xC5\x9A") },
-  { S("&SOFTcy;"), S("\xD0\xAC") },
-  { S("&SHcy;"), S("\xD0\xA8") },
-  { S("&SHCHcy;"), S("\xD0\xA9") },
-  { S("&RuleDelayed;"), S("\xE2\xA7\xB4") },
-  { S("&Rsh;"), S("\xE2\x86\xB1") },
-  { S("&Rscr;"), S("\xE2\x84\x9B") },
-  { S("&Rrightarrow;"), S("\xE2\x87\x9B") },
-  { S("&RoundImplies;"), S("\xE2\xA5\xB0") },
-  { S("&Ropf;"), S("\xE2\x84\x9D") },
-  { S("&Rightarrow;"), S("\xE2\x87\x92") },
-  { S("&RightVectorBar;"), S("\xE2\xA5\x93") },
-  { S("&RightVector;"), S("\xE2\x87\x80") },
-  { S("&RightUpVectorBar;"), S("\xE2\xA5\x94") },
-  { S("&RightUpVector;"), S("\xE2\x86\xBE") },
-  { S("&RightUpTeeVector;"), S("\xE2\xA5\x9C") },
-  { S("&RightUpDownVector;"), S("\xE2\xA5\x8F") },
-  { S("&RightTriangleEqual;"), S("\xE2\x8A\xB5") },
-  { S("&RightTriangleBar;"), S("\xE2\xA7\x90") },
-  { S("&RightTriangle;"), S("\xE2\x8A\xB3") },
-  { S("&RightTeeVector;"), S("\xE2\xA5\x9B") },
-  { S("&RightTeeArrow;"), S("\xE2\x86\xA6") },
-  { S("&RightTee;"), S("\xE2\x8A\xA2") },
-  { S("&RightFloor;"), S("\xE2\x8C\x8B") },
-  { S("&RightDownVectorBar;"), S("\xE2\xA5\x95") },
-  { S("&RightDownVector;"), S("\xE2\x87\x82") },
-  { S("&RightDownTeeVector;"), S("\xE2\xA5\x9D") },
-  { S("&RightDoubleBracket;"), S("\xE2\x9F\xA7") },
-  { S("&RightCeiling;"), S("\xE2\x8C\x89") },
-  { S("&RightArrowLeftArrow;"), S("\xE2\x87\x84") },
-  { S("&RightArrowBar;"), S("\xE2\x87\xA5") },
-  { S("&RightArrow;"), S("\xE2\x86\x92") },
-  { S("&RightAngleBracket;"), S("\xE2\x9F\xA9") },
-  { S("&Rho;"), S("\xCE\xA1") },
-  { S("&Rfr;"), S("\xE2\x84\x9C") },
-  { S("&ReverseUpEquilibrium;"), S("\xE2\xA5\xAF") },
-  { S("&ReverseEquilibrium;"), S("\xE2\x87\x8B") },
-  { S("&ReverseElement;"), S("\xE2\x88\x8B") },
-  { S("&Re;"), S("\xE2\x84\x9C") },
-  { S("&Rcy;"), S("\xD0\xA0") },
-  { S("&Rcedil;"), S("\xC5\x96") },
-  { S("&Rcaron;"), S("\xC5\x98") },
-  { S("&Rarrtl;"), S("\xE2\xA4\x96") },
-  { S("&Rarr;"), S("\xE2\x86\xA0") },
-  { S("&Rang;"), S("\xE2\x9F\xAB") },
-  { S("&Racute;"), S("\xC5\x94") },
-  { S("&REG;"), S("\xC2\xAE") },
-  { S("&REG"), S("\xC2\xAE") },
-  { S("&RBarr;"), S("\xE2\xA4\x90") },
-  { S("&Qscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Qopf;"), S("\xE2\x84\x9A") },
-  { S("&Qfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&QUOT;"), S("\x22") },
-  { S("&QUOT"), S("\x22") },
-  { S("&Psi;"), S("\xCE\xA8") },
-  { S("&Pscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Proportional;"), S("\xE2\x88\x9D") },
-  { S("&Proportion;"), S("\xE2\x88\xB7") },
-  { S("&Product;"), S("\xE2\x88\x8F") },
-  { S("&Prime;"), S("\xE2\x80\xB3") },
-  { S("&PrecedesTilde;"), S("\xE2\x89\xBE") },
-  { S("&PrecedesSlantEqual;"), S("\xE2\x89\xBC") },
-  { S("&PrecedesEqual;"), S("\xE2\xAA\xAF") },
-  { S("&Precedes;"), S("\xE2\x89\xBA") },
-  { S("&Pr;"), S("\xE2\xAA\xBB") },
-  { S("&Popf;"), S("\xE2\x84\x99") },
-  { S("&Poincareplane;"), S("\xE2\x84\x8C") },
-  { S("&PlusMinus;"), S("\xC2\xB1") },
-  { S("&Pi;"), S("\xCE\xA0") },
-  { S("&Phi;"), S("\xCE\xA6") },
-  { S("&Pfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Pcy;"), S("\xD0\x9F") },
-  { S("&PartialD;"), S("\xE2\x88\x82") },
-  { S("&OverParenthesis;"), S("\xE2\x8F\x9C") },
-  { S("&OverBracket;"), S("\xE2\x8E\xB4") },
-  { S("&OverBrace;"), S("\xE2\x8F\x9E") },
-  { S("&OverBar;"), S("\xE2\x80\xBE") },
-  { S("&Ouml;"), S("\xC3\x96") },
-  { S("&Ouml"), S("\xC3\x96") },
-  { S("&Otimes;"), S("\xE2\xA8\xB7") },
-  { S("&Otilde;"), S("\xC3\x95") },
-  { S("&Otilde"), S("\xC3\x95") },
-  { S("&Oslash;"), S("\xC3\x98") },
-  { S("&Oslash"), S("\xC3\x98") },
-  { S("&Oscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Or;"), S("\xE2\xA9\x94") },
-  { S("&OpenCurlyQuote;"), S("\xE2\x80\x98") },
-  { S("&OpenCurlyDoubleQuote;"), S("\xE2\x80\x9C") },
-  { S("&Oopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Omicron;"), S("\xCE\x9F") },
-  { S("&Omega;"), S("\xCE\xA9") },
-  { S("&Omacr;"), S("\xC5\x8C") },
-  { S("&Ograve;"), S("\xC3\x92") },
-  { S("&Ograve"), S("\xC3\x92") },
-  { S("&Ofr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Odblac;"), S("\xC5\x90") },
-  { S("&Ocy;"), S("\xD0\x9E") },
-  { S("&Ocirc;"), S("\xC3\x94") },
-  { S("&Ocirc"), S("\xC3\x94") },
-  { S("&Oacute;"), S("\xC3\x93") },
-  { S("&Oacute"), S("\xC3\x93") },
-  { S("&OElig;"), S("\xC5\x92") },
-  { S("&Nu;"), S("\xCE\x9D") },
-  { S("&Ntilde;"), S("\xC3\x91") },
-  { S("&Ntilde"), S("\xC3\x91") },
-  { S("&Nscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&NotVerticalBar;"), S("\xE2\x88\xA4") },
-  { S("&NotTildeTilde;"), S("\xE2\x89\x89") },
-  { S("&NotTildeFullEqual;"), S("\xE2\x89\x87") },
-  { S("&NotTildeEqual;"), S("\xE2\x89\x84") },
-  { S("&NotTilde;"), S("\xE2\x89\x81") },
-  { S("&NotSupersetEqual;"), S("\xE2\x8A\x89") },
-  { S("&NotSuperset;"), S("\xE2\x8A\x83\xE2\x83\x92") },
-  { S("&NotSucceedsTilde;"), S("\xE2\x89\xBF\xCC\xB8") },
-  { S("&NotSucceedsSlantEqual;"), S("\xE2\x8B\xA1") },
-  { S("&NotSucceedsEqual;"), S("\xE2\xAA\xB0\xCC\xB8") },
-  { S("&NotSucceeds;"), S("\xE2\x8A\x81") },
-  { S("&NotSubsetEqual;"), S("\xE2\x8A\x88") },
-  { S("&NotSubset;"), S("\xE2\x8A\x82\xE2\x83\x92") },
-  { S("&NotSquareSupersetEqual;"), S("\xE2\x8B\xA3") },
-  { S("&NotSquareSuperset;"), S("\xE2\x8A\x90\xCC\xB8") },
-  { S("&NotSquareSubsetEqual;"), S("\xE2\x8B\xA2") },
-  { S("&NotSquareSubset;"), S("\xE2\x8A\x8F\xCC\xB8") },
-  { S("&NotRightTriangleEqual;"), S("\xE2\x8B\xAD") },
-  { S("&NotRightTriangleBar;"), S("\xE2\xA7\x90\xCC\xB8") },
-  { S("&NotRightTriangle;"), S("\xE2\x8B\xAB") },
-  { S("&NotReverseElement;"), S("\xE2\x88\x8C") },
-  { S("&NotPrecedesSlantEqual;"), S("\xE2\x8B\xA0") },
-  { S("&NotPrecedesEqual;"), S("\xE2\xAA\xAF\xCC\xB8") },
-  { S("&NotPrecedes;"), S("\xE2\x8A\x80") },
-  { S("&NotNestedLessLess;"), S("\xE2\xAA\xA1\xCC\xB8") },
-  { S("&NotNestedGreaterGreater;"), S("\xE2\xAA\xA2\xCC\xB8") },
-  { S("&NotLessTilde;"), S("\xE2\x89\xB4") },
-  { S("&NotLessSlantEqual;"), S("\xE2\xA9\xBD\xCC\xB8") },
-  { S("&NotLessLess;"), S("\xE2\x89\xAA\xCC\xB8") },
-  { S("&NotLessGreater;"), S("\xE2\x89\xB8") },
-  { S("&NotLessEqual;"), S("\xE2\x89\xB0") },
-  { S("&NotLess;"), S("\xE2\x89\xAE") },
-  { S("&NotLeftTriangleEqual;"), S("\xE2\x8B\xAC") },
-  { S("&NotLeftTriangleBar;"), S("\xE2\xA7\x8F\xCC\xB8") },
-  { S("&NotLeftTriangle;"), S("\xE2\x8B\xAA") },
-  { S("&NotHumpEqual;"), S("\xE2\x89\x8F\xCC\xB8") },
-  { S("&NotHumpDownHump;"), S("\xE2\x89\x8E\xCC\xB8") },
-  { S("&NotGreaterTilde;"), S("\xE2\x89\xB5") },
-  { S("&NotGreaterSlantEqual;"), S("\xE2\xA9\xBE\xCC\xB8") },
-  { S("&NotGreaterLess;"), S("\xE2\x89\xB9") },
-  { S("&NotGreaterGreater;"), S("\xE2\x89\xAB\xCC\xB8") },
-  { S("&NotGreaterFullEqual;"), S("\xE2\x89\xA7\xCC\xB8") },
-  { S("&NotGreaterEqual;"), S("\xE2\x89\xB1") },
-  { S("&NotGreater;"), S("\xE2\x89\xAF") },
-  { S("&NotExists;"), S("\xE2\x88\x84") },
-  { S("&NotEqualTilde;"), S("\xE2\x89\x82\xCC\xB8") },
-  { S("&NotEqual;"), S("\xE2\x89\xA0") },
-  { S("&NotElement;"), S("\xE2\x88\x89") },
-  { S("&NotDoubleVerticalBar;"), S("\xE2\x88\xA6") },
-  { S("&NotCupCap;"), S("\xE2\x89\xAD") },
-  { S("&NotCongruent;"), S("\xE2\x89\xA2") },
-  { S("&Not;"), S("\xE2\xAB\xAC") },
-  { S("&Nopf;"), S("\xE2\x84\x95") },
-  { S("&NonBreakingSpace;"), S("\xC2\xA0") },
-  { S("&NoBreak;"), S("\xE2\x81\xA0") },
-  { S("&Nfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&NewLine;"), S("\x0A") },
-  { S("&NestedLessLess;"), S("\xE2\x89\xAA") },
-  { S("&NestedGreaterGreater;"), S("\xE2\x89\xAB") },
-  { S("&NegativeVeryThinSpace;"), S("\xE2\x80\x8B") },
-  { S("&NegativeThinSpace;"), S("\xE2\x80\x8B") },
-  { S("&NegativeThickSpace;"), S("\xE2\x80\x8B") },
-  { S("&NegativeMediumSpace;"), S("\xE2\x80\x8B") },
-  { S("&Ncy;"), S("\xD0\x9D") },
-  { S("&Ncedil;"), S("\xC5\x85") },
-  { S("&Ncaron;"), S("\xC5\x87") },
-  { S("&Nacute;"), S("\xC5\x83") },
-  { S("&NJcy;"), S("\xD0\x8A") },
-  { S("&Mu;"), S("\xCE\x9C") },
-  { S("&Mscr;"), S("\xE2\x84\xB3") },
-  { S("&Mopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&MinusPlus;"), S("\xE2\x88\x93") },
-  { S("&Mfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Mellintrf;"), S("\xE2\x84\xB3") },
-  { S("&MediumSpace;"), S("\xE2\x81\x9F") },
-  { S("&Mcy;"), S("\xD0\x9C") },
-  { S("&Map;"), S("\xE2\xA4\x85") },
-  { S("&Lt;"), S("\xE2\x89\xAA") },
-  { S("&Lstrok;"), S("\xC5\x81") },
-  { S("&Lsh;"), S("\xE2\x86\xB0") },
-  { S("&Lscr;"), S("\xE2\x84\x92") },
-  { S("&LowerRightArrow;"), S("\xE2\x86\x98") },
-  { S("&LowerLeftArrow;"), S("\xE2\x86\x99") },
-  { S("&Lopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Longrightarrow;"), S("\xE2\x9F\xB9") },
-  { S("&Longleftrightarrow;"), S("\xE2\x9F\xBA") },
-  { S("&Longleftarrow;"), S("\xE2\x9F\xB8") },
-  { S("&LongRightArrow;"), S("\xE2\x9F\xB6") },
-  { S("&LongLeftRightArrow;"), S("\xE2\x9F\xB7") },
-  { S("&LongLeftArrow;"), S("\xE2\x9F\xB5") },
-  { S("&Lmidot;"), S("\xC4\xBF") },
-  { S("&Lleftarrow;"), S("\xE2\x87\x9A") },
-  { S("&Ll;"), S("\xE2\x8B\x98") },
-  { S("&Lfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&LessTilde;"), S("\xE2\x89\xB2") },
-  { S("&LessSlantEqual;"), S("\xE2\xA9\xBD") },
-  { S("&LessLess;"), S("\xE2\xAA\xA1") },
-  { S("&LessGreater;"), S("\xE2\x89\xB6") },
-  { S("&LessFullEqual;"), S("\xE2\x89\xA6") },
-  { S("&LessEqualGreater;"), S("\xE2\x8B\x9A") },
-  { S("&Leftrightarrow;"), S("\xE2\x87\x94") },
-  { S("&Leftarrow;"), S("\xE2\x87\x90") },
-  { S("&LeftVectorBar;"), S("\xE2\xA5\x92") },
-  { S("&LeftVector;"), S("\xE2\x86\xBC") },
-  { S("&LeftUpVectorBar;"), S("\xE2\xA5\x98") },
-  { S("&LeftUpVector;"), S("\xE2\x86\xBF") },
-  { S("&LeftUpTeeVector;"), S("\xE2\xA5\xA0") },
-  { S("&LeftUpDownVector;"), S("\xE2\xA5\x91") },
-  { S("&LeftTriangleEqual;"), S("\xE2\x8A\xB4") },
-  { S("&LeftTriangleBar;"), S("\xE2\xA7\x8F") },
-  { S("&LeftTriangle;"), S("\xE2\x8A\xB2") },
-  { S("&LeftTeeVector;"), S("\xE2\xA5\x9A") },
-  { S("&LeftTeeArrow;"), S("\xE2\x86\xA4") },
-  { S("&LeftTee;"), S("\xE2\x8A\xA3") },
-  { S("&LeftRightVector;"), S("\xE2\xA5\x8E") },
-  { S("&LeftRightArrow;"), S("\xE2\x86\x94") },
-  { S("&LeftFloor;"), S("\xE2\x8C\x8A") },
-  { S("&LeftDownVectorBar;"), S("\xE2\xA5\x99") },
-  { S("&LeftDownVector;"), S("\xE2\x87\x83") },
-  { S("&LeftDownTeeVector;"), S("\xE2\xA5\xA1") },
-  { S("&LeftDoubleBracket;"), S("\xE2\x9F\xA6") },
-  { S("&LeftCeiling;"), S("\xE2\x8C\x88") },
-  { S("&LeftArrowRightArrow;"), S("\xE2\x87\x86") },
-  { S("&LeftArrowBar;"), S("\xE2\x87\xA4") },
-  { S("&LeftArrow;"), S("\xE2\x86\x90") },
-  { S("&LeftAngleBracket;"), S("\xE2\x9F\xA8") },
-  { S("&Lcy;"), S("\xD0\x9B") },
-  { S("&Lcedil;"), S("\xC4\xBB") },
-  { S("&Lcaron;"), S("\xC4\xBD") },
-  { S("&Larr;"), S("\xE2\x86\x9E") },
-  { S("&Laplacetrf;"), S("\xE2\x84\x92") },
-  { S("&Lang;"), S("\xE2\x9F\xAA") },
-  { S("&Lambda;"), S("\xCE\x9B") },
-  { S("&Lacute;"), S("\xC4\xB9") },
-  { S("&LT;"), S("\x3C") },
-  { S("&LT"), S("\x3C") },
-  { S("&LJcy;"), S("\xD0\x89") },
-  { S("&Kscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Kopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Kfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Kcy;"), S("\xD0\x9A") },
-  { S("&Kcedil;"), S("\xC4\xB6") },
-  { S("&Kappa;"), S("\xCE\x9A") },
-  { S("&KJcy;"), S("\xD0\x8C") },
-  { S("&KHcy;"), S("\xD0\xA5") },
-  { S("&Jukcy;"), S("\xD0\x84") },
-  { S("&Jsercy;"), S("\xD0\x88") },
-  { S("&Jscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Jopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Jfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Jcy;"), S("\xD0\x99") },
-  { S("&Jcirc;"), S("\xC4\xB4") },
-  { S("&Iuml;"), S("\xC3\x8F") },
-  { S("&Iuml"), S("\xC3\x8F") },
-  { S("&Iukcy;"), S("\xD0\x86") },
-  { S("&Itilde;"), S("\xC4\xA8") },
-  { S("&Iscr;"), S("\xE2\x84\x90") },
-  { S("&Iota;"), S("\xCE\x99") },
-  { S("&Iopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Iogon;"), S("\xC4\xAE") },
-  { S("&InvisibleTimes;"), S("\xE2\x81\xA2") },
-  { S("&InvisibleComma;"), S("\xE2\x81\xA3") },
-  { S("&Intersection;"), S("\xE2\x8B\x82") },
-  { S("&Integral;"), S("\xE2\x88\xAB") },
-  { S("&Int;"), S("\xE2\x88\xAC") },
-  { S("&Implies;"), S("\xE2\x87\x92") },
-  { S("&ImaginaryI;"), S("\xE2\x85\x88") },
-  { S("&Imacr;"), S("\xC4\xAA") },
-  { S("&Im;"), S("\xE2\x84\x91") },
-  { S("&Igrave;"), S("\xC3\x8C") },
-  { S("&Igrave"), S("\xC3\x8C") },
-  { S("&Ifr;"), S("\xE2\x84\x91") },
-  { S("&Idot;"), S("\xC4\xB0") },
-  { S("&Icy;"), S("\xD0\x98") },
-  { S("&Icirc;"), S("\xC3\x8E") },
-  { S("&Icirc"), S("\xC3\x8E") },
-  { S("&Iacute;"), S("\xC3\x8D") },
-  { S("&Iacute"), S("\xC3\x8D") },
-  { S("&IOcy;"), S("\xD0\x81") },
-  { S("&IJlig;"), S("\xC4\xB2") },
-  { S("&IEcy;"), S("\xD0\x95") },
-  { S("&HumpEqual;"), S("\xE2\x89\x8F") },
-  { S("&HumpDownHump;"), S("\xE2\x89\x8E") },
-  { S("&Hstrok;"), S("\xC4\xA6") },
-  { S("&Hscr;"), S("\xE2\x84\x8B") },
-  { S("&HorizontalLine;"), S("\xE2\x94\x80") },
-  { S("&Hopf;"), S("\xE2\x84\x8D") },
-  { S("&HilbertSpace;"), S("\xE2\x84\x8B") },
-  { S("&Hfr;"), S("\xE2\x84\x8C") },
-  { S("&Hcirc;"), S("\xC4\xA4") },
-  { S("&Hat;"), S("\x5E") },
-  { S("&Hacek;"), S("\xCB\x87") },
-  { S("&HARDcy;"), S("\xD0\xAA") },
-  { S("&Gt;"), S("\xE2\x89\xAB") },
-  { S("&Gscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&GreaterTilde;"), S("\xE2\x89\xB3") },
-  { S("&GreaterSlantEqual;"), S("\xE2\xA9\xBE") },
-  { S("&GreaterLess;"), S("\xE2\x89\xB7") },
-  { S("&GreaterGreater;"), S("\xE2\xAA\xA2") },
-  { S("&GreaterFullEqual;"), S("\xE2\x89\xA7") },
-  { S("&GreaterEqualLess;"), S("\xE2\x8B\x9B") },
-  { S("&GreaterEqual;"), S("\xE2\x89\xA5") },
-  { S("&Gopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Gg;"), S("\xE2\x8B\x99") },
-  { S("&Gfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Gdot;"), S("\xC4\xA0") },
-  { S("&Gcy;"), S("\xD0\x93") },
-  { S("&Gcirc;"), S("\xC4\x9C") },
-  { S("&Gcedil;"), S("\xC4\xA2") },
-  { S("&Gbreve;"), S("\xC4\x9E") },
-  { S("&Gammad;"), S("\xCF\x9C") },
-  { S("&Gamma;"), S("\xCE\x93") },
-  { S("&GT;"), S("\x3E") },
-  { S("&GT"), S("\x3E") },
-  { S("&GJcy;"), S("\xD0\x83") },
-  { S("&Fscr;"), S("\xE2\x84\xB1") },
-  { S("&Fouriertrf;"), S("\xE2\x84\xB1") },
-  { S("&ForAll;"), S("\xE2\x88\x80") },
-  { S("&Fopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&FilledVerySmallSquare;"), S("\xE2\x96\xAA") },
-  { S("&FilledSmallSquare;"), S("\xE2\x97\xBC") },
-  { S("&Ffr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Fcy;"), S("\xD0\xA4") },
-  { S("&ExponentialE;"), S("\xE2\x85\x87") },
-  { S("&Exists;"), S("\xE2\x88\x83") },
-  { S("&Euml;"), S("\xC3\x8B") },
-  { S("&Euml"), S("\xC3\x8B") },
-  { S("&Eta;"), S("\xCE\x97") },
-  { S("&Esim;"), S("\xE2\xA9\xB3") },
-  { S("&Escr;"), S("\xE2\x84\xB0") },
-  { S("&Equilibrium;"), S("\xE2\x87\x8C") },
-  { S("&EqualTilde;"), S("\xE2\x89\x82") },
-  { S("&Equal;"), S("\xE2\xA9\xB5") },
-  { S("&Epsilon;"), S("\xCE\x95") },
-  { S("&Eopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Eogon;"), S("\xC4\x98") },
-  { S("&EmptyVerySmallSquare;"), S("\xE2\x96\xAB") },
-  { S("&EmptySmallSquare;"), S("\xE2\x97\xBB") },
-  { S("&Emacr;"), S("\xC4\x92") },
-  { S("&Element;"), S("\xE2\x88\x88") },
-  { S("&Egrave;"), S("\xC3\x88") },
-  { S("&Egrave"), S("\xC3\x88") },
-  { S("&Efr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Edot;"), S("\xC4\x96") },
-  { S("&Ecy;"), S("\xD0\xAD") },
-  { S("&Ecirc;"), S("\xC3\x8A") },
-  { S("&Ecirc"), S("\xC3\x8A") },
-  { S("&Ecaron;"), S("\xC4\x9A") },
-  { S("&Eacute;"), S("\xC3\x89") },
-  { S("&Eacute"), S("\xC3\x89") },
-  { S("&ETH;"), S("\xC3\x90") },
-  { S("&ETH"), S("\xC3\x90") },
-  { S("&ENG;"), S("\xC5\x8A") },
-  { S("&Dstrok;"), S("\xC4\x90") },
-  { S("&Dscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Downarrow;"), S("\xE2\x87\x93") },
-  { S("&DownTeeArrow;"), S("\xE2\x86\xA7") },
-  { S("&DownTee;"), S("\xE2\x8A\xA4") },
-  { S("&DownRightVectorBar;"), S("\xE2\xA5\x97") },
-  { S("&DownRightVector;"), S("\xE2\x87\x81") },
-  { S("&DownRightTeeVector;"), S("\xE2\xA5\x9F") },
-  { S("&DownLeftVectorBar;"), S("\xE2\xA5\x96") },
-  { S("&DownLeftVector;"), S("\xE2\x86\xBD") },
-  { S("&DownLeftTeeVector;"), S("\xE2\xA5\x9E") },
-  { S("&DownLeftRightVector;"), S("\xE2\xA5\x90") },
-  { S("&DownBreve;"), S("\xCC\x91") },
-  { S("&DownArrowUpArrow;"), S("\xE2\x87\xB5") },
-  { S("&DownArrowBar;"), S("\xE2\xA4\x93") },
-  { S("&DownArrow;"), S("\xE2\x86\x93") },
-  { S("&DoubleVerticalBar;"), S("\xE2\x88\xA5") },
-  { S("&DoubleUpDownArrow;"), S("\xE2\x87\x95") },
-  { S("&DoubleUpArrow;"), S("\xE2\x87\x91") },
-  { S("&DoubleRightTee;"), S("\xE2\x8A\xA8") },
-  { S("&DoubleRightArrow;"), S("\xE2\x87\x92") },
-  { S("&DoubleLongRightArrow;"), S("\xE2\x9F\xB9") },
-  { S("&DoubleLongLeftRightArrow;"), S("\xE2\x9F\xBA") },
-  { S("&DoubleLongLeftArrow;"), S("\xE2\x9F\xB8") },
-  { S("&DoubleLeftTee;"), S("\xE2\xAB\xA4") },
-  { S("&DoubleLeftRightArrow;"), S("\xE2\x87\x94") },
-  { S("&DoubleLeftArrow;"), S("\xE2\x87\x90") },
-  { S("&DoubleDownArrow;"), S("\xE2\x87\x93") },
-  { S("&DoubleDot;"), S("\xC2\xA8") },
-  { S("&DoubleContourIntegral;"), S("\xE2\x88\xAF") },
-  { S("&DotEqual;"), S("\xE2\x89\x90") },
-  { S("&DotDot;"), S("\xE2\x83\x9C") },
-  { S("&Dot;"), S("\xC2\xA8") },
-  { S("&Dopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&DifferentialD;"), S("\xE2\x85\x86") },
-  { S("&Diamond;"), S("\xE2\x8B\x84") },
-  { S("&DiacriticalTilde;"), S("\xCB\x9C") },
-  { S("&DiacriticalGrave;"), S("\x60") },
-  { S("&DiacriticalDoubleAcute;"), S("\xCB\x9D") },
-  { S("&DiacriticalDot;"), S("\xCB\x99") },
-  { S("&DiacriticalAcute;"), S("\xC2\xB4") },
-  { S("&Dfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Delta;"), S("\xCE\x94") },
-  { S("&Del;"), S("\xE2\x88\x87") },
-  { S("&Dcy;"), S("\xD0\x94") },
-  { S("&Dcaron;"), S("\xC4\x8E") },
-  { S("&Dashv;"), S("\xE2\xAB\xA4") },
-  { S("&Darr;"), S("\xE2\x86\xA1") },
-  { S("&Dagger;"), S("\xE2\x80\xA1") },
-  { S("&DZcy;"), S("\xD0\x8F") },
-  { S("&DScy;"), S("\xD0\x85") },
-  { S("&DJcy;"), S("\xD0\x82") },
-  { S("&DDotrahd;"), S("\xE2\xA4\x91") },
-  { S("&DD;"), S("\xE2\x85\x85") },
-  { S("&CupCap;"), S("\xE2\x89\x8D") },
-  { S("&Cup;"), S("\xE2\x8B\x93") },
-  { S("&Cscr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Cross;"), S("\xE2\xA8\xAF") },
-  { S("&CounterClockwiseContourIntegral;"), S("\xE2\x88\xB3") },
-  { S("&Coproduct;"), S("\xE2\x88\x90") },
-  { S("&Copf;"), S("\xE2\x84\x82") },
-  { S("&ContourIntegral;"), S("\xE2\x88\xAE") },
-  { S("&Conint;"), S("\xE2\x88\xAF") },
-  { S("&Congruent;"), S("\xE2\x89\xA1") },
-  { S("&Colone;"), S("\xE2\xA9\xB4") },
-  { S("&Colon;"), S("\xE2\x88\xB7") },
-  { S("&CloseCurlyQuote;"), S("\xE2\x80\x99") },
-  { S("&CloseCurlyDoubleQuote;"), S("\xE2\x80\x9D") },
-  { S("&ClockwiseContourIntegral;"), S("\xE2\x88\xB2") },
-  { S("&CircleTimes;"), S("\xE2\x8A\x97") },
-  { S("&CirclePlus;"), S("\xE2\x8A\x95") },
-  { S("&CircleMinus;"), S("\xE2\x8A\x96") },
-  { S("&CircleDot;"), S("\xE2\x8A\x99") },
-  { S("&Chi;"), S("\xCE\xA7") },
-  { S("&Cfr;"), S("\xE2\x84\xAD") },
-  { S("&CenterDot;"), S("\xC2\xB7") },
-  { S("&Cedilla;"), S("\xC2\xB8") },
-  { S("&Cdot;"), S("\xC4\x8A") },
-  { S("&Cconint;"), S("\xE2\x88\xB0") },
-  { S("&Ccirc;"), S("\xC4\x88") },
-  { S("&Ccedil;"), S("\xC3\x87") },
-  { S("&Ccedil"), S("\xC3\x87") },
-  { S("&Ccaron;"), S("\xC4\x8C") },
-  { S("&Cayleys;"), S("\xE2\x84\xAD") },
-  { S("&CapitalDifferentialD;"), S("\xE2\x85\x85") },
-  { S("&Cap;"), S("\xE2\x8B\x92") },
-  { S("&Cacute;"), S("\xC4\x86") },
-  { S("&COPY;"), S("\xC2\xA9") },
-  { S("&COPY"), S("\xC2\xA9") },
-  { S("&CHcy;"), S("\xD0\xA7") },
-  { S("&Bumpeq;"), S("\xE2\x89\x8E") },
-  { S("&Bscr;"), S("\xE2\x84\xAC") },
-  { S("&Breve;"), S("\xCB\x98") },
-  { S("&Bopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Bfr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Beta;"), S("\xCE\x92") },
-  { S("&Bernoullis;"), S("\xE2\x84\xAC") },
-  { S("&Because;"), S("\xE2\x88\xB5") },
-  { S("&Bcy;"), S("\xD0\x91") },
-  { S("&Barwed;"), S("\xE2\x8C\x86") },
-  { S("&Barv;"), S("\xE2\xAB\xA7") },
-  { S("&Backslash;"), S("\xE2\x88\x96") },
-  { S("&Auml;"), S("\xC3\x84") },
-  { S("&Auml"), S("\xC3\x84") },
-  { S("&Atilde;"), S("\xC3\x83") },
-  { S("&Atilde"), S("\xC3\x83") },
-  { S("&Assign;"), S("\xE2\x89\x94") },
-  { S("&Ascr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Aring;"), S("\xC3\x85") },
-  { S("&Aring"), S("\xC3\x85") },
-  { S("&ApplyFunction;"), S("\xE2\x81\xA1") },
-  { S("&Aopf;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Aogon;"), S("\xC4\x84") },
-  { S("&And;"), S("\xE2\xA9\x93") },
-  { S("&Amacr;"), S("\xC4\x80") },
-  { S("&Alpha;"), S("\xCE\x91") },
-  { S("&Agrave;"), S("\xC3\x80") },
-  { S("&Agrave"), S("\xC3\x80") },
-  { S("&Afr;"), S("\xEF\xBF\xBD\xEF\xBF\xBD") },
-  { S("&Acy;"), S("\xD0\x90") },
-  { S("&Acirc;"), S("\xC3\x82") },
-  { S("&Acirc"), S("\xC3\x82") },
-  { S("&Abreve;"), S("\xC4\x82") },
-  { S("&Aacute;"), S("\xC3\x81") },
-  { S("&Aacute"), S("\xC3\x81") },
-  { S("&AMP;"), S("\x26") },
-  { S("&AMP"), S("\x26") },
-  { S("&AElig;"), S("\xC3\x86") },
-  { S("&AElig"), S("\xC3\x86") },
-};
-
-#undef S
-
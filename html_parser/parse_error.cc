@@ -0,0 +1,43 @@
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ */
+
+#include "html_parser/parse_error.hh"
+
+
+static char const *const k_parse_error_names_[NUM_PARSE_ERRORS] = {
+#define X(code, name) name,
+  PARSE_ERRORS(X)
+#undef X
+};
+
+
+[[nodiscard]]
+char const *
+parse_error_name(enum parse_error_code code)
+{
+  return k_parse_error_names_[code];
+}
+
+
+ParseErrorSink::ParseErrorSink(enum parse_error_mode mode, size_t capacity)
+: mode_(mode)
+{
+  if (mode == PARSE_ERRORS_COLLECT)
+    this->errors_.reserve(capacity);
+}
+
+
+void
+ParseErrorSink::clear(void)
+{
+  this->total_ = 0;
+
+  for (size_t& count : this->counts_)
+    count = 0;
+
+  /* keeps the capacity, and with it the limit */
+  this->errors_.clear();
+}
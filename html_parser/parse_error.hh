@@ -0,0 +1,158 @@
+#ifndef _queequeg_html_parser_parse_error_hh_
+#define _queequeg_html_parser_parse_error_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/parse_error.hh
+ *
+ * Description:
+ * Parse errors as compact codes plus the byte offset in the input where they
+ * were detected. The parser reports them to a ParseErrorSink owned by the
+ * caller, which counts them and optionally keeps them in a buffer allocated
+ * up front; without a sink, they are dropped before even computing the
+ * offset.
+ */
+
+#include <span>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * The tokenizer errors from the spec ("Parse errors", 13.2.2). Tree
+ * construction errors have no names there, so they share a single code.
+ */
+#define PARSE_ERRORS(X) \
+  X(ABRUPT_CLOSING_OF_EMPTY_COMMENT,                                  "abrupt-closing-of-empty-comment") \
+  X(ABRUPT_DOCTYPE_PUBLIC_IDENTIFIER,                                 "abrupt-doctype-public-identifier") \
+  X(ABRUPT_DOCTYPE_SYSTEM_IDENTIFIER,                                 "abrupt-doctype-system-identifier") \
+  X(ABSENCE_OF_DIGITS_IN_NUMERIC_CHARACTER_REFERENCE,                 "absence-of-digits-in-numeric-character-reference") \
+  X(CDATA_IN_HTML_CONTENT,                                            "cdata-in-html-content") \
+  X(CHARACTER_REFERENCE_OUTSIDE_UNICODE_RANGE,                        "character-reference-outside-unicode-range") \
+  X(CONTROL_CHARACTER_IN_INPUT_STREAM,                                "control-character-in-input-stream") \
+  X(CONTROL_CHARACTER_REFERENCE,                                      "control-character-reference") \
+  X(DUPLICATE_ATTRIBUTE,                                              "duplicate-attribute") \
+  X(END_TAG_WITH_ATTRIBUTES,                                          "end-tag-with-attributes") \
+  X(END_TAG_WITH_TRAILING_SOLIDUS,                                    "end-tag-with-trailing-solidus") \
+  X(EOF_BEFORE_TAG_NAME,                                              "eof-before-tag-name") \
+  X(EOF_IN_CDATA,                                                     "eof-in-cdata") \
+  X(EOF_IN_COMMENT,                                                   "eof-in-comment") \
+  X(EOF_IN_DOCTYPE,                                                   "eof-in-doctype") \
+  X(EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT,                             "eof-in-script-html-comment-like-text") \
+  X(EOF_IN_TAG,                                                       "eof-in-tag") \
+  X(INCORRECTLY_CLOSED_COMMENT,                                       "incorrectly-closed-comment") \
+  X(INCORRECTLY_OPENED_COMMENT,                                       "incorrectly-opened-comment") \
+  X(INVALID_CHARACTER_SEQUENCE_AFTER_DOCTYPE_NAME,                    "invalid-character-sequence-after-doctype-name") \
+  X(INVALID_FIRST_CHARACTER_OF_TAG_NAME,                              "invalid-first-character-of-tag-name") \
+  X(MISSING_ATTRIBUTE_VALUE,                                          "missing-attribute-value") \
+  X(MISSING_DOCTYPE_NAME,                                             "missing-doctype-name") \
+  X(MISSING_DOCTYPE_PUBLIC_IDENTIFIER,                                "missing-doctype-public-identifier") \
+  X(MISSING_DOCTYPE_SYSTEM_IDENTIFIER,                                "missing-doctype-system-identifier") \
+  X(MISSING_END_TAG_NAME,                                             "missing-end-tag-name") \
+  X(MISSING_QUOTE_BEFORE_DOCTYPE_PUBLIC_IDENTIFIER,                   "missing-quote-before-doctype-public-identifier") \
+  X(MISSING_QUOTE_BEFORE_DOCTYPE_SYSTEM_IDENTIFIER,                   "missing-quote-before-doctype-system-identifier") \
+  X(MISSING_SEMICOLON_AFTER_CHARACTER_REFERENCE,                      "missing-semicolon-after-character-reference") \
+  X(MISSING_WHITESPACE_AFTER_DOCTYPE_PUBLIC_KEYWORD,                  "missing-whitespace-after-doctype-public-keyword") \
+  X(MISSING_WHITESPACE_AFTER_DOCTYPE_SYSTEM_KEYWORD,                  "missing-whitespace-after-doctype-system-keyword") \
+  X(MISSING_WHITESPACE_BEFORE_DOCTYPE_NAME,                           "missing-whitespace-before-doctype-name") \
+  X(MISSING_WHITESPACE_BETWEEN_ATTRIBUTES,                            "missing-whitespace-between-attributes") \
+  X(MISSING_WHITESPACE_BETWEEN_DOCTYPE_PUBLIC_AND_SYSTEM_IDENTIFIERS, "missing-whitespace-between-doctype-public-and-system-identifiers") \
+  X(NESTED_COMMENT,                                                   "nested-comment") \
+  X(NONCHARACTER_CHARACTER_REFERENCE,                                 "noncharacter-character-reference") \
+  X(NONCHARACTER_IN_INPUT_STREAM,                                     "noncharacter-in-input-stream") \
+  X(NON_VOID_HTML_ELEMENT_START_TAG_WITH_TRAILING_SOLIDUS,            "non-void-html-element-start-tag-with-trailing-solidus") \
+  X(NULL_CHARACTER_REFERENCE,                                         "null-character-reference") \
+  X(SURROGATE_CHARACTER_REFERENCE,                                    "surrogate-character-reference") \
+  X(SURROGATE_IN_INPUT_STREAM,                                        "surrogate-in-input-stream") \
+  X(UNEXPECTED_CHARACTER_AFTER_DOCTYPE_SYSTEM_IDENTIFIER,             "unexpected-character-after-doctype-system-identifier") \
+  X(UNEXPECTED_CHARACTER_IN_ATTRIBUTE_NAME,                           "unexpected-character-in-attribute-name") \
+  X(UNEXPECTED_CHARACTER_IN_UNQUOTED_ATTRIBUTE_VALUE,                 "unexpected-character-in-unquoted-attribute-value") \
+  X(UNEXPECTED_EQUALS_SIGN_BEFORE_ATTRIBUTE_NAME,                     "unexpected-equals-sign-before-attribute-name") \
+  X(UNEXPECTED_NULL_CHARACTER,                                        "unexpected-null-character") \
+  X(UNEXPECTED_QUESTION_MARK_INSTEAD_OF_TAG_NAME,                     "unexpected-question-mark-instead-of-tag-name") \
+  X(UNEXPECTED_SOLIDUS_IN_TAG,                                        "unexpected-solidus-in-tag") \
+  X(UNKNOWN_NAMED_CHARACTER_REFERENCE,                                "unknown-named-character-reference") \
+  X(TREE_CONSTRUCTION,                                               "tree-construction")
+
+
+enum parse_error_code : uint8_t {
+#define X(code, name) PARSE_ERROR_##code,
+  PARSE_ERRORS(X)
+#undef X
+
+  NUM_PARSE_ERRORS,
+};
+
+
+enum parse_error_mode {
+  PARSE_ERRORS_DROP,
+  PARSE_ERRORS_COUNT,
+  PARSE_ERRORS_COLLECT,
+};
+
+
+struct parse_error {
+  size_t offset;
+  enum parse_error_code code;
+};
+
+
+[[nodiscard]] char const *parse_error_name(enum parse_error_code code);
+
+
+class ParseErrorSink final {
+  public:
+    static constexpr size_t k_default_capacity = 4096;
+
+    /*
+     * In PARSE_ERRORS_COLLECT mode, the first capacity errors are kept and
+     * the rest only counted
+     */
+    explicit ParseErrorSink(enum parse_error_mode mode,
+                            size_t capacity = ParseErrorSink::k_default_capacity);
+
+
+  public:
+    [[nodiscard]] inline enum parse_error_mode mode(void) const { return this->mode_; }
+
+    [[nodiscard]] inline size_t total(void) const { return this->total_; }
+    [[nodiscard]] inline size_t count(enum parse_error_code code) const { return this->counts_[code]; }
+
+    [[nodiscard]]
+    inline std::span< struct parse_error const>
+    errors(void) const
+    {
+      return this->errors_;
+    }
+
+
+    inline void
+    report(enum parse_error_code code, size_t offset)
+    {
+      this->counts_[code]++;
+      this->total_++;
+
+      if (this->mode_ == PARSE_ERRORS_COLLECT
+       && this->errors_.size() < this->errors_.capacity())
+        this->errors_.push_back({ .offset = offset, .code = code });
+    }
+
+    void clear(void);
+
+
+  private:
+    enum parse_error_mode mode_;
+
+    size_t total_ = 0;
+    size_t counts_[NUM_PARSE_ERRORS] = { };
+
+    std::vector< struct parse_error> errors_;
+};
+
+
+#endif /* !defined(_queequeg_html_parser_parse_error_hh_) */
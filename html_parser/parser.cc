@@ -4,90 +4,155 @@
  * See LICENSE for details
  */
 
-#include <cstdio>
-#include <stdio.h>
-#include <csignal>
-#include <cstdlib>
-
 #include "html_parser/parser.hh"
 #include "html_parser/internal.hh"
+#include "html_parser/pipeline.hh"
+#include "html_parser/chunked.hh"
 
 #include "dom/core/document.hh"
 
 
-static struct {
-  Tokenizer   *tokenizer;
-  TreeBuilder *treebuilder;
-} signal_handler_shared;
-
-
 /*
- * cheap hack to roughly know where we are in the source document
+ * Everything a parse needs lives in here, so that any number of them can run
+ * side by side (on different documents); there is no global state.
  */
+struct HTMLParser {
+  std::shared_ptr< DOM::Document> document;
+  Tokenizer   tokenizer;
+  TreeBuilder treebuilder;
 
-extern "C" {
+  HTMLParser(std::shared_ptr< DOM::Document> document_,
+             TreeEventHandler *events = nullptr)
+  : document(document_), treebuilder(document_, events) { }
+
+  HTMLParser(std::shared_ptr< DOM::Document> document_,
+             char const *input, size_t input_len)
+  : document(document_), tokenizer(input, input_len), treebuilder(document_) { }
+};
 
 
-[[noreturn]]
 static void
-sigsegv_handler(int signal)
+connect_parser(HTMLParser *parser, ParseErrorSink *errors)
 {
-  (void) signal;
+  parser->tokenizer.sink = &parser->treebuilder;
+  parser->treebuilder.tokenizer = &parser->tokenizer;
 
-  auto *ctx = &signal_handler_shared;
+  if (errors != nullptr && errors->mode() != PARSE_ERRORS_DROP)
+    parser->tokenizer.errors = errors;
 
-  char peek_buffer[512] = { 0 };
-  size_t left = ctx->tokenizer->input.end - ctx->tokenizer->input.p;
-  memcpy(peek_buffer, ctx->tokenizer->input.p, std::min(left, sizeof (peek_buffer) - 1));
+  parser->document->parser_status = DOM_DOCUMENT_PARSER_STATUS_RUNNING;
+}
 
-  std::fprintf(stderr, "==< SEGMENTATION FAULT (QUEEQUEG HANDLER) >==\n"
-                       "  peek_buffer:\n"
-                       "%s\n",
-               peek_buffer);
 
-  std::exit(1337);
+[[nodiscard]]
+HTMLParser *
+html_parser_open(std::shared_ptr< DOM::Document> document,
+                 ParseErrorSink *errors)
+{
+  HTMLParser *parser = new HTMLParser(document);
+
+  connect_parser(parser, errors);
+
+  return parser;
 }
 
 
-} /* extern "C" */
+void
+html_parser_feed(HTMLParser *parser, char const *chunk, size_t chunk_len)
+{
+  parser->tokenizer.feed(chunk, chunk_len);
+  /* so that the document is complete up to here in between chunks */
+  parser->treebuilder.flush_pending_text();
+}
 
 
-static void
-register_signal_handlers(Tokenizer *tokenizer,
-                         TreeBuilder *treebuilder)
+int
+html_parser_finish(HTMLParser *parser)
 {
+  parser->tokenizer.finish();
 
-  signal_handler_shared.tokenizer = tokenizer;
-  signal_handler_shared.treebuilder = treebuilder;
+  parser->document->parser_status = DOM_DOCUMENT_PARSER_STATUS_DONE;
 
-  std::signal(SIGSEGV, sigsegv_handler);
+  delete parser;
 
+  return 0;
 }
 
 
 int
 html_parse_document(std::shared_ptr< DOM::Document> document,
-                    char const *input, size_t input_len)
+                    char const *input, size_t input_len,
+                    ParseErrorSink *errors)
 {
-  Tokenizer   tokenizer   = Tokenizer(input, input_len);
-  TreeBuilder treebuilder = TreeBuilder(document);
+  HTMLParser *parser = html_parser_open(document, errors);
 
-  tokenizer.treebuilder = &treebuilder;
-  treebuilder.tokenizer = &tokenizer;
+  html_parser_feed(parser, input, input_len);
 
-  document->parser_status = DOM_DOCUMENT_PARSER_STATUS_RUNNING;
+  return html_parser_finish(parser);
+}
+
+
+int
+html_parse_document_pipelined(std::shared_ptr< DOM::Document> document,
+                              char const *input, size_t input_len,
+                              ParseErrorSink *errors)
+{
+  /* the parser's own tokenizer is left unused */
+  auto parser = std::make_unique<HTMLParser>(document);
+  BasicTokenizer< TokenQueue> tokenizer(input, input_len);
 
-  register_signal_handlers(&tokenizer, &treebuilder);
+  connect_parser(parser.get(), errors);
+  tokenizer.errors = parser->tokenizer.errors;
 
-  tokenizer.run();
+  {
+    TokenPipeline pipeline(&tokenizer, &parser->treebuilder);
+    pipeline.run();
+  }
 
   document->parser_status = DOM_DOCUMENT_PARSER_STATUS_DONE;
 
-  printf("%d elements left on stack after parsing:\n",
-    static_cast<int>(treebuilder.open_elements.size()));
-  for (auto& elem : treebuilder.open_elements)
-    printf("  element of index %d\n", static_cast<int>(elem->local_name));
+  return 0;
+}
+
+
+int
+html_parse_document_chunked(std::shared_ptr< DOM::Document> document,
+                            char const *input, size_t input_len,
+                            unsigned n_workers, ParseErrorSink *errors)
+{
+  auto parser = std::make_unique<HTMLParser>(document, input, input_len);
+
+  connect_parser(parser.get(), errors);
+
+  {
+    ChunkedTokenizer chunked(&parser->tokenizer, &parser->treebuilder, n_workers);
+    chunked.run();
+  }
+
+  document->parser_status = DOM_DOCUMENT_PARSER_STATUS_DONE;
 
   return 0;
 }
 
+
+int
+html_parse_events(TreeEventHandler *handler,
+                  char const *input, size_t input_len,
+                  ParseErrorSink *errors)
+{
+  /*
+   * Only there to make the elements the tree builder needs; with the heap,
+   * they go away as soon as it is done with them
+   */
+  std::shared_ptr< DOM::Document> document =
+   std::make_shared<DOM::Document>(DOM_DOCUMENT_FORMAT_HTML, DOM_NODE_ALLOCATION_HEAP);
+  document->node_document = std::static_pointer_cast<DOM::Document>(document->shared_from_this());
+
+  HTMLParser *parser = new HTMLParser(document, handler);
+
+  connect_parser(parser, errors);
+
+  html_parser_feed(parser, input, input_len);
+
+  return html_parser_finish(parser);
+}
@@ -7,10 +7,60 @@
 
 #include "dom/core/document.hh"
 
+#include "html_parser/parse_error.hh"
+
+
+/*
+ * Push-based interface: open a parser on a document, feed it the input in
+ * chunks of any size (they may split characters, tokens, anything) and
+ * finish it when the input is over. finish() frees the parser.
+ *
+ * Parse errors go to errors, which must outlive the parser; they are dropped
+ * if it is nullptr or in PARSE_ERRORS_DROP mode.
+ *
+ * Parsers share no state with each other, so documents may be parsed on as
+ * many threads at once as there are documents; a given parser (along with its
+ * document and error sink) must only be used by one thread at a time.
+ */
+struct HTMLParser;
+
+[[nodiscard]] HTMLParser *html_parser_open(std::shared_ptr< DOM::Document> document,
+                                           ParseErrorSink *errors = nullptr);
+void html_parser_feed(HTMLParser *parser, char const *chunk, size_t chunk_len);
+int html_parser_finish(HTMLParser *parser);
+
 
 int html_parse_document(std::shared_ptr< DOM::Document> document,
-                        char const *input, size_t input_len);
+                        char const *input, size_t input_len,
+                        ParseErrorSink *errors = nullptr);
 
+/*
+ * Same result, with the tokenizer running on a second thread ahead of tree
+ * construction (see html_parser/pipeline.hh); worth it for large inputs.
+ */
+int html_parse_document_pipelined(std::shared_ptr< DOM::Document> document,
+                                  char const *input, size_t input_len,
+                                  ParseErrorSink *errors = nullptr);
 
-#endif /* !defined(_queequeg_html_parser_parser_hh_) */
+/*
+ * Same result again, with the input cut into chunks that up to n_workers
+ * other threads tokenize ahead of tree construction (see
+ * html_parser/chunked.hh); for inputs of several megabytes.
+ */
+int html_parse_document_chunked(std::shared_ptr< DOM::Document> document,
+                                char const *input, size_t input_len,
+                                unsigned n_workers, ParseErrorSink *errors = nullptr);
 
+
+/*
+ * Builds no document at all: handler is told about every node as it would go
+ * into one (see html_parser/tree_events.hh).
+ */
+class TreeEventHandler;
+
+int html_parse_events(TreeEventHandler *handler,
+                      char const *input, size_t input_len,
+                      ParseErrorSink *errors = nullptr);
+
+
+#endif /* !defined(_queequeg_html_parser_parser_hh_) */
@@ -0,0 +1,392 @@
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ */
+#include <cassert>
+
+#include <string.h>
+
+#include "html_parser/pipeline.hh"
+
+
+static union token_data *
+token_data_of(struct queued_token *entry)
+{
+  switch (entry->type) {
+    case TOKEN_CHARACTER:
+    case TOKEN_WHITESPACE:
+      return reinterpret_cast<union token_data *>(&entry->ch);
+
+    case TOKEN_CHARACTER_RUN:
+      return reinterpret_cast<union token_data *>(&entry->chars);
+
+    case TOKEN_DOCTYPE:
+      return reinterpret_cast<union token_data *>(&entry->doctype);
+
+    case TOKEN_START_TAG:
+    case TOKEN_END_TAG:
+      return reinterpret_cast<union token_data *>(&entry->tag);
+
+    case TOKEN_COMMENT:
+      return reinterpret_cast<union token_data *>(&entry->comment);
+
+    default:
+      return nullptr;
+  }
+}
+
+
+TokenQueue::TokenQueue(BasicTokenizer< TokenQueue> *tokenizer, bool scripting)
+{
+  this->tokenizer_ = tokenizer;
+  this->scripting_ = scripting;
+
+  assert( tokenizer->input.final );
+
+  tokenizer->sink = this;
+}
+
+
+TokenQueue::~TokenQueue()
+{
+  this->tokenizer_->sink = nullptr;
+}
+
+
+void
+TokenQueue::process_token(union token_data *token_data, enum token_type token_type)
+{
+  struct queued_token *entry = this->reserve_();
+
+  if (entry == nullptr)
+    return;
+
+  entry->kind   = QUEUED_TOKEN;
+  entry->type   = token_type;
+  entry->offset = this->tokenizer_->offset();
+
+  switch (token_type) {
+    case TOKEN_CHARACTER:
+    case TOKEN_WHITESPACE:
+      entry->ch = token_data->ch;
+      break;
+
+    case TOKEN_CHARACTER_RUN:
+      entry->chars = token_data->chars;
+      break;
+
+    case TOKEN_DOCTYPE:
+      entry->doctype = token_data->doctype;
+      break;
+
+    case TOKEN_START_TAG:
+    case TOKEN_END_TAG:
+      entry->tag = token_data->tag;
+      break;
+
+    case TOKEN_COMMENT:
+      entry->comment = token_data->comment;
+      break;
+
+    default:
+      break;
+  }
+
+  if (token_type == TOKEN_START_TAG) {
+    enum tokenizer_state natural_state = this->tokenizer_->state;
+
+    entry->natural_state    = natural_state;
+    entry->speculated_state = guess_tokenizer_state_after(&token_data->tag, this->scripting_,
+                                                          natural_state);
+    /* the state is only known once the tree builder is done with the tag */
+    entry->checkpoint = this->tokenizer_->checkpoint(natural_state);
+
+    this->tokenizer_->state = entry->speculated_state;
+  }
+
+  this->commit_();
+}
+
+
+void
+TokenQueue::report_error(enum parse_error_code code, size_t offset)
+{
+  struct queued_token *entry = this->reserve_();
+
+  if (entry == nullptr)
+    return;
+
+  entry->kind   = QUEUED_PARSE_ERROR;
+  entry->error  = code;
+  entry->offset = offset;
+
+  this->commit_();
+}
+
+
+/*
+ * Called with "[CDATA[" just consumed. Foreign content is rare, so the guess
+ * is a bogus comment
+ */
+[[nodiscard]]
+bool
+TokenQueue::allows_cdata_section(void)
+{
+  if (this->forced_cdata_.has_value()) {
+    bool allowed = *this->forced_cdata_;
+    this->forced_cdata_.reset();
+    return allowed;
+  }
+
+  struct queued_token *entry = this->reserve_();
+
+  if (entry == nullptr)
+    return false;
+
+  entry->kind   = QUEUED_CDATA_CHECK;
+  entry->offset = this->tokenizer_->offset();
+  entry->speculated_cdata = false;
+  entry->checkpoint = this->tokenizer_->checkpoint(MARKUP_DECL_OPEN_STATE);
+  /* a restart has to see it again */
+  entry->checkpoint.p -= strlen("[CDATA[");
+
+  this->commit_();
+
+  return false;
+}
+
+
+TokenReplay::TokenReplay(TreeBuilder *treebuilder, ParseErrorSink *errors)
+{
+  this->treebuilder_ = treebuilder;
+  this->errors_      = errors;
+}
+
+
+TokenReplay::~TokenReplay()
+{
+  this->treebuilder_->replay = nullptr;
+}
+
+
+void
+TokenReplay::report_tree_construction_error(size_t offset)
+{
+  if (this->errors_ != nullptr)
+    this->errors_->report(PARSE_ERROR_TREE_CONSTRUCTION, offset);
+}
+
+
+[[nodiscard]]
+enum replay_status
+TokenReplay::replay_(struct queued_token *entry, struct tokenizer_checkpoint *restart)
+{
+  switch (entry->kind) {
+    case QUEUED_PARSE_ERROR:
+      if (this->errors_ != nullptr)
+        this->errors_->report(entry->error, entry->offset);
+      return REPLAY_OK;
+
+    case QUEUED_CDATA_CHECK:
+      if (this->treebuilder_->allows_cdata_section() == entry->speculated_cdata)
+        return REPLAY_OK;
+
+      *restart = entry->checkpoint;
+      return REPLAY_WRONG_CDATA;
+
+    case QUEUED_TOKEN:
+      break;
+  }
+
+  this->token_offset_ = entry->offset;
+  this->requested_state_.reset();
+
+  this->treebuilder_->replay = this;
+  this->treebuilder_->process_token(token_data_of(entry), entry->type);
+  this->treebuilder_->replay = nullptr;
+
+  if (entry->type != TOKEN_START_TAG) {
+    assert( ! this->requested_state_.has_value() );
+    return REPLAY_OK;
+  }
+
+  enum tokenizer_state state = this->requested_state_.value_or(entry->natural_state);
+
+  if (state == entry->speculated_state)
+    return REPLAY_OK;
+
+  *restart = entry->checkpoint;
+  restart->state = state;
+
+  return REPLAY_WRONG_STATE;
+}
+
+
+TokenPipeline::TokenPipeline(BasicTokenizer< TokenQueue> *tokenizer, TreeBuilder *treebuilder)
+: TokenQueue(tokenizer, treebuilder->flags.scripting),
+  TokenReplay(treebuilder, tokenizer->errors)
+{
+  this->input_end_ = tokenizer->input.end;
+}
+
+
+TokenPipeline::~TokenPipeline()
+{
+  this->stop_tokenizer_();
+}
+
+
+void
+TokenPipeline::run(void)
+{
+  this->start_tokenizer_();
+
+  while (true)
+  {
+    struct queued_token *entry = this->ring_.front();
+    struct tokenizer_checkpoint restart;
+
+    switch (this->replay_(entry, &restart)) {
+      case REPLAY_OK:
+        break;
+
+      case REPLAY_WRONG_STATE:
+        this->restart_tokenizer_(restart, std::nullopt);
+        continue;
+
+      case REPLAY_WRONG_CDATA:
+        this->restart_tokenizer_(restart, ! entry->speculated_cdata);
+        continue;
+    }
+
+    if (entry->kind == QUEUED_TOKEN && entry->type == TOKEN_EOF) {
+      this->ring_.pop();
+      this->stop_tokenizer_();
+      return;
+    }
+
+    this->ring_.pop();
+  }
+
+}
+
+
+/*
+ * Once asked to stop, the tokenizer is made to run out of input, which gets
+ * it to return from Tokenizer::run() shortly; nothing it emits on the way is
+ * queued anymore.
+ */
+[[nodiscard]]
+struct queued_token *
+TokenPipeline::reserve_(void)
+{
+  if (this->stop_.load(std::memory_order_relaxed)) {
+    this->tokenizer_->input.end = this->tokenizer_->input.p;
+    return nullptr;
+  }
+
+  return this->ring_.reserve();
+}
+
+
+void
+TokenPipeline::commit_(void)
+{
+  this->ring_.commit();
+}
+
+
+/*
+ * Waits until control isn't what it is anymore, yielding a few times first
+ * like the ring does (restarts are usually over in no time)
+ */
+static void
+wait_for_control_change(std::atomic< enum pipeline_tokenizer_control> *control,
+                        enum pipeline_tokenizer_control old)
+{
+  static constexpr size_t k_spin_limit = 64;
+
+  for (size_t spins = 0; spins < k_spin_limit; spins++) {
+    if (control->load(std::memory_order_acquire) != old)
+      return;
+
+    std::this_thread::yield();
+  }
+
+  control->wait(old, std::memory_order_acquire);
+}
+
+
+/*
+ * The tokenizer thread: runs the tokenizer, then waits until it was rewound
+ * (and runs it again) or until it is told to quit
+ */
+void
+TokenPipeline::tokenizer_main_(void)
+{
+  while (true) {
+    this->tokenizer_->run();
+
+    this->control_.store(PIPELINE_TOKENIZER_IDLE, std::memory_order_release);
+    this->control_.notify_one();
+    wait_for_control_change(&this->control_, PIPELINE_TOKENIZER_IDLE);
+
+    if (this->control_.load(std::memory_order_acquire) == PIPELINE_TOKENIZER_QUIT)
+      return;
+  }
+}
+
+
+void
+TokenPipeline::start_tokenizer_(void)
+{
+  this->control_.store(PIPELINE_TOKENIZER_RUNNING, std::memory_order_relaxed);
+  this->tokenizer_thread_ = std::thread([this](void){ this->tokenizer_main_(); });
+}
+
+
+void
+TokenPipeline::pause_tokenizer_(void)
+{
+  /* whatever is queued is stale by now; dropping it makes room for a
+   * tokenizer waiting in reserve_(), which then sees stop_ on its next call */
+  this->stop_.store(true, std::memory_order_relaxed);
+  this->ring_.pop_all();
+  wait_for_control_change(&this->control_, PIPELINE_TOKENIZER_RUNNING);
+  this->stop_.store(false, std::memory_order_relaxed);
+
+  /* it may have queued one more entry on its way out */
+  this->ring_.clear();
+}
+
+
+void
+TokenPipeline::stop_tokenizer_(void)
+{
+  if (! this->tokenizer_thread_.joinable())
+    return;
+
+  this->pause_tokenizer_();
+
+  this->control_.store(PIPELINE_TOKENIZER_QUIT, std::memory_order_release);
+  this->control_.notify_one();
+  this->tokenizer_thread_.join();
+}
+
+
+/*
+ * Everything queued after the checkpoint was tokenized in the wrong state
+ */
+void
+TokenPipeline::restart_tokenizer_(struct tokenizer_checkpoint const& checkpoint,
+                                  std::optional< bool> forced_cdata)
+{
+  this->pause_tokenizer_();
+
+  this->tokenizer_->rewind(checkpoint, this->input_end_);
+  this->forced_cdata_ = forced_cdata;
+
+  this->control_.store(PIPELINE_TOKENIZER_RUNNING, std::memory_order_release);
+  this->control_.notify_one();
+}
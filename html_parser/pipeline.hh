@@ -0,0 +1,235 @@
+#ifndef _queequeg_html_parser_pipeline_hh_
+#define _queequeg_html_parser_pipeline_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/pipeline.hh
+ *
+ * Description:
+ * Tokenizing ahead of tree construction. The tokenizer can't wait for the
+ * tree builder to tell it which state to go on in after a start tag (or
+ * whether "<![CDATA[" opens a CDATA section), so it guesses and the tree
+ * builder checks: every start tag and every CDATA decision is queued along
+ * with where the tokenizer can be restarted from. If the guess was wrong,
+ * whatever was queued after it is dropped and the tokenizer starts over from
+ * there in the right state. Parse errors are queued as well, so that they
+ * are reported in order and dropped along with the tokens they belong to.
+ *
+ * TokenPipeline runs the tokenizer on a thread of its own, handing its tokens
+ * over to the tree builder through a single-producer/single-consumer ring.
+ * The thread lasts as long as the pipeline: after a wrong guess, it is told
+ * to go on from the checkpoint rather than started anew.
+ */
+
+#include <atomic>
+#include <optional>
+#include <thread>
+
+#include <stddef.h>
+
+#include "html_parser/internal.hh"
+
+#include "qglib/spsc_ring.hh"
+
+
+enum queued_token_kind : uint8_t {
+  QUEUED_TOKEN,
+  QUEUED_PARSE_ERROR,
+  QUEUED_CDATA_CHECK,
+};
+
+
+/*
+ * Slots are reused, so that the strings keep their buffers; only the member
+ * matching type is meaningful.
+ */
+struct queued_token {
+  enum queued_token_kind kind;
+  enum token_type type;
+  enum parse_error_code error;
+  size_t offset;
+
+  /*
+   * Start tags and CDATA checks: the state (respectively the answer) the
+   * tokenizer went on with, and where to restart it if that was wrong
+   */
+  enum tokenizer_state natural_state;
+  enum tokenizer_state speculated_state;
+  bool speculated_cdata;
+  struct tokenizer_checkpoint checkpoint;
+
+  char32_t ch;
+  std::string_view chars;
+  QueequegLib::BorrowedString comment;
+  struct doctype_token doctype;
+  struct tag_token tag;
+};
+
+
+/*
+ * The tokenizer's side: a sink (see TokenSink) that queues what it is given,
+ * guessing where the tokenizer needs the tree builder's say. Only for complete
+ * documents.
+ */
+class TokenQueue {
+  public:
+    TokenQueue(TokenQueue const& other) = delete;
+    TokenQueue& operator=(TokenQueue const& other) = delete;
+
+
+  public:
+    void process_token(union token_data *token_data, enum token_type token_type);
+    void report_error(enum parse_error_code code, size_t offset);
+    [[nodiscard]] bool allows_cdata_section(void);
+
+
+  protected:
+    TokenQueue(BasicTokenizer< TokenQueue> *tokenizer, bool scripting);
+    ~TokenQueue();
+
+    /*
+     * nullptr drops the entry; commit_() follows any other
+     */
+    [[nodiscard]] virtual struct queued_token *reserve_(void) = 0;
+    virtual void commit_(void) = 0;
+
+
+  protected:
+    BasicTokenizer< TokenQueue> *tokenizer_;
+
+    /*
+     * The answer to the next CDATA check, after a restart because the
+     * previous guess at it was wrong
+     */
+    std::optional< bool> forced_cdata_;
+
+
+  private:
+    /* the tree builder's, which doesn't change while parsing */
+    bool scripting_;
+};
+
+
+enum pipeline_tokenizer_control : uint8_t {
+  /* in Tokenizer::run() */
+  PIPELINE_TOKENIZER_RUNNING,
+  /* waiting to be rewound, or told to quit */
+  PIPELINE_TOKENIZER_IDLE,
+  PIPELINE_TOKENIZER_QUIT,
+};
+
+
+enum replay_status {
+  REPLAY_OK,
+  /* the tokenizer went on in the wrong state after a start tag */
+  REPLAY_WRONG_STATE,
+  /* the tokenizer took "<![CDATA[" for what it wasn't */
+  REPLAY_WRONG_CDATA,
+};
+
+
+/*
+ * The tree builder's side: hands queued entries over to it one by one (see
+ * TreeBuilder::replay), checking the tokenizer's guesses
+ */
+class TokenReplay {
+  public:
+    TokenReplay(TokenReplay const& other) = delete;
+    TokenReplay& operator=(TokenReplay const& other) = delete;
+
+
+  public:
+    inline void
+    switch_tokenizer_state(enum tokenizer_state state)
+    {
+      this->requested_state_ = state;
+    }
+
+    void report_tree_construction_error(size_t offset);
+
+    [[nodiscard]]
+    inline size_t
+    token_offset(void) const
+    {
+      return this->token_offset_;
+    }
+
+
+  protected:
+    TokenReplay(TreeBuilder *treebuilder, ParseErrorSink *errors);
+    ~TokenReplay();
+
+    /*
+     * Unless REPLAY_OK, nothing queued after entry is any good, and the
+     * tokenizer has to start over from restart
+     */
+    [[nodiscard]] enum replay_status replay_(struct queued_token *entry,
+                                             struct tokenizer_checkpoint *restart);
+
+
+  protected:
+    TreeBuilder *treebuilder_;
+
+
+  private:
+    ParseErrorSink *errors_;
+
+    std::optional< enum tokenizer_state> requested_state_;
+    size_t token_offset_ = 0;
+};
+
+
+/*
+ * The tokenizer must have been constructed on the whole input, which must
+ * outlive the pipeline.
+ */
+class TokenPipeline final : private TokenQueue, private TokenReplay {
+  public:
+    TokenPipeline(BasicTokenizer< TokenQueue> *tokenizer, TreeBuilder *treebuilder);
+    ~TokenPipeline();
+
+
+  public:
+    /*
+     * Tokenizes and builds the tree up to EOF
+     */
+    void run(void);
+
+
+  private:
+    static constexpr size_t k_ring_capacity_ = 512;
+
+    /*
+     * Tokenizer thread
+     */
+    [[nodiscard]] struct queued_token *reserve_(void) override;
+    void commit_(void) override;
+
+    void tokenizer_main_(void);
+
+    void start_tokenizer_(void);
+    /*
+     * Returns with the tokenizer idle; nothing it queued is left
+     */
+    void pause_tokenizer_(void);
+    void stop_tokenizer_(void);
+    void restart_tokenizer_(struct tokenizer_checkpoint const& checkpoint,
+                            std::optional< bool> forced_cdata);
+
+
+  private:
+    /* the tokenizer's own may have been cut short by stop_tokenizer_() */
+    char const *input_end_;
+
+    QueequegLib::SPSCRing< struct queued_token, k_ring_capacity_> ring_;
+
+    std::thread tokenizer_thread_;
+    std::atomic< bool> stop_ = false;
+    std::atomic< enum pipeline_tokenizer_control> control_ = PIPELINE_TOKENIZER_IDLE;
+};
+
+
+#endif /* !defined(_queequeg_html_parser_pipeline_hh_) */
@@ -0,0 +1,75 @@
+#ifndef _queequeg_html_parser_tokenize_hh_
+#define _queequeg_html_parser_tokenize_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/tokenize.hh
+ *
+ * Description:
+ * Tokenizer-only runs, for consumers that have no use for a document: the
+ * tokens go straight to a sink of their own (see TokenSink), and there is no
+ * tree construction at all.
+ *
+ * The tokenizer is instantiated once per sink type, so that its calls to the
+ * sink are resolved at compile time; the library does so for the sinks in
+ * TOKEN_SINKS, and any other translation unit may do so for a sink of its own
+ * with HTML_TOKENIZER_INSTANTIATE() (see html_parser/tokenizer_impl.hh).
+ */
+
+#include <stddef.h>
+
+#include "html_parser/internal.hh"
+#include "html_parser/parse_error.hh"
+#include "html_parser/pipeline.hh"
+
+
+/*
+ * Counts tokens by type
+ */
+class TokenCounter final {
+  public:
+    static constexpr bool k_guesses_text_states = true;
+
+    size_t counts[NUM_TOKEN_TYPES] = { };
+
+
+  public:
+    inline void
+    process_token([[maybe_unused]] union token_data *token_data, enum token_type token_type)
+    {
+      this->counts[token_type]++;
+    }
+
+    [[nodiscard]] inline bool allows_cdata_section(void) const { return false; }
+};
+
+
+#define TOKEN_SINKS(X) \
+  X(TreeBuilder) \
+  X(TokenQueue) \
+  X(TokenCounter)
+
+
+/*
+ * Tokenizes a complete document up to EOF
+ */
+template< typename Sink>
+void
+html_tokenize(Sink *sink, char const *input, size_t input_len,
+              ParseErrorSink *errors = nullptr)
+{
+  BasicTokenizer< Sink> tokenizer(input, input_len);
+
+  tokenizer.sink = sink;
+
+  if (errors != nullptr && errors->mode() != PARSE_ERRORS_DROP)
+    tokenizer.errors = errors;
+
+  tokenizer.run();
+}
+
+
+#endif /* !defined(_queequeg_html_parser_tokenize_hh_) */
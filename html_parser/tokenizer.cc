@@ -3,350 +3,106 @@
  * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
  * See LICENSE for details
  */
-
-#include <stddef.h>
-#include <string.h>
-#include <stdio.h>
-
-#include <grapheme.h>
-#include <infra/ascii.h>
-#include <infra/string.h>
-
-#include "qglib/unicode.hh"
-
 #include "html_parser/internal.hh"
+#include "html_parser/tokenize.hh"
+#include "html_parser/tokenizer_impl.hh"
 
 
-#define LOGF(...) \
-  fprintf(stderr, __VA_ARGS__)
-
-
-const std::unordered_map< std::string, uint16_t> Tokenizer::k_quirky_local_names_ = {
-  { "image", HTML_ELEMENT_IMG   },
-  { "math",  HTML_ELEMENT_MATH_ },
-  { "svg",   HTML_ELEMENT_SVG_  },
-};
-
-
-Tokenizer::Tokenizer(char const *input, size_t input_len)
-{
-  this->input.p   = input;
-  this->input.end = &input[input_len];
-}
-
-
-Tokenizer::~Tokenizer()
-{
-}
-
-
-[[nodiscard]]
-char32_t
-Tokenizer::getchar(void)
-{
-  size_t left = this->input.end - this->input.p;
-  size_t read;
-  char32_t ch = {0xFFFD};
-
-
-  if (left > 0 && *this->input.p == '\0')
-    /* libgrapheme was not designed for this, let us do it */
-    return *this->input.p++;
-
-
-  if (left >= 2
-   && this->input.p[0] == '\r'
-   && this->input.p[1] == '\n') {
-    this->input.p += 2;
-    return U'\n';
-  }
-
-  if (left >= 1
-   && this->input.p[0] == '\r') {
-    this->input.p += 1;
-    return U'\n';
-  }
-
-
-  if (!left || !(read = grapheme_decode_utf8(this->input.p,
-                         left, reinterpret_cast<uint_least32_t *>(&ch))))
-    return static_cast<char32_t>(-1);
-
-
-  this->input.p += read;
-  return ch;
-}
-
-
-[[nodiscard]]
-bool
-Tokenizer::match_fn_(int (*cmp) (char const *, char const *, size_t),
-                     char const *s,
-                     size_t slen)
-{
-  size_t left = this->input.end - this->input.p;
-
-
-  if (left < slen)
-    return false;
-
-
-  if (!cmp(this->input.p, s, slen)) {
-    this->input.p += slen;
-    return true;
-  }
-
-
-  return false;
-
-}
-
-
-[[nodiscard]]
 bool
-Tokenizer::match(char const *s, size_t slen)
+AttributeList::contains(std::string_view name) const
 {
-  return this->match_fn_(strncmp, s, slen);
+  return (this->find(name) != nullptr);
 }
 
 
-[[nodiscard]]
-bool
-Tokenizer::match_insensitive(char const *s, size_t slen)
+QueequegLib::BorrowedString const *
+AttributeList::find(std::string_view name) const
 {
-  return this->match_fn_(infra_ascii_strincmp, s, slen);
-}
+  if (this->size() > AttributeList::k_linear_max_
+   && ! this->name_hashes_.contains(QueequegLib::fnv1a(name)))
+    return nullptr;
 
+  for (auto const& attr : this->list_)
+    if (attr.name == name)
+      return &attr.value;
 
-void
-Tokenizer::error(char const *errstr)
-{
-  fputs(errstr, stderr);
-  fputc('\n', stderr);
-  fflush(stderr);
-}
-
-
-bool
-Tokenizer::have_appropriate_end_tag(void) const
-{
-  return (this->last_start_tag_name_.compare(this->tag.tag_name) == 0);
+  return nullptr;
 }
 
 
-void
-Tokenizer::flush_char_ref_codepoints(void)
+struct tag_attribute *
+AttributeList::append(QueequegLib::BorrowedString const& name)
 {
+  struct tag_attribute *attr = &this->list_.push_back({ .name = name, .value = { } });
 
-  for (char32_t ch : this->temp_buffer) {
-    if (this->is_char_ref_in_attr())
-      QueequegLib::append_c32_as_utf8(this->attr_value, ch);
-    else
-      this->emit_character(ch);
+  if (this->size() == AttributeList::k_linear_max_ + 1) {
+    for (auto const& other : this->list_)
+      this->name_hashes_.insert(QueequegLib::fnv1a(other.name));
+  } else if (this->size() > AttributeList::k_linear_max_) {
+    this->name_hashes_.insert(QueequegLib::fnv1a(name));
   }
 
+  return attr;
 }
 
 
 void
-Tokenizer::create_doctype(void)
-{
-  struct doctype_token *doctype = &this->doctype;
-
-  doctype->name.clear();
-  doctype->public_id.clear();
-  doctype->system_id.clear();
-
-  doctype->public_id_missing = false;
-  doctype->system_id_missing = false;
-  doctype->force_quirks_flag = false;
-
-}
-
-
-void
-Tokenizer::create_tag_(enum token_type tag_type)
+AttributeList::clear(void)
 {
-  struct tag_token *tag = &this->tag;
-
-  tag->tag_name.clear();
-  tag->local_name = 0;
-  tag->attributes.clear();
-  tag->self_closing_flag = false;
-  tag->ack_self_closing_flag_ = false;
-
-  this->tag_type = tag_type;
-}
-
-
-void
-Tokenizer::create_start_tag(void)
-{
-  this->create_tag_(TOKEN_START_TAG);
-}
-
-
-void
-Tokenizer::create_end_tag(void)
-{
-  this->create_tag_(TOKEN_END_TAG);
-}
-
-
-void
-Tokenizer::start_new_attr(void)
-{
-  this->attr_name.clear();
+  this->list_.clear();
+  this->name_hashes_.clear();
 }
 
 
 void
-Tokenizer::create_comment(std::string data)
+AttributeList::own(void)
 {
-  this->comment = data;
-}
-
-
-void
-Tokenizer::emit_token_(union token_data *token_data,
-                       enum token_type token_type)
-{
-  this->treebuilder->process_token(token_data, token_type);
-}
-
-
-static enum token_type
-character_token_type(char32_t ch)
-{
-  switch (ch) {
-    case '\t': case '\n': case '\f': case ' ':
-      return TOKEN_WHITESPACE;
-    default:
-      return TOKEN_CHARACTER;
+  for (auto& attr : this->list_) {
+    attr.name.own();
+    attr.value.own();
   }
 }
 
 
 void
-Tokenizer::emit_character(char32_t ch)
+tag_token::own(void)
 {
-#if 0
-  char buf[16] = { 0 };
-  grapheme_encode_utf8(ch, buf, sizeof (buf));
-
-  printf("emitting character '%s'\n", buf);
-#endif
-
-  this->emit_token_(reinterpret_cast<union token_data *>(&ch),
-                    character_token_type(ch));
+  this->tag_name.own();
+  this->attributes.own();
 }
 
 
-void
-Tokenizer::emit_current_doctype(void)
+[[nodiscard]]
+enum tokenizer_state
+guess_tokenizer_state_after(struct tag_token const *tag, bool scripting,
+                            enum tokenizer_state natural_state)
 {
-  struct doctype_token *doctype = &this->doctype;
-
-  this->emit_token_(reinterpret_cast<union token_data *>(doctype),
-                    TOKEN_DOCTYPE);
-}
+  switch (tag->local_name) {
+    case HTML_ELEMENT_TITLE:
+    case HTML_ELEMENT_TEXTAREA:
+      return RCDATA_STATE;
 
+    case HTML_ELEMENT_STYLE:   case HTML_ELEMENT_XMP:      case HTML_ELEMENT_IFRAME:
+    case HTML_ELEMENT_NOEMBED: case HTML_ELEMENT_NOFRAMES:
+      return RAWTEXT_STATE;
 
-void
-Tokenizer::attr_name_check_hook(void)
-{
-  if (this->tag.attributes.contains(this->attr_name)) {
-    this->error("duplicate-attribute");
-    return;
-  }
+    case HTML_ELEMENT_NOSCRIPT:
+      return scripting ? RAWTEXT_STATE : natural_state;
 
-  /*
-   * SIDE EFFECT: creates a new map entry
-   */
-  this->attr_value = &this->tag.attributes[this->attr_name];
-}
+    case HTML_ELEMENT_SCRIPT:
+      return SCRIPT_STATE;
 
+    case HTML_ELEMENT_PLAINTEXT:
+      return PLAINTEXT_STATE;
 
-void
-Tokenizer::emit_current_tag(void)
-{
-  struct tag_token *tag = &this->tag;
-
-  /*
-   * This step is only meant to speed up the parser when (re)processing tokens
-   * multiple times; it is cheaper to hash once than string-compare often.
-   */
-  if (HTML::k_local_names_table.contains(tag->tag_name)) {
-    tag->local_name = HTML::k_local_names_table.at(tag->tag_name);
-  } else if (Tokenizer::k_quirky_local_names_.contains(tag->tag_name)) {
-    /*
-     * When a tag token falling under this condition gets inserted, its temporary
-     * element index is ignored.
-     */
-    tag->local_name = Tokenizer::k_quirky_local_names_.at(tag->tag_name);
+    default:
+      return natural_state;
   }
-
-  LOGF("emitting %s tag with tag_name '%s', local_name %d\n",
-    (this->tag_type == TOKEN_START_TAG) ? "start" : "end",
-    tag->tag_name.c_str(), tag->local_name);
-
-  for (auto const& [k, v] : tag->attributes)
-    LOGF("  %s = %s\n", k.c_str(), v.c_str());
-
-  if (this->tag_type == TOKEN_START_TAG)
-    this->last_start_tag_name_ = tag->tag_name;
-
-  this->emit_token_(reinterpret_cast<union token_data *>(tag),
-                    this->tag_type);
 }
 
 
-void
-Tokenizer::emit_current_comment(void)
-{
-  std::string *comment = &this->comment;
-
-  this->emit_token_(reinterpret_cast<union token_data *>(comment),
-                    TOKEN_COMMENT);
-}
-
+#define X(sink) HTML_TOKENIZER_INSTANTIATE(sink);
 
-[[nodiscard]]
-enum tokenizer_status
-Tokenizer::emit_eof(void)
-{
-  this->emit_token_(static_cast<union token_data *>(nullptr),
-                    TOKEN_EOF);
-
-  return TOKENIZER_STATUS_EOF;
-}
-
-
-void
-Tokenizer::run(void)
-{
-  enum tokenizer_status status = TOKENIZER_STATUS_OK;
-
-
-  while (status != TOKENIZER_STATUS_EOF) {
-    char32_t ch;
-
-    switch (this->state) {
-      case MARKUP_DECL_OPEN_STATE:
-      case AFTER_DOCTYPE_NAME_STATE:
-      case AFTER_DOCTYPE_PUBLIC_KEYWORD_STATE:
-      case NUMERIC_CHAR_REF_END_STATE:
-        ch = {0xFFFD};
-        break;
-
-      default:
-        ch = this->getchar();
-        break;
-    }
-
-    do { status = Tokenizer::k_state_handlers_[this->state](this, ch); }
-      while (status == TOKENIZER_STATUS_RECONSUME);
-  }
-
-}
+TOKEN_SINKS(X)
 
+#undef X
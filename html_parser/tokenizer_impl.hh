@@ -0,0 +1,746 @@
+#ifndef _queequeg_html_parser_tokenizer_impl_hh_
+#define _queequeg_html_parser_tokenizer_impl_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/tokenizer_impl.hh
+ *
+ * Description:
+ * Definitions of the tokenizer's members (the state handlers are in
+ * html_parser/tokenizer_states.hh), for tokenizing into a sink of one's own
+ * (see TokenSink): one translation unit includes this and invokes
+ *
+ *   HTML_TOKENIZER_INSTANTIATE(MySink)
+ *
+ * at namespace scope, after which BasicTokenizer< MySink> can be used from
+ * anywhere (e.g. through html_tokenize()). The library does so for the sinks
+ * in TOKEN_SINKS. The generated build/html_parser/named_char_refs.hh has to be
+ * on the include path.
+ */
+
+#include <algorithm>
+
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <grapheme.h>
+#include <infra/ascii.h>
+#include <infra/string.h>
+
+#include "qglib/unicode.hh"
+#include "qglib/scan.hh"
+
+#include "html_parser/internal.hh"
+
+
+#if defined(HTML_PARSER_DEBUG)
+# define LOGF(...) \
+  fprintf(stderr, __VA_ARGS__)
+#endif
+
+
+static const struct {
+  std::string_view name;
+  uint16_t local_name;
+} k_quirky_local_names[3] = {
+  { "image", HTML_ELEMENT_IMG   },
+  { "math",  HTML_ELEMENT_MATH_ },
+  { "svg",   HTML_ELEMENT_SVG_  },
+};
+
+
+template< typename Sink>
+BasicTokenizer< Sink>::BasicTokenizer(void)
+{
+  this->input.final = false;
+  this->set_input_(nullptr, nullptr, 0);
+}
+
+
+template< typename Sink>
+BasicTokenizer< Sink>::BasicTokenizer(char const *input, size_t input_len, size_t input_offset)
+{
+  this->input.final = true;
+  this->set_input_(input, &input[input_len], input_offset);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::set_input_(char const *p, char const *end, size_t offset)
+{
+  this->input_begin_  = p;
+  this->input_offset_ = offset;
+
+  this->input.p   = p;
+  this->input.end = end;
+  this->input.cur = p;
+  this->input.invalid = QueequegLib::find_invalid_utf8(p, end);
+}
+
+
+template< typename Sink>
+BasicTokenizer< Sink>::~BasicTokenizer()
+{
+}
+
+
+template< typename Sink>
+[[nodiscard]]
+char32_t
+BasicTokenizer< Sink>::getchar(void)
+{
+  unsigned char const *s = reinterpret_cast<unsigned char const *>(this->input.p);
+  size_t left = this->input.end - this->input.p;
+  size_t read;
+  char32_t ch = {0xFFFD};
+
+
+  this->input.cur = this->input.p;
+
+  if (!left)
+    return this->input.final ? static_cast<char32_t>(-1) : BasicTokenizer::k_suspend;
+
+
+  if (s[0] < 0x80) {
+    if (s[0] == '\r') {
+      /* can't tell CRLF from CR yet */
+      if (left == 1 && ! this->input.final)
+        return BasicTokenizer::k_suspend;
+
+      /* CRLF and lone CR both become LF */
+      this->input.p += (left >= 2 && s[1] == '\n') ? 2 : 1;
+      return U'\n';
+    }
+
+    /* NUL included; libgrapheme was not designed for it anyway */
+    this->input.p += 1;
+    return s[0];
+  }
+
+
+  /*
+   * The input was validated up to input.invalid, so we can decode without
+   * looking at the continuation bytes twice.
+   */
+  if (this->input.p < this->input.invalid) {
+    if (s[0] < 0xE0) {
+      ch = (char32_t{s[0]} & 0x1F) << 6 | (s[1] & 0x3F);
+      read = 2;
+    } else if (s[0] < 0xF0) {
+      ch = (char32_t{s[0]} & 0x0F) << 12 | (s[1] & 0x3F) << 6 | (s[2] & 0x3F);
+      read = 3;
+    } else {
+      ch = (char32_t{s[0]} & 0x07) << 18 | (s[1] & 0x3F) << 12 | (s[2] & 0x3F) << 6 | (s[3] & 0x3F);
+      read = 4;
+    }
+
+    this->input.p += read;
+    return ch;
+  }
+
+
+  /*
+   * Ill-formed sequence: let libgrapheme decide how many bytes make up the
+   * U+FFFD, then validate up to the next one.
+   */
+  read = grapheme_decode_utf8(this->input.p, left, reinterpret_cast<uint_least32_t *>(&ch));
+
+  /*
+   * For a sequence cut short by the end of input, libgrapheme reports the
+   * length the sequence should have had
+   */
+  if (read > left) {
+    if (! this->input.final)
+      return BasicTokenizer::k_suspend;
+
+    read = left;
+  }
+
+  this->input.p += read;
+  this->input.invalid = QueequegLib::find_invalid_utf8(this->input.p, this->input.end);
+  return ch;
+}
+
+
+template< typename Sink>
+[[nodiscard]]
+bool
+BasicTokenizer< Sink>::match_fn_(int (*cmp) (char const *, char const *, size_t),
+                                 char const *s,
+                                 size_t slen)
+{
+  size_t left = this->input.end - this->input.p;
+
+
+  if (left < slen)
+    return false;
+
+
+  if (!cmp(this->input.p, s, slen)) {
+    this->input.p += slen;
+    return true;
+  }
+
+
+  return false;
+
+}
+
+
+template< typename Sink>
+[[nodiscard]]
+bool
+BasicTokenizer< Sink>::match(char const *s, size_t slen)
+{
+  return this->match_fn_(strncmp, s, slen);
+}
+
+
+template< typename Sink>
+[[nodiscard]]
+bool
+BasicTokenizer< Sink>::match_insensitive(char const *s, size_t slen)
+{
+  return this->match_fn_(infra_ascii_strincmp, s, slen);
+}
+
+
+/*
+ * Borrows the bytes c was decoded from if they spell out c verbatim, which is
+ * not the case after CRLF normalization or for replacement characters that
+ * stand in for invalid input.
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::append_current_char(QueequegLib::BorrowedString *str, char32_t c) const
+{
+  char buf[4];
+  size_t len = grapheme_encode_utf8(c, buf, sizeof (buf));
+
+
+  if (static_cast<size_t>(this->input.p - this->input.cur) == len
+   && !memcmp(this->input.cur, buf, len)) {
+    str->append_borrowed(this->input.cur, len);
+    return;
+  }
+
+  str->append(buf, len);
+}
+
+
+/*
+ * For the literal strings the spec has us re-append after the fact (e.g. the
+ * dashes of a comment): borrow them if they are what precedes the current
+ * character in the input.
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::append_lookbehind(QueequegLib::BorrowedString *str, std::string_view s) const
+{
+  char const *p = this->input.cur - s.size();
+
+  if (str->is_borrowed()
+   && (str->empty() || str->data() + str->size() == p)
+   && !memcmp(p, s.data(), s.size())) {
+    str->append_borrowed(p, s.size());
+    return;
+  }
+
+  str->append(s);
+}
+
+
+template< typename Sink>
+bool
+BasicTokenizer< Sink>::have_appropriate_end_tag(void) const
+{
+  return (this->last_start_tag_hash_ == this->tag_name_hash
+       && this->last_start_tag_name_ == this->tag.tag_name);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::flush_char_ref_codepoints(void)
+{
+
+  for (char32_t ch : this->temp_buffer) {
+    if (this->is_char_ref_in_attr())
+      this->attr_value->append_c32(ch);
+    else
+      this->emit_character(ch);
+  }
+
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::create_doctype(void)
+{
+  struct doctype_token *doctype = &this->doctype;
+
+  doctype->name.clear();
+  doctype->public_id.clear();
+  doctype->system_id.clear();
+
+  doctype->public_id_missing = false;
+  doctype->system_id_missing = false;
+  doctype->force_quirks_flag = false;
+
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::create_tag_(enum token_type tag_type)
+{
+  struct tag_token *tag = &this->tag;
+
+  tag->tag_name.clear();
+  this->tag_name_hash = QueequegLib::k_fnv1a_basis;
+  tag->local_name = 0;
+  tag->attributes.clear();
+  tag->self_closing_flag = false;
+  tag->ack_self_closing_flag_ = false;
+
+  this->tag_type = tag_type;
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::create_start_tag(void)
+{
+  this->create_tag_(TOKEN_START_TAG);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::create_end_tag(void)
+{
+  this->create_tag_(TOKEN_END_TAG);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::start_new_attr(void)
+{
+  this->attr_name.clear();
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::create_comment(std::string_view data)
+{
+  this->comment.clear();
+
+  if (!data.empty())
+    this->comment.append(data);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::emit_token_(union token_data *token_data,
+                                   enum token_type token_type)
+{
+  this->sink->process_token(token_data, token_type);
+}
+
+
+static inline enum token_type
+character_token_type(char32_t ch)
+{
+  switch (ch) {
+    case '\t': case '\n': case '\f': case ' ':
+      return TOKEN_WHITESPACE;
+    default:
+      return TOKEN_CHARACTER;
+  }
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::emit_character(char32_t ch)
+{
+#if 0
+  char buf[16] = { 0 };
+  grapheme_encode_utf8(ch, buf, sizeof (buf));
+
+  printf("emitting character '%s'\n", buf);
+#endif
+
+  this->emit_token_(reinterpret_cast<union token_data *>(&ch),
+                    character_token_type(ch));
+}
+
+
+/*
+ * The caller guarantees that the run contains neither NUL nor CR.
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::emit_character_run(char const *s, size_t len)
+{
+  std::string_view chars = { s, len };
+
+  this->emit_token_(reinterpret_cast<union token_data *>(&chars),
+                    TOKEN_CHARACTER_RUN);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::emit_current_doctype(void)
+{
+  struct doctype_token *doctype = &this->doctype;
+
+  this->emit_token_(reinterpret_cast<union token_data *>(doctype),
+                    TOKEN_DOCTYPE);
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::attr_name_check_hook(void)
+{
+  if (this->tag.attributes.contains(this->attr_name)) {
+    this->error(PARSE_ERROR_DUPLICATE_ATTRIBUTE);
+    this->discarded_attr_value_.clear();
+    this->attr_value = &this->discarded_attr_value_;
+    return;
+  }
+
+  this->attr_value = &this->tag.attributes.append(this->attr_name)->value;
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::emit_current_tag(void)
+{
+  struct tag_token *tag = &this->tag;
+
+  /*
+   * This step is only meant to speed up the parser when (re)processing tokens
+   * multiple times; it is cheaper to hash once than string-compare often.
+   */
+  tag->local_name = HTML::lookup_local_name(this->tag_name_hash, tag->tag_name);
+
+  if (tag->local_name == HTML_ELEMENT_NONE_) {
+    /*
+     * Whatever is still HTML_ELEMENT_NONE_ after this is named by the tree
+     * builder's document (see DOM::Document::intern_local_name).
+     */
+    for (auto const& quirky : k_quirky_local_names)
+      if (tag->tag_name == quirky.name)
+        tag->local_name = quirky.local_name;
+  }
+
+#if defined(HTML_PARSER_DEBUG)
+  LOGF("emitting %s tag with tag_name '%.*s', local_name %d\n",
+    (this->tag_type == TOKEN_START_TAG) ? "start" : "end",
+    static_cast<int>(tag->tag_name.size()), tag->tag_name.data(), tag->local_name);
+
+  for (auto const& [k, v] : tag->attributes)
+    LOGF("  %.*s = %.*s\n", static_cast<int>(k.size()), k.data(),
+                            static_cast<int>(v.size()), v.data());
+#endif
+
+  if (this->tag_type == TOKEN_START_TAG) {
+    this->last_start_tag_name_ = tag->tag_name;
+    this->last_start_tag_hash_ = this->tag_name_hash;
+  }
+
+  this->emit_token_(reinterpret_cast<union token_data *>(tag),
+                    this->tag_type);
+
+  if constexpr (requires { requires Sink::k_guesses_text_states; }) {
+    if (this->tag_type == TOKEN_START_TAG)
+      this->state = guess_tokenizer_state_after(tag, false, this->state);
+  }
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::emit_current_comment(void)
+{
+  QueequegLib::BorrowedString *comment = &this->comment;
+
+  this->emit_token_(reinterpret_cast<union token_data *>(comment),
+                    TOKEN_COMMENT);
+}
+
+
+template< typename Sink>
+[[nodiscard]]
+enum tokenizer_status
+BasicTokenizer< Sink>::emit_eof(void)
+{
+  this->emit_token_(static_cast<union token_data *>(nullptr),
+                    TOKEN_EOF);
+
+  return TOKENIZER_STATUS_EOF;
+}
+
+
+/*
+ * Fast path for the text states: instead of going through getchar() and the
+ * jump table for every single codepoint, skip ahead over the bytes the state
+ * handler would emit as-is anyway and hand them over as one character run.
+ * Whatever stops the scan (markup, character references, NUL, CR and
+ * non-ASCII input) is left for the regular handlers.
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::consume_text_run_(void)
+{
+  char const *run = this->input.p;
+  char const *run_end;
+
+  switch (this->state) {
+    case DATA_STATE:
+    case RCDATA_STATE:
+      run_end = QueequegLib::find_ascii_run_end<'<', '&', '\0', '\r'>(run, this->input.end);
+      break;
+
+    case RAWTEXT_STATE:
+    case SCRIPT_STATE:
+      run_end = QueequegLib::find_ascii_run_end<'<', '\0', '\r'>(run, this->input.end);
+      break;
+
+    case PLAINTEXT_STATE:
+      run_end = QueequegLib::find_ascii_run_end<'\0', '\r'>(run, this->input.end);
+      break;
+
+    default:
+      return;
+  }
+
+  if (run_end == run)
+    return;
+
+  this->input.cur = run;
+  this->input.p = run_end;
+  this->emit_character_run(run, run_end - run);
+}
+
+
+/*
+ * Runs until EOF, or until the current chunk runs dry
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::run(void)
+{
+#if defined(TOKENIZER_THREADED_DISPATCH)
+  this->run_threaded_();
+#else
+  enum tokenizer_status status = TOKENIZER_STATUS_OK;
+
+
+  while (status != TOKENIZER_STATUS_EOF) {
+    char32_t ch;
+
+    if (this->state <= PLAINTEXT_STATE)
+      this->consume_text_run_();
+
+    switch (this->state) {
+      case MARKUP_DECL_OPEN_STATE:
+      case AFTER_DOCTYPE_NAME_STATE:
+      case NUMERIC_CHAR_REF_END_STATE:
+        /* nothing consumed: errors point at what comes next */
+        this->input.cur = this->input.p;
+        ch = {0xFFFD};
+        break;
+
+      default:
+        ch = this->next_char_();
+        if (ch == BasicTokenizer::k_suspend)
+          return;
+        break;
+    }
+
+    do { status = BasicTokenizer::k_state_handlers_[this->state](this, ch); }
+      while (status == TOKENIZER_STATUS_RECONSUME);
+
+    if (status == TOKENIZER_STATUS_SUSPEND)
+      return;
+  }
+#endif
+
+}
+
+
+/*
+ * Token strings may still borrow from a chunk the caller is about to free
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::own_pending_strings_(void)
+{
+  this->doctype.name.own();
+  this->doctype.public_id.own();
+  this->doctype.system_id.own();
+
+  this->tag.own();
+  this->attr_name.own();
+  this->comment.own();
+  /* never read, and must not keep pointing into the old chunk */
+  this->discarded_attr_value_.clear();
+
+  this->last_start_tag_name_.own();
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::save_carry_(void)
+{
+  size_t offset = this->offset_of_(this->input.p);
+
+  this->own_pending_strings_();
+
+  this->carry_ = std::string(this->input.p, this->input.end);
+  this->set_input_(this->carry_.data(), this->carry_.data() + this->carry_.size(), offset);
+}
+
+
+/*
+ * Tokenizes as much of chunk as possible; it need not end on a character
+ * (let alone token) boundary, and is no longer referenced once this returns.
+ *
+ * Whatever could not be consumed yet (a partial UTF-8 sequence, CR, or less
+ * lookahead than markup declarations and character references need) is
+ * carried over. The next chunk then starts out on a copy of that tail plus
+ * its own first k_max_lookahead_ bytes, which is always enough to get past
+ * the tail and continue on the chunk itself.
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::feed(char const *chunk, size_t chunk_len)
+{
+  size_t chunk_offset = this->fed_;
+
+  this->fed_ += chunk_len;
+
+  if (! this->carry_.empty()) {
+    size_t carried = this->carry_.size();
+    size_t spliced = std::min(chunk_len, BasicTokenizer::k_max_lookahead_);
+
+    this->carry_.append(chunk, spliced);
+    this->set_input_(this->carry_.data(), this->carry_.data() + this->carry_.size(),
+                     chunk_offset - carried);
+    this->run();
+
+    size_t consumed = this->input.p - this->carry_.data();
+
+    if (consumed < carried || spliced == chunk_len) {
+      this->save_carry_();
+      this->carry_.append(chunk + spliced, chunk_len - spliced);
+      return;
+    }
+
+    this->own_pending_strings_();
+
+    chunk        += consumed - carried;
+    chunk_len    -= consumed - carried;
+    chunk_offset += consumed - carried;
+  }
+
+  this->set_input_(chunk, chunk + chunk_len, chunk_offset);
+  this->run();
+  this->save_carry_();
+}
+
+
+template< typename Sink>
+[[nodiscard]]
+struct tokenizer_checkpoint
+BasicTokenizer< Sink>::checkpoint(enum tokenizer_state state) const
+{
+  return {
+    .p                   = this->input.p,
+    .invalid             = this->input.invalid,
+    .state               = state,
+    .last_start_tag_name = this->last_start_tag_name_,
+    .last_start_tag_hash = this->last_start_tag_hash_,
+  };
+}
+
+
+/*
+ * Nothing else carries over from one token to the next in the states a
+ * checkpoint can be taken in. The input may have been validated past invalid
+ * UTF-8 the tokenizer has to go over again; validation goes on from where it
+ * stood at the checkpoint, which is immediate unless input_end lies further
+ * than the end the checkpoint was validated up to.
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::rewind(struct tokenizer_checkpoint const& checkpoint, char const *input_end)
+{
+  char const *validated = (checkpoint.invalid >= checkpoint.p)
+                        ? std::min(checkpoint.invalid, input_end)
+                        : checkpoint.p;
+
+  this->input.p   = checkpoint.p;
+  this->input.cur = checkpoint.p;
+  this->input.end = input_end;
+  this->input.invalid = QueequegLib::find_invalid_utf8(validated, input_end);
+
+  this->state = checkpoint.state;
+
+  this->last_start_tag_name_ = checkpoint.last_start_tag_name;
+  this->last_start_tag_hash_ = checkpoint.last_start_tag_hash;
+}
+
+
+/*
+ * The input was only validated up to the previous end
+ */
+template< typename Sink>
+void
+BasicTokenizer< Sink>::run_until(char const *end, bool final)
+{
+  this->input.end   = end;
+  this->input.final = final;
+  this->input.invalid = QueequegLib::find_invalid_utf8(this->input.p, end);
+
+  this->run();
+}
+
+
+template< typename Sink>
+void
+BasicTokenizer< Sink>::finish(void)
+{
+  this->input.final = true;
+  this->set_input_(this->carry_.data(), this->carry_.data() + this->carry_.size(),
+                   this->fed_ - this->carry_.size());
+  this->run();
+}
+
+
+#include "html_parser/tokenizer_states.hh"
+
+#undef LOGF
+
+
+#define HTML_TOKENIZER_INSTANTIATE(sink) \
+  static_assert(TokenSink< sink>); \
+  template class BasicTokenizer< sink>
+
+
+#endif /* !defined(_queequeg_html_parser_tokenizer_impl_hh_) */
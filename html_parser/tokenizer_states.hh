@@ -1,3 +1,6 @@
+#ifndef _queequeg_html_parser_tokenizer_states_hh_
+#define _queequeg_html_parser_tokenizer_states_hh_
+
 /*
  * Copyright (c) 2024 Adrien Ricciardi
  *
@@ -7,28 +10,29 @@
  * See LICENSE for details
  *
  *
- * File: html_parser/tokenizer_states.cc
+ * File: html_parser/tokenizer_states.hh
  *
  *
  *  Description:
  *
  * This file implements handlers for the states of the HTML tokenizer. They are
  * grouped together in a jump table (Tokenizer::k_state_handlers_) and accessed
- * by the tokenizer main loop from there correspondingly.
+ * by the tokenizer main loop from there correspondingly, or inlined into the
+ * threaded engine (Tokenizer::run_threaded_()) if TOKENIZER_THREADED_DISPATCH
+ * is defined.
  *
- * When a state emits tokens, they are immediately processed by the connected
- * TreeBuilder instance.
+ * When a state emits tokens, they are immediately handed to the tokenizer's
+ * sink (see TokenSink); the handlers are instantiated for each sink, along
+ * with the rest of the tokenizer (see html_parser/tokenizer_impl.hh).
  *
  *
  *  TODO:
- * - Handle named character references properly
  * - Scripting support
  */
 #include <unordered_map>
 
 #include <stdio.h>
 
-#define INFRA_SHORT_NAMES
 #include <infra/util.h>
 #include <infra/ascii.h>
 #include <infra/unicode.h>
@@ -39,8 +43,9 @@
 
 
 
+template< typename Sink>
 static enum tokenizer_status
-data_state(Tokenizer *tokenizer, char32_t c)
+data_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '&':
@@ -53,7 +58,7 @@ data_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(c);
       return TOKENIZER_STATUS_OK;
 
@@ -67,8 +72,9 @@ data_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rcdata_state(Tokenizer *tokenizer, char32_t c)
+rcdata_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '&':
@@ -81,7 +87,7 @@ rcdata_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
@@ -95,8 +101,9 @@ rcdata_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rawtext_state(Tokenizer *tokenizer, char32_t c)
+rawtext_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '<':
@@ -104,7 +111,7 @@ rawtext_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
@@ -118,8 +125,9 @@ rawtext_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_state(Tokenizer *tokenizer, char32_t c)
+script_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '<':
@@ -127,7 +135,7 @@ script_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
@@ -141,12 +149,13 @@ script_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-plaintext_state(Tokenizer *tokenizer, char32_t c)
+plaintext_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
@@ -160,10 +169,11 @@ plaintext_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-tag_open_state(Tokenizer *tokenizer, char32_t c)
+tag_open_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->create_start_tag();
     tokenizer->state = TAG_NAME_STATE;
     return TOKENIZER_STATUS_RECONSUME;
@@ -179,18 +189,18 @@ tag_open_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '?':
-      tokenizer->error("unexpected-question-mark-instead-of-tag-name");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_QUESTION_MARK_INSTEAD_OF_TAG_NAME);
       tokenizer->create_comment();
       tokenizer->state = BOGUS_COMMENT_STATE;
       return TOKENIZER_STATUS_RECONSUME;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-before-tag-name");
+      tokenizer->error(PARSE_ERROR_EOF_BEFORE_TAG_NAME);
       tokenizer->emit_character('<');
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("invalid-first-character-of-tag-name");
+      tokenizer->error(PARSE_ERROR_INVALID_FIRST_CHARACTER_OF_TAG_NAME);
       tokenizer->emit_character('<');
       tokenizer->state = DATA_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -198,10 +208,11 @@ tag_open_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-end_tag_open_state(Tokenizer *tokenizer, char32_t c)
+end_tag_open_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->create_end_tag();
     tokenizer->state = TAG_NAME_STATE;
     return TOKENIZER_STATUS_RECONSUME;
@@ -209,18 +220,18 @@ end_tag_open_state(Tokenizer *tokenizer, char32_t c)
 
   switch (c) {
     case '>':
-      tokenizer->error("missing-end-tag-name");
+      tokenizer->error(PARSE_ERROR_MISSING_END_TAG_NAME);
       tokenizer->state = DATA_STATE;
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-before-tag-name");
+      tokenizer->error(PARSE_ERROR_EOF_BEFORE_TAG_NAME);
       tokenizer->emit_character('<');
       tokenizer->emit_character('/');
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("invalid-first-character-of-tag-name");
+      tokenizer->error(PARSE_ERROR_INVALID_FIRST_CHARACTER_OF_TAG_NAME);
       tokenizer->create_comment();
       tokenizer->state = BOGUS_COMMENT_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -228,11 +239,12 @@ end_tag_open_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-tag_name_state(Tokenizer *tokenizer, char32_t c)
+tag_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->append_tag_name(c|0x20);
     return TOKENIZER_STATUS_OK;
   }
 
@@ -251,23 +263,24 @@ tag_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->append_tag_name(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c);
+      tokenizer->append_tag_name(c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rcdata_lt_state(Tokenizer *tokenizer, char32_t c)
+rcdata_lt_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '/':
@@ -283,10 +296,11 @@ rcdata_lt_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rcdata_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
+rcdata_end_tag_open_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->create_end_tag();
     tokenizer->state = RCDATA_END_TAG_NAME_STATE;
     return TOKENIZER_STATUS_RECONSUME;
@@ -301,17 +315,18 @@ rcdata_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rcdata_end_tag_name_state(Tokenizer *tokenizer, char32_t c)
+rcdata_end_tag_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->append_tag_name(c|0x20);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c);
+  if (infra_ascii_is_lower_alpha(c)) {
+    tokenizer->append_tag_name(c);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
@@ -350,8 +365,9 @@ anything_else:
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rawtext_lt_state(Tokenizer *tokenizer, char32_t c)
+rawtext_lt_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '/':
@@ -367,10 +383,11 @@ rawtext_lt_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rawtext_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
+rawtext_end_tag_open_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->create_end_tag();
     tokenizer->state = RAWTEXT_END_TAG_NAME_STATE;
     return TOKENIZER_STATUS_OK;
@@ -384,17 +401,18 @@ rawtext_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-rawtext_end_tag_name_state(Tokenizer *tokenizer, char32_t c)
+rawtext_end_tag_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->append_tag_name(c|0x20);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c);
+  if (infra_ascii_is_lower_alpha(c)) {
+    tokenizer->append_tag_name(c);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
@@ -433,8 +451,9 @@ anything_else:
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_lt_state(Tokenizer *tokenizer, char32_t c)
+script_lt_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '/':
@@ -456,10 +475,11 @@ script_lt_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
+script_end_tag_open_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->create_end_tag();
     tokenizer->state = SCRIPT_END_TAG_NAME_STATE;
     return TOKENIZER_STATUS_RECONSUME;
@@ -474,17 +494,18 @@ script_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_end_tag_name_state(Tokenizer *tokenizer, char32_t c)
+script_end_tag_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->append_tag_name(c|0x20);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c);
+  if (infra_ascii_is_lower_alpha(c)) {
+    tokenizer->append_tag_name(c);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
@@ -523,8 +544,9 @@ script_end_tag_name_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escape_start_state(Tokenizer *tokenizer, char32_t c)
+script_escape_start_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -539,8 +561,9 @@ script_escape_start_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escape_start_dash_state(Tokenizer *tokenizer, char32_t c)
+script_escape_start_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -555,8 +578,9 @@ script_escape_start_dash_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escaped_state(Tokenizer *tokenizer, char32_t c)
+script_escaped_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -569,12 +593,12 @@ script_escaped_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-script-html-comment-like-text");
+      tokenizer->error(PARSE_ERROR_EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT);
       return tokenizer->emit_eof();
 
     default:
@@ -584,8 +608,9 @@ script_escaped_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escaped_dash_state(Tokenizer *tokenizer, char32_t c)
+script_escaped_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -598,13 +623,13 @@ script_escaped_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->state = SCRIPT_ESCAPED_STATE;
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-script-html-comment-like-text");
+      tokenizer->error(PARSE_ERROR_EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT);
       return tokenizer->emit_eof();
 
     default:
@@ -615,8 +640,9 @@ script_escaped_dash_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escaped_dash_dash_state(Tokenizer *tokenizer, char32_t c)
+script_escaped_dash_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -633,13 +659,13 @@ script_escaped_dash_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->state = SCRIPT_ESCAPED_STATE;
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-script-html-comment-like-text");
+      tokenizer->error(PARSE_ERROR_EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT);
       return tokenizer->emit_eof();
 
     default:
@@ -650,10 +676,11 @@ script_escaped_dash_dash_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escaped_lt_state(Tokenizer *tokenizer, char32_t c)
+script_escaped_lt_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->temp_buffer.clear();
     tokenizer->emit_character('<');
     tokenizer->state = SCRIPT_DOUBLE_ESCAPE_START_STATE;
@@ -674,10 +701,11 @@ script_escaped_lt_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escaped_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
+script_escaped_end_tag_open_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alpha(c)) {
+  if (infra_ascii_is_alpha(c)) {
     tokenizer->create_end_tag();
     tokenizer->state = SCRIPT_ESCAPED_END_TAG_NAME_STATE;
     return TOKENIZER_STATUS_RECONSUME;
@@ -692,17 +720,18 @@ script_escaped_end_tag_open_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_escaped_end_tag_name_state(Tokenizer *tokenizer, char32_t c)
+script_escaped_end_tag_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->append_tag_name(c|0x20);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c);
+  if (infra_ascii_is_lower_alpha(c)) {
+    tokenizer->append_tag_name(c);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
@@ -741,17 +770,18 @@ anything_else:
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_double_escape_start_state(Tokenizer *tokenizer, char32_t c)
+script_double_escape_start_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->append_tag_name(c|0x20);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->tag.tag_name, c);
+  if (infra_ascii_is_lower_alpha(c)) {
+    tokenizer->append_tag_name(c);
     tokenizer->temp_buffer.push_back(c);
     return TOKENIZER_STATUS_OK;
   }
@@ -772,8 +802,9 @@ script_double_escape_start_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_double_escaped_state(Tokenizer *tokenizer, char32_t c)
+script_double_escaped_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -787,12 +818,12 @@ script_double_escaped_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-script-html-comment-like-text");
+      tokenizer->error(PARSE_ERROR_EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT);
       return tokenizer->emit_eof();
 
     default:
@@ -802,8 +833,9 @@ script_double_escaped_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_double_escaped_dash_state(Tokenizer *tokenizer, char32_t c)
+script_double_escaped_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -817,13 +849,13 @@ script_double_escaped_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->state = SCRIPT_DOUBLE_ESCAPED_STATE;
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-script-html-comment-like-text");
+      tokenizer->error(PARSE_ERROR_EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT);
       return tokenizer->emit_eof();
 
     default:
@@ -834,8 +866,9 @@ script_double_escaped_dash_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_double_escaped_dash_dash_state(Tokenizer *tokenizer, char32_t c)
+script_double_escaped_dash_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -853,13 +886,13 @@ script_double_escaped_dash_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->state = SCRIPT_DOUBLE_ESCAPED_STATE;
       tokenizer->emit_character(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-script-html-comment-like-text");
+      tokenizer->error(PARSE_ERROR_EOF_IN_SCRIPT_HTML_COMMENT_LIKE_TEXT);
       return tokenizer->emit_eof();
 
     default:
@@ -870,8 +903,9 @@ script_double_escaped_dash_dash_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_double_escaped_lt_state(Tokenizer *tokenizer, char32_t c)
+script_double_escaped_lt_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '/':
@@ -887,16 +921,17 @@ script_double_escaped_lt_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-script_double_escape_end_state(Tokenizer *tokenizer, char32_t c)
+script_double_escape_end_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
+  if (infra_ascii_is_upper_alpha(c)) {
     tokenizer->temp_buffer.push_back(c|0x20);
     tokenizer->emit_character(c);
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_alpha(c)) {
+  if (infra_ascii_is_lower_alpha(c)) {
     tokenizer->temp_buffer.push_back(c);
     tokenizer->emit_character(c);
     return TOKENIZER_STATUS_OK;
@@ -918,8 +953,9 @@ script_double_escape_end_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-before_attr_name_state(Tokenizer *tokenizer, char32_t c)
+before_attr_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -930,9 +966,9 @@ before_attr_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_RECONSUME;
 
     case '=':
-      tokenizer->error("unexpected-equals-sign-before-attribute-name");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_EQUALS_SIGN_BEFORE_ATTRIBUTE_NAME);
       tokenizer->start_new_attr();
-      QueequegLib::append_c32_as_utf8(&tokenizer->attr_name, c);
+      tokenizer->append_current_char(&tokenizer->attr_name, c);
       tokenizer->state = ATTR_NAME_STATE;
       return TOKENIZER_STATUS_OK;
 
@@ -944,11 +980,12 @@ before_attr_name_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-attr_name_state(Tokenizer *tokenizer, char32_t c)
+attr_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->attr_name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->attr_name.append_c32(c|0x20);
     return TOKENIZER_STATUS_OK;
   }
 
@@ -965,23 +1002,24 @@ attr_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->attr_name, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->attr_name.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case '\"': case '\'': case '<':
-      tokenizer->error("unexpected-character-in-attribute-name");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_CHARACTER_IN_ATTRIBUTE_NAME);
       [[fallthrough]];
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->attr_name, c);
+      tokenizer->append_current_char(&tokenizer->attr_name, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-after_attr_name_state(Tokenizer *tokenizer, char32_t c)
+after_attr_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1001,7 +1039,7 @@ after_attr_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     default:
@@ -1012,8 +1050,9 @@ after_attr_name_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-before_attr_value_state(Tokenizer *tokenizer, char32_t c)
+before_attr_value_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1028,7 +1067,7 @@ before_attr_value_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("missing-attribute-value");
+      tokenizer->error(PARSE_ERROR_MISSING_ATTRIBUTE_VALUE);
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_tag();
       return TOKENIZER_STATUS_OK;
@@ -1040,8 +1079,9 @@ before_attr_value_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-attr_value_double_quoted_state(Tokenizer *tokenizer, char32_t c)
+attr_value_double_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\"':
@@ -1054,24 +1094,25 @@ attr_value_double_quoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->attr_value->append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, c);
+      tokenizer->append_current_char(tokenizer->attr_value, c);
       return TOKENIZER_STATUS_OK;
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-attr_value_single_quoted_state(Tokenizer *tokenizer, char32_t c)
+attr_value_single_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\'':
@@ -1080,26 +1121,28 @@ attr_value_single_quoted_state(Tokenizer *tokenizer, char32_t c)
 
     case '&':
       tokenizer->ret_state = ATTR_VALUE_SINGLE_QUOTED_STATE;
+      tokenizer->state     = CHAR_REF_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->attr_value->append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, c);
+      tokenizer->append_current_char(tokenizer->attr_value, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-attr_value_unquoted_state(Tokenizer *tokenizer, char32_t c)
+attr_value_unquoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1117,27 +1160,28 @@ attr_value_unquoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->attr_value->append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     case '\"': case '\'': case '<': case '=': case '`':
-      tokenizer->error("unexpected-character-in-unquoted-attribute-value");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_CHARACTER_IN_UNQUOTED_ATTRIBUTE_VALUE);
       [[fallthrough]];
 
     default:
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, c);
+      tokenizer->append_current_char(tokenizer->attr_value, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-after_attr_value_quoted_state(Tokenizer *tokenizer, char32_t c)
+after_attr_value_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1154,19 +1198,20 @@ after_attr_value_quoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-whitespace-between-attributes");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_BETWEEN_ATTRIBUTES);
       tokenizer->state = BEFORE_ATTR_NAME_STATE;
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-self_closing_start_tag_state(Tokenizer *tokenizer, char32_t c)
+self_closing_start_tag_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '>':
@@ -1176,19 +1221,20 @@ self_closing_start_tag_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-tag");
+      tokenizer->error(PARSE_ERROR_EOF_IN_TAG);
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("unexpected-solidus-in-tag");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_SOLIDUS_IN_TAG);
       tokenizer->state = BEFORE_ATTR_NAME_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-bogus_comment_state(Tokenizer *tokenizer, char32_t c)
+bogus_comment_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '>':
@@ -1201,20 +1247,24 @@ bogus_comment_state(Tokenizer *tokenizer, char32_t c)
       return tokenizer->emit_eof();
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->comment.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, c);
+      tokenizer->append_current_char(&tokenizer->comment, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-markup_decl_open_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
+markup_decl_open_state(BasicTokenizer< Sink> *tokenizer, [[maybe_unused]] char32_t c)
 {
+  if (tokenizer->need_input(strlen("[CDATA[")))
+    return TOKENIZER_STATUS_SUSPEND;
+
   if (tokenizer->match("--")) {
     tokenizer->create_comment();
     tokenizer->state = COMMENT_START_STATE;
@@ -1227,14 +1277,13 @@ markup_decl_open_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
   }
 
   if (tokenizer->match("[CDATA[")) {
-    const std::shared_ptr< DOM::Element> node = tokenizer->treebuilder->adjusted_current_node();
-
-    if (node != nullptr && node->name_space != INFRA_NAMESPACE_HTML) {
+    /* "[CDATA[" was just consumed */
+    if (tokenizer->sink->allows_cdata_section()) {
       tokenizer->state = CDATA_SECTION_STATE;
       return TOKENIZER_STATUS_OK;
     }
 
-    tokenizer->error("cdata-in-html-content");
+    tokenizer->error(PARSE_ERROR_CDATA_IN_HTML_CONTENT);
     tokenizer->create_comment("[CDATA[");
     tokenizer->state = BOGUS_COMMENT_STATE;
 
@@ -1242,7 +1291,7 @@ markup_decl_open_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
   }
 
   {
-    tokenizer->error("incorrectly-opened-comment");
+    tokenizer->error(PARSE_ERROR_INCORRECTLY_OPENED_COMMENT);
     tokenizer->create_comment();
     tokenizer->state = BOGUS_COMMENT_STATE;
     return TOKENIZER_STATUS_OK;
@@ -1250,8 +1299,9 @@ markup_decl_open_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_start_state(Tokenizer *tokenizer, char32_t c)
+comment_start_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -1259,7 +1309,7 @@ comment_start_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("abrupt-closing-of-empty-comment");
+      tokenizer->error(PARSE_ERROR_ABRUPT_CLOSING_OF_EMPTY_COMMENT);
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_comment();
       return TOKENIZER_STATUS_OK;
@@ -1271,8 +1321,9 @@ comment_start_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_start_dash_state(Tokenizer *tokenizer, char32_t c)
+comment_start_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -1280,30 +1331,31 @@ comment_start_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("abrupt-closing-of-empty-comment");
+      tokenizer->error(PARSE_ERROR_ABRUPT_CLOSING_OF_EMPTY_COMMENT);
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_comment();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-comment");
+      tokenizer->error(PARSE_ERROR_EOF_IN_COMMENT);
       tokenizer->emit_current_comment();
       return TOKENIZER_STATUS_OK;
 
     default:
-      tokenizer->comment.append("-");
+      tokenizer->append_lookbehind(&tokenizer->comment, "-");
       tokenizer->state = COMMENT_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_state(Tokenizer *tokenizer, char32_t c)
+comment_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '<':
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, c);
+      tokenizer->append_current_char(&tokenizer->comment, c);
       tokenizer->state = COMMENT_LT_STATE;
       return TOKENIZER_STATUS_OK;
 
@@ -1312,32 +1364,33 @@ comment_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->comment.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-comment");
+      tokenizer->error(PARSE_ERROR_EOF_IN_COMMENT);
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, c);
+      tokenizer->append_current_char(&tokenizer->comment, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_lt_state(Tokenizer *tokenizer, char32_t c)
+comment_lt_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '!':
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, c);
+      tokenizer->append_current_char(&tokenizer->comment, c);
       tokenizer->state = COMMENT_LT_BANG_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '<':
-      QueequegLib::append_c32_as_utf8(&tokenizer->comment, c);
+      tokenizer->append_current_char(&tokenizer->comment, c);
       return TOKENIZER_STATUS_OK;
 
     default:
@@ -1347,8 +1400,9 @@ comment_lt_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_lt_bang_state(Tokenizer *tokenizer, char32_t c)
+comment_lt_bang_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -1362,8 +1416,9 @@ comment_lt_bang_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_lt_bang_dash_state(Tokenizer *tokenizer, char32_t c)
+comment_lt_bang_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -1377,8 +1432,9 @@ comment_lt_bang_dash_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_lt_bang_dash_dash_state(Tokenizer *tokenizer, char32_t c)
+comment_lt_bang_dash_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '>': case static_cast<char32_t>(-1):
@@ -1386,15 +1442,16 @@ comment_lt_bang_dash_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_RECONSUME;
 
     default:
-      tokenizer->error("nested-comment");
+      tokenizer->error(PARSE_ERROR_NESTED_COMMENT);
       tokenizer->state = COMMENT_END_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_end_dash_state(Tokenizer *tokenizer, char32_t c)
+comment_end_dash_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
@@ -1402,20 +1459,21 @@ comment_end_dash_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-comment");
+      tokenizer->error(PARSE_ERROR_EOF_IN_COMMENT);
       tokenizer->emit_current_comment();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->comment.append("-");
+      tokenizer->append_lookbehind(&tokenizer->comment, "-");
       tokenizer->state = COMMENT_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_end_state(Tokenizer *tokenizer, char32_t c)
+comment_end_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '>':
@@ -1428,52 +1486,54 @@ comment_end_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '-':
-      tokenizer->comment.append("-");
+      tokenizer->append_lookbehind(&tokenizer->comment, "-");
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-comment");
+      tokenizer->error(PARSE_ERROR_EOF_IN_COMMENT);
       tokenizer->emit_current_comment();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->comment.append("--");
+      tokenizer->append_lookbehind(&tokenizer->comment, "--");
       tokenizer->state = COMMENT_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-comment_end_bang_state(Tokenizer *tokenizer, char32_t c)
+comment_end_bang_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '-':
-      tokenizer->comment.append("--!");
+      tokenizer->append_lookbehind(&tokenizer->comment, "--!");
       tokenizer->state = COMMENT_END_DASH_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("incorrectly-closed-comment");
+      tokenizer->error(PARSE_ERROR_INCORRECTLY_CLOSED_COMMENT);
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_comment();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-comment");
+      tokenizer->error(PARSE_ERROR_EOF_IN_COMMENT);
       tokenizer->emit_current_comment();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->comment.append("--!");
+      tokenizer->append_lookbehind(&tokenizer->comment, "--!");
       tokenizer->state = COMMENT_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-doctype_state(Tokenizer *tokenizer, char32_t c)
+doctype_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1485,24 +1545,25 @@ doctype_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_RECONSUME;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-whitespace-before-doctype-name");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_BEFORE_DOCTYPE_NAME);
       tokenizer->state = BEFORE_DOCTYPE_NAME_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-before_doctype_name_state(Tokenizer *tokenizer, char32_t c)
+before_doctype_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
+  if (infra_ascii_is_upper_alpha(c)) {
     tokenizer->create_doctype();
-    QueequegLib::append_c32_as_utf8(&tokenizer->doctype.name, c|0x20);
+    tokenizer->doctype.name.append_c32(c|0x20);
     tokenizer->state = DOCTYPE_NAME_STATE;
     return TOKENIZER_STATUS_OK;
   }
@@ -1512,14 +1573,14 @@ before_doctype_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       tokenizer->create_doctype();
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.name, 0xFFFD);
+      tokenizer->doctype.name.append_c32(0xFFFD);
       tokenizer->state = DOCTYPE_NAME_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("missing-doctype-name-state");
+      tokenizer->error(PARSE_ERROR_MISSING_DOCTYPE_NAME);
       tokenizer->create_doctype();
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
@@ -1527,7 +1588,7 @@ before_doctype_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->create_doctype();
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
@@ -1535,18 +1596,19 @@ before_doctype_name_state(Tokenizer *tokenizer, char32_t c)
 
     default:
       tokenizer->create_doctype();
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.name, c);
+      tokenizer->append_current_char(&tokenizer->doctype.name, c);
       tokenizer->state = DOCTYPE_NAME_STATE;
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-doctype_name_state(Tokenizer *tokenizer, char32_t c)
+doctype_name_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_upper_alpha(c)) {
-    QueequegLib::append_c32_as_utf8(&tokenizer->doctype.name, c|0x20);
+  if (infra_ascii_is_upper_alpha(c)) {
+    tokenizer->doctype.name.append_c32(c|0x20);
     return TOKENIZER_STATUS_OK;
   }
 
@@ -1561,26 +1623,33 @@ doctype_name_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.name, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->doctype.name.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.name, c);
+      tokenizer->append_current_char(&tokenizer->doctype.name, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-after_doctype_name_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
+after_doctype_name_state(BasicTokenizer< Sink> *tokenizer, [[maybe_unused]] char32_t c)
 {
+  /*
+   * also guarantees that the getchar() below won't run out of input
+   */
+  if (tokenizer->need_input(strlen("PUBLIC")))
+    return TOKENIZER_STATUS_SUSPEND;
+
   if (tokenizer->match_insensitive("PUBLIC")) {
     tokenizer->state = AFTER_DOCTYPE_PUBLIC_KEYWORD_STATE;
     return TOKENIZER_STATUS_OK;
@@ -1601,13 +1670,13 @@ after_doctype_name_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
       return TOKENIZER_STATUS_OK; 
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("invalid-character-sequence-after-doctype-name");
+      tokenizer->error(PARSE_ERROR_INVALID_CHARACTER_SEQUENCE_AFTER_DOCTYPE_NAME);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1615,8 +1684,9 @@ after_doctype_name_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-after_doctype_public_keyword_state(Tokenizer *tokenizer, char32_t c)
+after_doctype_public_keyword_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1624,32 +1694,32 @@ after_doctype_public_keyword_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\"':
-      tokenizer->error("missing-whitespace-after-doctype-public-keyword");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_AFTER_DOCTYPE_PUBLIC_KEYWORD);
       tokenizer->doctype.public_id_missing = false;
       tokenizer->state = DOCTYPE_PUBLIC_ID_DOUBLE_QUOTED_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '\'':
-      tokenizer->error("missing-whitespace-after-doctype-public-keyword");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_AFTER_DOCTYPE_PUBLIC_KEYWORD);
       tokenizer->doctype.public_id_missing = false;
       tokenizer->state = DOCTYPE_PUBLIC_ID_SINGLE_QUOTED_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("missing-doctype-public-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_DOCTYPE_PUBLIC_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-quote-before-doctype-public-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_QUOTE_BEFORE_DOCTYPE_PUBLIC_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1657,8 +1727,9 @@ after_doctype_public_keyword_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-before_doctype_public_id_state(Tokenizer *tokenizer, char32_t c)
+before_doctype_public_id_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1675,20 +1746,20 @@ before_doctype_public_id_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("missing-doctype-public-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_DOCTYPE_PUBLIC_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = false;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = false;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-quote-before-doctype-public-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_QUOTE_BEFORE_DOCTYPE_PUBLIC_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = false;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1696,8 +1767,9 @@ before_doctype_public_id_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-doctype_public_id_double_quoted_state(Tokenizer *tokenizer, char32_t c)
+doctype_public_id_double_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\"':
@@ -1705,32 +1777,33 @@ doctype_public_id_double_quoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.public_id, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->doctype.public_id.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("abrupt-doctype-public-identifier");
+      tokenizer->error(PARSE_ERROR_ABRUPT_DOCTYPE_PUBLIC_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.public_id, c);
+      tokenizer->append_current_char(&tokenizer->doctype.public_id, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-doctype_public_id_single_quoted_state(Tokenizer *tokenizer, char32_t c)
+doctype_public_id_single_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\'':
@@ -1738,30 +1811,31 @@ doctype_public_id_single_quoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.public_id, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->doctype.public_id.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("abrupt-doctype-public-identifier");
+      tokenizer->error(PARSE_ERROR_ABRUPT_DOCTYPE_PUBLIC_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       return tokenizer->emit_eof();
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.public_id, c);
+      tokenizer->append_current_char(&tokenizer->doctype.public_id, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
+template< typename Sink>
 static enum tokenizer_status
-after_doctype_public_id_state(Tokenizer *tokenizer, char32_t c)
+after_doctype_public_id_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1774,26 +1848,24 @@ after_doctype_public_id_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\"':
-      tokenizer->error(
-       "missing-whitespace-between-doctype-public-and-system-identifiers");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_BETWEEN_DOCTYPE_PUBLIC_AND_SYSTEM_IDENTIFIERS);
       tokenizer->doctype.system_id_missing = false;
       tokenizer->state = DOCTYPE_SYSTEM_ID_DOUBLE_QUOTED_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '\'':
-      tokenizer->error(
-       "missing-whitespace-between-doctype-public-and-system-identifiers");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_BETWEEN_DOCTYPE_PUBLIC_AND_SYSTEM_IDENTIFIERS);
       tokenizer->doctype.system_id_missing = false;
       tokenizer->state = DOCTYPE_SYSTEM_ID_SINGLE_QUOTED_STATE;
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
     default:
-      tokenizer->error("missing-quote-before-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_QUOTE_BEFORE_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1801,8 +1873,9 @@ after_doctype_public_id_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-between_doctype_public_system_ids_state(Tokenizer *tokenizer, char32_t c)
+between_doctype_public_system_ids_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1824,13 +1897,13 @@ between_doctype_public_system_ids_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-quote-before-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_QUOTE_BEFORE_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1838,8 +1911,9 @@ between_doctype_public_system_ids_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-after_doctype_system_keyword_state(Tokenizer *tokenizer, char32_t c)
+after_doctype_system_keyword_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1847,32 +1921,32 @@ after_doctype_system_keyword_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\"':
-      tokenizer->error("missing-whitespace-after-doctype-system-keyword");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_AFTER_DOCTYPE_SYSTEM_KEYWORD);
       tokenizer->doctype.system_id_missing = false;
       tokenizer->state = DOCTYPE_SYSTEM_ID_DOUBLE_QUOTED_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '\'':
-      tokenizer->error("missing-whitespace-after-doctype-system-keyword");
+      tokenizer->error(PARSE_ERROR_MISSING_WHITESPACE_AFTER_DOCTYPE_SYSTEM_KEYWORD);
       tokenizer->doctype.system_id_missing = false;
       tokenizer->state = DOCTYPE_SYSTEM_ID_SINGLE_QUOTED_STATE;
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("missing-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-quote-before-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_QUOTE_BEFORE_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1880,8 +1954,9 @@ after_doctype_system_keyword_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-before_doctype_system_id_state(Tokenizer *tokenizer, char32_t c)
+before_doctype_system_id_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1898,20 +1973,20 @@ before_doctype_system_id_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("missing-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("missing-quote-before-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_MISSING_QUOTE_BEFORE_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
@@ -1919,8 +1994,9 @@ before_doctype_system_id_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-doctype_system_id_double_quoted_state(Tokenizer *tokenizer, char32_t c)
+doctype_system_id_double_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\"':
@@ -1928,32 +2004,33 @@ doctype_system_id_double_quoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.system_id, c);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->doctype.system_id.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("abrupt-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_ABRUPT_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.system_id, c);
+      tokenizer->append_current_char(&tokenizer->doctype.system_id, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-doctype_system_id_single_quoted_state(Tokenizer *tokenizer, char32_t c)
+doctype_system_id_single_quoted_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\'':
@@ -1961,32 +2038,33 @@ doctype_system_id_single_quoted_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.system_id, 0xFFFD);
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
+      tokenizer->doctype.system_id.append_c32(0xFFFD);
       return TOKENIZER_STATUS_OK;
 
     case '>':
-      tokenizer->error("abrupt-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_ABRUPT_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->state = DATA_STATE;
       tokenizer->emit_current_doctype();
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      QueequegLib::append_c32_as_utf8(&tokenizer->doctype.system_id, c);
+      tokenizer->append_current_char(&tokenizer->doctype.system_id, c);
       return TOKENIZER_STATUS_OK;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-after_doctype_system_id_state(Tokenizer *tokenizer, char32_t c)
+after_doctype_system_id_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '\t': case '\n': case '\f': case ' ':
@@ -1998,21 +2076,22 @@ after_doctype_system_id_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-doctype");
+      tokenizer->error(PARSE_ERROR_EOF_IN_DOCTYPE);
       tokenizer->doctype.force_quirks_flag = true;
       tokenizer->emit_current_doctype();
       return tokenizer->emit_eof();
 
     default:
-      tokenizer->error("unexpected-character-after-doctype-system-identifier");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_CHARACTER_AFTER_DOCTYPE_SYSTEM_IDENTIFIER);
       tokenizer->state = BOGUS_DOCTYPE_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-bogus_doctype_state(Tokenizer *tokenizer, char32_t c)
+bogus_doctype_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case '>':
@@ -2021,7 +2100,7 @@ bogus_doctype_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case '\0':
-      tokenizer->error("unexpected-null-character");
+      tokenizer->error(PARSE_ERROR_UNEXPECTED_NULL_CHARACTER);
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
@@ -2034,8 +2113,9 @@ bogus_doctype_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-cdata_section_state(Tokenizer *tokenizer, char32_t c)
+cdata_section_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case ']':
@@ -2043,7 +2123,7 @@ cdata_section_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     case static_cast<char32_t>(-1):
-      tokenizer->error("eof-in-cdata");
+      tokenizer->error(PARSE_ERROR_EOF_IN_CDATA);
       return tokenizer->emit_eof();
 
     default:
@@ -2053,8 +2133,9 @@ cdata_section_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-cdata_section_bracket_state(Tokenizer *tokenizer, char32_t c)
+cdata_section_bracket_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case ']':
@@ -2069,8 +2150,9 @@ cdata_section_bracket_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-cdata_section_end_state(Tokenizer *tokenizer, char32_t c)
+cdata_section_end_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   switch (c) {
     case ']':
@@ -2090,10 +2172,14 @@ cdata_section_end_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-char_ref_state(Tokenizer *tokenizer, char32_t c)
+char_ref_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alnum(c)) {
+  tokenizer->temp_buffer.clear();
+  tokenizer->temp_buffer.push_back('&');
+
+  if (infra_ascii_is_alnum(c)) {
     tokenizer->state = NAMED_CHAR_REF_STATE;
     return TOKENIZER_STATUS_RECONSUME;
   }
@@ -2112,84 +2198,131 @@ char_ref_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
-#include "./named_entities.cc"
+#include "html_parser/named_char_refs.hh"
 
-static enum tokenizer_status
-named_char_ref_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t c)
+/*
+ * Returns the child of the given trie node along byte, or 0 (the root, which
+ * is nobody's child) if there is none.
+ */
+static inline uint16_t
+named_char_ref_child(uint16_t node, char byte)
 {
-  char const *p = tokenizer->input.p - 2;
-  /* ^ skipped '&' and c; works because c is always ASCII */
-  const size_t left = tokenizer->input.end - p;
+  struct named_char_ref_node const *parent = &k_named_char_ref_nodes_[node];
+  size_t lo = parent->first_child;
+  size_t hi = lo + parent->num_children;
 
-  for (size_t i = 0; i < INFRA_COUNTOF(k_named_char_refs_); i++)
-  {
-    size_t entlen = k_named_char_refs_[i].name_len;
-
-    if (entlen > left)
-      continue;
-
-    if (!memcmp(k_named_char_refs_[i].name, p, entlen))
-    {
-      /* -> If there is a match: */
-      tokenizer->input.p = p + entlen;
-
-#if 0
-      /* XXX: character reference! */
-      infra_string_put_chunk(tokenizer->tmpbuf,
-        k_named_char_refs_[i].name,
-        k_named_char_refs_[i].name_len);
-#endif
-
-      if (tokenizer->is_char_ref_in_attr()
-       && (tokenizer->input.p[-1] != ';')
-       && ((tokenizer->input.p[0] == '=')
-        || ascii_is_alnum(tokenizer->input.p[0])))
-      {
-        /* first case (historical) */
-
-        tokenizer->flush_char_ref_codepoints();
-        tokenizer->state = CHAR_REF_STATE;
-        return TOKENIZER_STATUS_OK;
-      }
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
 
-      else
-      {
-        /* "regular" case */
+    if (k_named_char_ref_nodes_[mid].byte == byte)
+      return static_cast<uint16_t>(mid);
 
-        if (tokenizer->input.p[-1] != ';')
-          tokenizer->error("missing-semicolon-after-character-reference");
+    if (k_named_char_ref_nodes_[mid].byte < byte)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
 
-        tokenizer->temp_buffer.clear();
+  return 0;
+}
 
-#if 0
-        /* XXX: character reference! */
-        infra_string_put_chunk(tokenizer->tmpbuf,
-          k_named_char_refs_[i].utf8,
-          k_named_char_refs_[i].utf8_len);
-#endif
-        tokenizer->flush_char_ref_codepoints();
 
-        tokenizer->state = tokenizer->ret_state;
-        return TOKENIZER_STATUS_OK;
-      }
+template< typename Sink>
+static enum tokenizer_status
+named_char_ref_state(BasicTokenizer< Sink> *tokenizer, [[maybe_unused]] char32_t c)
+{
+  char const *start = tokenizer->input.p - 1;
+  /* ^ reconsumed c; works because c is always ASCII */
+  char const *match_end = nullptr;
+  struct named_char_ref_node const *match = nullptr;
+  uint16_t node = 0;
+
+  char const *p;
+
+  /*
+   * Walk down the trie as far as the input allows, remembering the last node
+   * that ends a name: that is the longest match.
+   */
+  for (p = start; p < tokenizer->input.end; ++p) {
+    node = named_char_ref_child(node, *p);
 
+    if (node == 0)
+      break;
+
+    if (k_named_char_ref_nodes_[node].utf8_len != 0) {
+      match = &k_named_char_ref_nodes_[node];
+      match_end = p + 1;
     }
+  }
 
+  /*
+   * The chunk ended while a longer name (or the character deciding the
+   * historical case) could still follow: start over from the character
+   * reference state once there is more.
+   */
+  if (p == tokenizer->input.end && ! tokenizer->input.final) {
+    tokenizer->input.p = start;
+    tokenizer->state = CHAR_REF_STATE;
+    return TOKENIZER_STATUS_SUSPEND;
   }
 
-  /* -> otherwise */
-  tokenizer->flush_char_ref_codepoints();
-  tokenizer->state = AMBIGUOUS_AMPERSAND_STATE;
+  if (match == nullptr) {
+    /* -> otherwise; nothing was consumed but c */
+    tokenizer->input.p = start;
+    tokenizer->flush_char_ref_codepoints();
+    tokenizer->state = AMBIGUOUS_AMPERSAND_STATE;
+    return TOKENIZER_STATUS_OK;
+  }
+
+  /* -> If there is a match: */
+  tokenizer->input.p = match_end;
+
+  for (char const *p = start; p < match_end; ++p)
+    tokenizer->temp_buffer.push_back(*p);
+
+  if (tokenizer->is_char_ref_in_attr()
+   && (match_end[-1] != ';')
+   && match_end < tokenizer->input.end
+   && ((match_end[0] == '=')
+    || infra_ascii_is_alnum(match_end[0])))
+  {
+    /* first case (historical) */
+
+    tokenizer->flush_char_ref_codepoints();
+    tokenizer->state = tokenizer->ret_state;
+    return TOKENIZER_STATUS_OK;
+  }
+
+  /* "regular" case */
+
+  if (match_end[-1] != ';')
+    tokenizer->error(PARSE_ERROR_MISSING_SEMICOLON_AFTER_CHARACTER_REFERENCE);
+
+  tokenizer->temp_buffer.clear();
+
+  /*
+   * Equivalent to putting the codepoints into the temporary buffer and
+   * flushing it, minus the UTF-32 round-trip
+   */
+  char const *utf8 = &k_named_char_ref_utf8_[match->utf8_offset];
+
+  if (tokenizer->is_char_ref_in_attr())
+    tokenizer->attr_value->append(utf8, match->utf8_len);
+  else
+    tokenizer->emit_character_run(utf8, match->utf8_len);
+
+  tokenizer->state = tokenizer->ret_state;
   return TOKENIZER_STATUS_OK;
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-ambiguous_ampersand_state(Tokenizer *tokenizer, char32_t c)
+ambiguous_ampersand_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_alnum(c)) {
+  if (infra_ascii_is_alnum(c)) {
     if (tokenizer->is_char_ref_in_attr())
-      QueequegLib::append_c32_as_utf8(tokenizer->attr_value, c);
+      tokenizer->append_current_char(tokenizer->attr_value, c);
     else
       tokenizer->emit_character(c);
     return TOKENIZER_STATUS_OK;
@@ -2197,7 +2330,7 @@ ambiguous_ampersand_state(Tokenizer *tokenizer, char32_t c)
 
   switch (c) {
     case ';':
-      tokenizer->error("unknown-named-character-reference");
+      tokenizer->error(PARSE_ERROR_UNKNOWN_NAMED_CHARACTER_REFERENCE);
       tokenizer->state = tokenizer->ret_state;
       return TOKENIZER_STATUS_RECONSUME;
 
@@ -2208,8 +2341,9 @@ ambiguous_ampersand_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-numeric_char_ref_state(Tokenizer *tokenizer, char32_t c)
+numeric_char_ref_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
   tokenizer->char_ref = 0;
 
@@ -2226,16 +2360,17 @@ numeric_char_ref_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-hex_char_ref_start_state(Tokenizer *tokenizer, char32_t c)
+hex_char_ref_start_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_xdigit(c)) {
+  if (infra_ascii_is_xdigit(c)) {
     tokenizer->state = HEX_CHAR_REF_STATE;
     return TOKENIZER_STATUS_RECONSUME;
   }
 
   {
-    tokenizer->error("absence-of-digits-in-numeric-character-reference");
+    tokenizer->error(PARSE_ERROR_ABSENCE_OF_DIGITS_IN_NUMERIC_CHARACTER_REFERENCE);
     tokenizer->flush_char_ref_codepoints();
     tokenizer->state = tokenizer->ret_state;
     return TOKENIZER_STATUS_RECONSUME;
@@ -2243,16 +2378,17 @@ hex_char_ref_start_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-dec_char_ref_start_state(Tokenizer *tokenizer, char32_t c)
+dec_char_ref_start_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_digit(c)) {
+  if (infra_ascii_is_digit(c)) {
     tokenizer->state = DEC_CHAR_REF_STATE;
     return TOKENIZER_STATUS_RECONSUME;
   }
 
   {
-    tokenizer->error("absence-of-digits-in-numeric-character-reference");
+    tokenizer->error(PARSE_ERROR_ABSENCE_OF_DIGITS_IN_NUMERIC_CHARACTER_REFERENCE);
     tokenizer->flush_char_ref_codepoints();
     tokenizer->state = tokenizer->ret_state;
     return TOKENIZER_STATUS_RECONSUME;
@@ -2260,22 +2396,23 @@ dec_char_ref_start_state(Tokenizer *tokenizer, char32_t c)
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-hex_char_ref_state(Tokenizer *tokenizer, char32_t c)
+hex_char_ref_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_digit(c)) {
+  if (infra_ascii_is_digit(c)) {
     tokenizer->char_ref <<= 4;
     tokenizer->char_ref  |= c - 0x30;
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_upper_xdigit(c)) {
+  if (infra_ascii_is_upper_xdigit(c)) {
     tokenizer->char_ref <<= 4;
     tokenizer->char_ref  |= c - 0x37;
     return TOKENIZER_STATUS_OK;
   }
 
-  if (ascii_is_lower_xdigit(c)) {
+  if (infra_ascii_is_lower_xdigit(c)) {
     tokenizer->char_ref <<= 4;
     tokenizer->char_ref  |= c - 0x57;
     return TOKENIZER_STATUS_OK;
@@ -2287,17 +2424,18 @@ hex_char_ref_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_RECONSUME;
 
     default:
-      tokenizer->error("missing-semicolon-after-character-reference");
+      tokenizer->error(PARSE_ERROR_MISSING_SEMICOLON_AFTER_CHARACTER_REFERENCE);
       tokenizer->state = NUMERIC_CHAR_REF_END_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
 }
 
 
+template< typename Sink>
 static enum tokenizer_status
-dec_char_ref_state(Tokenizer *tokenizer, char32_t c)
+dec_char_ref_state(BasicTokenizer< Sink> *tokenizer, char32_t c)
 {
-  if (ascii_is_digit(c)) {
+  if (infra_ascii_is_digit(c)) {
     tokenizer->char_ref *= 10;
     tokenizer->char_ref += c - 0x30;
     return TOKENIZER_STATUS_OK;
@@ -2309,7 +2447,7 @@ dec_char_ref_state(Tokenizer *tokenizer, char32_t c)
       return TOKENIZER_STATUS_OK;
 
     default:
-      tokenizer->error("missing-semicolon-after-character-reference");
+      tokenizer->error(PARSE_ERROR_MISSING_SEMICOLON_AFTER_CHARACTER_REFERENCE);
       tokenizer->state = NUMERIC_CHAR_REF_END_STATE;
       return TOKENIZER_STATUS_RECONSUME;
   }
@@ -2346,25 +2484,26 @@ static const std::unordered_map< char32_t, char32_t> k_numeric_subst_ = {
 };
 
 
+template< typename Sink>
 static enum tokenizer_status
-numeric_char_ref_end_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t ch)
+numeric_char_ref_end_state(BasicTokenizer< Sink> *tokenizer, [[maybe_unused]] char32_t ch)
 {
   char32_t code = tokenizer->char_ref;
 
   if (code == 0x00) {
-    tokenizer->error("null-character-reference");
+    tokenizer->error(PARSE_ERROR_NULL_CHARACTER_REFERENCE);
     code = 0xFFFD;
   } else if (code > 0x10FFFF) {
-    tokenizer->error("character-reference-outside-unicode-range");
+    tokenizer->error(PARSE_ERROR_CHARACTER_REFERENCE_OUTSIDE_UNICODE_RANGE);
     code = 0xFFFD;
-  }  else if (unicode_is_surrogate(code)) {
-    tokenizer->error("surrogate-character-reference");
+  }  else if (infra_unicode_is_surrogate(code)) {
+    tokenizer->error(PARSE_ERROR_SURROGATE_CHARACTER_REFERENCE);
     code = 0xFFFD;
-  } else if (unicode_is_noncharacter(code)) {
-    tokenizer->error("noncharacter-character-reference");
+  } else if (infra_unicode_is_noncharacter(code)) {
+    tokenizer->error(PARSE_ERROR_NONCHARACTER_CHARACTER_REFERENCE);
   } else if ((code == 0x0D)) {
     /* XXX: other cases */
-    tokenizer->error("control-character-reference");
+    tokenizer->error(PARSE_ERROR_CONTROL_CHARACTER_REFERENCE);
   } else if (k_numeric_subst_.contains(code)) {
     code = k_numeric_subst_.at(code);
   }
@@ -2379,86 +2518,172 @@ numeric_char_ref_end_state(Tokenizer *tokenizer, [[maybe_unused]] char32_t ch)
 
 
 
-const Tokenizer::state_handler_cb_t Tokenizer::k_state_handlers_[NUM_STATES] = {
-  data_state,
-  rcdata_state,
-  rawtext_state,
-  script_state,
-  plaintext_state,
-  tag_open_state,
-  end_tag_open_state,
-  tag_name_state,
-  rcdata_lt_state,
-  rcdata_end_tag_open_state,
-  rcdata_end_tag_name_state,
-  rawtext_lt_state,
-  rawtext_end_tag_open_state,
-  rawtext_end_tag_name_state,
-  script_lt_state,
-  script_end_tag_open_state,
-  script_end_tag_name_state,
-  script_escape_start_state,
-  script_escape_start_dash_state,
-  script_escaped_state,
-  script_escaped_dash_state,
-  script_escaped_dash_dash_state,
-  script_escaped_lt_state,
-  script_escaped_end_tag_open_state,
-  script_escaped_end_tag_name_state,
-  script_double_escape_start_state,
-  script_double_escaped_state,
-  script_double_escaped_dash_state,
-  script_double_escaped_dash_dash_state,
-  script_double_escaped_lt_state,
-  script_double_escape_end_state,
-  before_attr_name_state,
-  attr_name_state,
-  after_attr_name_state,
-  before_attr_value_state,
-  attr_value_double_quoted_state,
-  attr_value_single_quoted_state,
-  attr_value_unquoted_state,
-  after_attr_value_quoted_state,
-  self_closing_start_tag_state,
-  bogus_comment_state,
-  markup_decl_open_state,
-  comment_start_state,
-  comment_start_dash_state,
-  comment_state,
-  comment_lt_state,
-  comment_lt_bang_state,
-  comment_lt_bang_dash_state,
-  comment_lt_bang_dash_dash_state,
-  comment_end_dash_state,
-  comment_end_state,
-  comment_end_bang_state,
-  doctype_state,
-  before_doctype_name_state,
-  doctype_name_state,
-  after_doctype_name_state,
-  after_doctype_public_keyword_state,
-  before_doctype_public_id_state,
-  doctype_public_id_double_quoted_state,
-  doctype_public_id_single_quoted_state,
-  after_doctype_public_id_state,
-  between_doctype_public_system_ids_state,
-  after_doctype_system_keyword_state,
-  before_doctype_system_id_state,
-  doctype_system_id_double_quoted_state,
-  doctype_system_id_single_quoted_state,
-  after_doctype_system_id_state,
-  bogus_doctype_state,
-  cdata_section_state,
-  cdata_section_bracket_state,
-  cdata_section_end_state,
-  char_ref_state,
-  named_char_ref_state,
-  ambiguous_ampersand_state,
-  numeric_char_ref_state,
-  hex_char_ref_start_state,
-  dec_char_ref_start_state,
-  hex_char_ref_state,
-  dec_char_ref_state,
-  numeric_char_ref_end_state,
+/*
+ * (state, handler) pairs in enum order, shared by the jump table and the
+ * threaded engine below
+ */
+#define TOKENIZER_STATES(X) \
+  X(DATA_STATE,                                     data_state) \
+  X(RCDATA_STATE,                                   rcdata_state) \
+  X(RAWTEXT_STATE,                                  rawtext_state) \
+  X(SCRIPT_STATE,                                   script_state) \
+  X(PLAINTEXT_STATE,                                plaintext_state) \
+  X(TAG_OPEN_STATE,                                 tag_open_state) \
+  X(END_TAG_OPEN_STATE,                             end_tag_open_state) \
+  X(TAG_NAME_STATE,                                 tag_name_state) \
+  X(RCDATA_LT_STATE,                                rcdata_lt_state) \
+  X(RCDATA_END_TAG_OPEN_STATE,                      rcdata_end_tag_open_state) \
+  X(RCDATA_END_TAG_NAME_STATE,                      rcdata_end_tag_name_state) \
+  X(RAWTEXT_LT_STATE,                               rawtext_lt_state) \
+  X(RAWTEXT_END_TAG_OPEN_STATE,                     rawtext_end_tag_open_state) \
+  X(RAWTEXT_END_TAG_NAME_STATE,                     rawtext_end_tag_name_state) \
+  X(SCRIPT_LT_STATE,                                script_lt_state) \
+  X(SCRIPT_END_TAG_OPEN_STATE,                      script_end_tag_open_state) \
+  X(SCRIPT_END_TAG_NAME_STATE,                      script_end_tag_name_state) \
+  X(SCRIPT_ESCAPE_START_STATE,                      script_escape_start_state) \
+  X(SCRIPT_ESCAPE_START_DASH_STATE,                 script_escape_start_dash_state) \
+  X(SCRIPT_ESCAPED_STATE,                           script_escaped_state) \
+  X(SCRIPT_ESCAPED_DASH_STATE,                      script_escaped_dash_state) \
+  X(SCRIPT_ESCAPED_DASH_DASH_STATE,                 script_escaped_dash_dash_state) \
+  X(SCRIPT_ESCAPED_LT_STATE,                        script_escaped_lt_state) \
+  X(SCRIPT_ESCAPED_END_TAG_OPEN_STATE,              script_escaped_end_tag_open_state) \
+  X(SCRIPT_ESCAPED_END_TAG_NAME_STATE,              script_escaped_end_tag_name_state) \
+  X(SCRIPT_DOUBLE_ESCAPE_START_STATE,               script_double_escape_start_state) \
+  X(SCRIPT_DOUBLE_ESCAPED_STATE,                    script_double_escaped_state) \
+  X(SCRIPT_DOUBLE_ESCAPED_DASH_STATE,               script_double_escaped_dash_state) \
+  X(SCRIPT_DOUBLE_ESCAPED_DASH_DASH_STATE,          script_double_escaped_dash_dash_state) \
+  X(SCRIPT_DOUBLE_ESCAPED_LT_STATE,                 script_double_escaped_lt_state) \
+  X(SCRIPT_DOUBLE_ESCAPE_END_STATE,                 script_double_escape_end_state) \
+  X(BEFORE_ATTR_NAME_STATE,                         before_attr_name_state) \
+  X(ATTR_NAME_STATE,                                attr_name_state) \
+  X(AFTER_ATTR_NAME_STATE,                          after_attr_name_state) \
+  X(BEFORE_ATTR_VALUE_STATE,                        before_attr_value_state) \
+  X(ATTR_VALUE_DOUBLE_QUOTED_STATE,                 attr_value_double_quoted_state) \
+  X(ATTR_VALUE_SINGLE_QUOTED_STATE,                 attr_value_single_quoted_state) \
+  X(ATTR_VALUE_UNQUOTED_STATE,                      attr_value_unquoted_state) \
+  X(AFTER_ATTR_VALUE_QUOTED_STATE,                  after_attr_value_quoted_state) \
+  X(SELF_CLOSING_START_TAG_STATE,                   self_closing_start_tag_state) \
+  X(BOGUS_COMMENT_STATE,                            bogus_comment_state) \
+  X(MARKUP_DECL_OPEN_STATE,                         markup_decl_open_state) \
+  X(COMMENT_START_STATE,                            comment_start_state) \
+  X(COMMENT_START_DASH_STATE,                       comment_start_dash_state) \
+  X(COMMENT_STATE,                                  comment_state) \
+  X(COMMENT_LT_STATE,                               comment_lt_state) \
+  X(COMMENT_LT_BANG_STATE,                          comment_lt_bang_state) \
+  X(COMMENT_LT_BANG_DASH_STATE,                     comment_lt_bang_dash_state) \
+  X(COMMENT_LT_BANG_DASH_DASH_STATE,                comment_lt_bang_dash_dash_state) \
+  X(COMMENT_END_DASH_STATE,                         comment_end_dash_state) \
+  X(COMMENT_END_STATE,                              comment_end_state) \
+  X(COMMENT_END_BANG_STATE,                         comment_end_bang_state) \
+  X(DOCTYPE_STATE,                                  doctype_state) \
+  X(BEFORE_DOCTYPE_NAME_STATE,                      before_doctype_name_state) \
+  X(DOCTYPE_NAME_STATE,                             doctype_name_state) \
+  X(AFTER_DOCTYPE_NAME_STATE,                       after_doctype_name_state) \
+  X(AFTER_DOCTYPE_PUBLIC_KEYWORD_STATE,             after_doctype_public_keyword_state) \
+  X(BEFORE_DOCTYPE_PUBLIC_ID_STATE,                 before_doctype_public_id_state) \
+  X(DOCTYPE_PUBLIC_ID_DOUBLE_QUOTED_STATE,          doctype_public_id_double_quoted_state) \
+  X(DOCTYPE_PUBLIC_ID_SINGLE_QUOTED_STATE,          doctype_public_id_single_quoted_state) \
+  X(AFTER_DOCTYPE_PUBLIC_ID_STATE,                  after_doctype_public_id_state) \
+  X(BETWEEN_DOCTYPE_PUBLIC_SYSTEM_IDS_STATE,        between_doctype_public_system_ids_state) \
+  X(AFTER_DOCTYPE_SYSTEM_KEYWORD_STATE,             after_doctype_system_keyword_state) \
+  X(BEFORE_DOCTYPE_SYSTEM_ID_STATE,                 before_doctype_system_id_state) \
+  X(DOCTYPE_SYSTEM_ID_DOUBLE_QUOTED_STATE,          doctype_system_id_double_quoted_state) \
+  X(DOCTYPE_SYSTEM_ID_SINGLE_QUOTED_STATE,          doctype_system_id_single_quoted_state) \
+  X(AFTER_DOCTYPE_SYSTEM_ID_STATE,                  after_doctype_system_id_state) \
+  X(BOGUS_DOCTYPE_STATE,                            bogus_doctype_state) \
+  X(CDATA_SECTION_STATE,                            cdata_section_state) \
+  X(CDATA_SECTION_BRACKET_STATE,                    cdata_section_bracket_state) \
+  X(CDATA_SECTION_END_STATE,                        cdata_section_end_state) \
+  X(CHAR_REF_STATE,                                 char_ref_state) \
+  X(NAMED_CHAR_REF_STATE,                           named_char_ref_state) \
+  X(AMBIGUOUS_AMPERSAND_STATE,                      ambiguous_ampersand_state) \
+  X(NUMERIC_CHAR_REF_STATE,                         numeric_char_ref_state) \
+  X(HEX_CHAR_REF_START_STATE,                       hex_char_ref_start_state) \
+  X(DEC_CHAR_REF_START_STATE,                       dec_char_ref_start_state) \
+  X(HEX_CHAR_REF_STATE,                             hex_char_ref_state) \
+  X(DEC_CHAR_REF_STATE,                             dec_char_ref_state) \
+  X(NUMERIC_CHAR_REF_END_STATE,                     numeric_char_ref_end_state)
+
+
+#define X(which, handler) handler< Sink>,
+
+template< typename Sink>
+const typename BasicTokenizer< Sink>::state_handler_cb_t BasicTokenizer< Sink>::k_state_handlers_[NUM_STATES] = {
+  TOKENIZER_STATES(X)
 };
 
+#undef X
+
+
+#if defined(TOKENIZER_THREADED_DISPATCH)
+/*
+ * Direct-threaded engine: every state gets a "fetch" label, which reads the
+ * next character and falls into the handler, and a "handle" label, which
+ * reconsumes the current one. Each handler is inlined at its label and jumps
+ * straight to the next one through its own indirect branch, so the branch
+ * predictor gets to learn per-state transitions instead of sharing a single
+ * call site. Behaves exactly like the table-driven loop in Tokenizer::run().
+ *
+ * input.p stays a member rather than a local of the loop: the handlers are
+ * shared with the table-driven engine and move it themselves (match(),
+ * lookahead, character references, the checkpoints sinks take), so a local
+ * copy would have to be written back before and reloaded after each of them,
+ * which is what the member costs already. Statuses come back as return
+ * values, which flattening keeps in registers.
+ */
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+template< typename Sink>
+[[gnu::flatten]]
+void
+BasicTokenizer< Sink>::run_threaded_(void)
+{
+#define X(which, handler) &&fetch_##handler,
+  static void * const k_fetch_labels[NUM_STATES] = { TOKENIZER_STATES(X) };
+#undef X
+#define X(which, handler) &&handle_##handler,
+  static void * const k_handle_labels[NUM_STATES] = { TOKENIZER_STATES(X) };
+#undef X
+
+  enum tokenizer_status status;
+  char32_t ch = {0};
+
+
+  goto *k_fetch_labels[this->state];
+
+#define X(which, handler) \
+  fetch_##handler: \
+    if constexpr (which <= PLAINTEXT_STATE) \
+      this->consume_text_run_(); \
+    if constexpr (which == MARKUP_DECL_OPEN_STATE \
+               || which == AFTER_DOCTYPE_NAME_STATE \
+               || which == NUMERIC_CHAR_REF_END_STATE) { \
+      /* nothing consumed: errors point at what comes next */ \
+      this->input.cur = this->input.p; \
+      ch = {0xFFFD}; \
+    } else { \
+      ch = this->next_char_(); \
+      if (ch == BasicTokenizer::k_suspend) \
+        return; \
+    } \
+  handle_##handler: \
+    status = handler< Sink>(this, ch); \
+    if (status == TOKENIZER_STATUS_RECONSUME) \
+      goto *k_handle_labels[this->state]; \
+    if (status == TOKENIZER_STATUS_EOF || status == TOKENIZER_STATUS_SUSPEND) \
+      return; \
+    goto *k_fetch_labels[this->state];
+
+  TOKENIZER_STATES(X)
+
+#undef X
+}
+
+#pragma GCC diagnostic pop
+
+#endif /* defined(TOKENIZER_THREADED_DISPATCH) */
+
+
+#endif /* !defined(_queequeg_html_parser_tokenizer_states_hh_) */
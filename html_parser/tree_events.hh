@@ -0,0 +1,78 @@
+#ifndef _queequeg_html_parser_tree_events_hh_
+#define _queequeg_html_parser_tree_events_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: html_parser/tree_events.hh
+ *
+ * Description:
+ * Tree construction without the tree. Instead of inserting nodes into the
+ * document, the tree builder tells a handler about each one as it would go
+ * in, with implied tags, foster parenting and the adoption agency algorithm
+ * all accounted for. Text and comments never become nodes, and an element is
+ * dropped as soon as it is neither on the stack of open elements nor in the
+ * list of active formatting elements, so that memory follows the nesting
+ * depth rather than the size of the document.
+ *
+ * Nodes are always appended to their parent. Since the adoption agency
+ * algorithm moves elements that are in the tree already, a handler that
+ * wants the exact tree has to follow move_element() and move_children() as
+ * well; one that only streams the document out may do with the rest.
+ */
+
+#include <string_view>
+
+#include "dom/core/element.hh"
+#include "dom/core/node.hh"
+
+#include "html_parser/internal.hh"
+
+
+/*
+ * Elements are handed over as the tree builder's own, which identify them
+ * from open_element() until close_element(); parents are elements or the
+ * parser's document. Strings and tokens are only good for the duration of the
+ * call.
+ */
+class TreeEventHandler {
+  public:
+    virtual ~TreeEventHandler() = default;
+
+
+  public:
+    virtual void doctype(struct doctype_token const *doctype) = 0;
+
+    /*
+     * parent is nullptr for an element made by the adoption agency algorithm,
+     * which moves it into place right after (see move_element())
+     */
+    virtual void open_element(DOM::Element const *element, DOM::Node const *parent,
+                              struct tag_token const *tag) = 0;
+    /*
+     * The element is off the stack of open elements, and gets no children of
+     * its own anymore; its parent may still move it along with its siblings
+     * (see move_children())
+     */
+    virtual void close_element(DOM::Element const *element) = 0;
+
+    /*
+     * Appended to the parent's last child if that is text, as a new text node
+     * otherwise
+     */
+    virtual void text(DOM::Node const *parent, std::string_view data) = 0;
+    virtual void comment(DOM::Node const *parent, std::string_view data) = 0;
+
+    /*
+     * Adoption agency algorithm: an open element, along with its children,
+     * becomes the new parent's last child; all the children of from become
+     * those of to
+     */
+    virtual void move_element(DOM::Element const *element, DOM::Node const *new_parent) = 0;
+    virtual void move_children(DOM::Element const *from, DOM::Element const *to) = 0;
+};
+
+
+#endif /* !defined(_queequeg_html_parser_tree_events_hh_) */
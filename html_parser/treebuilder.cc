@@ -5,31 +5,45 @@
  */
 #include <algorithm>
 #include <iterator>
+#include <new>
 #include <ranges>
-#include <set>
 
 #include <cassert>
 #include <cstdio>
 
+#include <grapheme.h>
+
 #include "html_parser/internal.hh"
+#include "html_parser/pipeline.hh"
+#include "html_parser/tree_events.hh"
 
 #include "dom/core/document.hh"
+#include "dom/core/document_type.hh"
 #include "dom/core/text.hh"
 #include "dom/core/comment.hh"
 
 #include "qglib/unicode.hh"
 
 
-#define LOGF(fmt, ...) \
+#if defined(HTML_PARSER_DEBUG)
+# define LOGF(fmt, ...) \
   std::fprintf(stderr, (fmt), __VA_ARGS__)
+#else
+# define LOGF(fmt, ...) \
+  (void)0
+#endif
 
 #define TREEBUILDER_PROCESS_TOKENS
 // #undef TREEBUILDER_PROCESS_TOKENS
 
 
-TreeBuilder::TreeBuilder(std::shared_ptr< DOM::Document> document)
+TreeBuilder::TreeBuilder(std::shared_ptr< DOM::Document> document,
+                         TreeEventHandler *events)
 {
   this->document = document;
+  this->events   = events;
+
+  this->open_elements.events = events;
 }
 
 
@@ -46,19 +60,66 @@ TreeBuilder::process_token(union token_data *token_data,
   enum treebuilder_status status;
 
 
+  /* before the newline below is skipped; it is part of the run's offsets */
+  if (token_type == TOKEN_CHARACTER_RUN) {
+    this->run_begin_  = token_data->chars.data();
+    this->run_offset_ = this->token_offset_();
+  }
+
+
   if (this->flags.skip_newline) {
     this->flags.skip_newline = false;
 
     if (token_type == TOKEN_WHITESPACE
      && token_data->ch == U'\n')
       return;
+
+    if (token_type == TOKEN_CHARACTER_RUN
+     && token_data->chars.front() == '\n') {
+      token_data->chars.remove_prefix(1);
+
+      if (token_data->chars.empty())
+        return;
+    }
+  }
+
+
+  /*
+   * The tokenizer only knows built-in names; any other gets its index from the
+   * document, so that start and end tags with that name still match
+   */
+  if ((token_type == TOKEN_START_TAG || token_type == TOKEN_END_TAG)
+   && token_data->tag.local_name == HTML_ELEMENT_NONE_)
+    token_data->tag.local_name = this->document->intern_local_name(token_data->tag.tag_name);
+
+
+  if (! (token_type == TOKEN_CHARACTER || token_type == TOKEN_WHITESPACE
+      || token_type == TOKEN_CHARACTER_RUN)) {
+    this->flush_pending_text();
+
+    if (this->live_elements_.size() >= this->release_at_)
+      this->release_dead_elements_();
   }
 
 
+  if (token_type == TOKEN_CHARACTER_RUN)
+    this->run_ = &token_data->chars;
+
   do {
-    assert( TreeBuilder::k_insertion_mode_handlers_[this->mode] != nullptr );
-    status = TreeBuilder::k_insertion_mode_handlers_[this->mode](this, token_data, token_type);
+    status = TreeBuilder::k_insertion_mode_handlers_[this->mode][token_type](this, token_data);
   } while (status == TREEBUILDER_STATUS_REPROCESS);
+
+  this->run_ = nullptr;
+
+  /* pending table characters may have come in on EOF */
+  if (token_type == TOKEN_EOF)
+    this->flush_pending_text();
+
+  /* so that every element that was opened gets closed */
+  if (token_type == TOKEN_EOF && this->events != nullptr) {
+    while (! this->open_elements.empty())
+      this->open_elements.pop_back();
+  }
 #endif
 }
 
@@ -75,10 +136,279 @@ TreeBuilder::tree_construction_dispatcher_(union token_data *token_data,
 }
 
 
+[[nodiscard]]
+size_t
+TreeBuilder::token_offset_(void) const
+{
+  if (this->replay != nullptr)
+    return this->replay->token_offset();
+
+  return this->tokenizer->offset();
+}
+
+
 void
 TreeBuilder::error(void)
 {
-  /* ... */
+  if (this->run_ != nullptr) {
+    this->error(this->run_offset_of(this->run_->data()));
+    return;
+  }
+
+  this->error(this->token_offset_());
+}
+
+
+void
+TreeBuilder::error(size_t offset)
+{
+  if (this->replay != nullptr) {
+    this->replay->report_tree_construction_error(offset);
+    return;
+  }
+
+  this->tokenizer->error(PARSE_ERROR_TREE_CONSTRUCTION, offset);
+}
+
+
+/*
+ * Only ever done right after a start tag (see TokenReplay)
+ */
+void
+TreeBuilder::switch_tokenizer_state(enum tokenizer_state state)
+{
+  if (this->replay != nullptr) {
+    this->replay->switch_tokenizer_state(state);
+    return;
+  }
+
+  this->tokenizer->state = state;
+}
+
+
+void
+OpenElementStack::report_closed_(DOM::Element const *element) const
+{
+  this->events->close_element(element);
+}
+
+
+void
+OpenElementStack::insert(const_iterator pos, DOM::Element *element)
+{
+  this->entries_.insert(pos, open_element::of(element));
+
+  this->relink_all_();
+}
+
+
+void
+OpenElementStack::erase(const_iterator pos)
+{
+  DOM::Element const *element = pos->element;
+
+  pos->element->parser_index.open_element = k_none_;
+
+  this->entries_.erase(pos);
+  this->relink_all_();
+
+  if (this->events != nullptr)
+    this->report_closed_(element);
+}
+
+
+void
+OpenElementStack::replace(DOM::Element const *element, DOM::Element *replacement)
+{
+  int index = this->index_of_(element);
+
+  if (index == k_none_)
+    return;
+
+  struct open_element& entry = this->entries_[index];
+  struct open_element new_entry = open_element::of(replacement);
+
+  entry.element->parser_index.open_element = k_none_;
+  replacement->parser_index.open_element = static_cast<int32_t>(index);
+
+  /*
+   * The adoption agency algorithm only ever swaps an element for a copy of
+   * itself, which leaves the name chains and scope boundaries as they are.
+   */
+  bool same_links = new_entry.has_element_index(entry.name_space, entry.local_name)
+                 && new_entry.categories == entry.categories;
+
+  entry = new_entry;
+
+  if (! same_links)
+    this->relink_all_();
+
+  if (this->events != nullptr)
+    this->report_closed_(element);
+}
+
+
+void
+OpenElementStack::relink_all_(void)
+{
+  this->same_name_below_.clear();
+  this->topmost_by_name_ = make_topmost_by_name_();
+
+  for (auto& boundaries : this->boundaries_)
+    boundaries.clear();
+
+  for (size_t i = 0; i < this->entries_.size(); i++)
+    this->link_(i);
+}
+
+
+bool
+OpenElementStack::in_scope(enum scope_kind kind, enum html_element_index local_name) const
+{
+  /*
+   * The target itself may be a boundary (e.g. <table> in table scope), which
+   * still counts as being in scope.
+   */
+  int index = this->topmost_(local_name);
+
+  return (index != k_none_ && index >= this->nearest_boundary_(kind));
+}
+
+
+bool
+OpenElementStack::in_scope(enum scope_kind kind,
+                           std::initializer_list< enum html_element_index> local_names) const
+{
+  int boundary = this->nearest_boundary_(kind);
+
+  for (enum html_element_index local_name : local_names) {
+    int index = this->topmost_(local_name);
+
+    if (index != k_none_ && index >= boundary)
+      return true;
+  }
+
+  return false;
+}
+
+
+bool
+OpenElementStack::in_scope(enum scope_kind kind, DOM::Element const *element) const
+{
+  int index = this->index_of_(element);
+
+  return (index != k_none_ && index >= this->nearest_boundary_(kind));
+}
+
+
+struct tag_token
+saved_tag::to_token(void) const
+{
+  struct tag_token token = { };
+
+  token.tag_name = this->tag_name;
+  token.local_name = this->local_name;
+
+  for (struct saved_attribute const& attr : this->attributes())
+    token.attributes.append(attr.name)->value = attr.value;
+
+  return token;
+}
+
+
+struct saved_tag const *
+SavedTagPool::save(struct tag_token const *tag)
+{
+  size_t n_attributes = tag->attributes.size();
+  void *memory = this->memory_.allocate(sizeof (struct saved_tag)
+                                        + n_attributes * sizeof (struct saved_attribute),
+                                        alignof (struct saved_tag));
+
+  auto *saved = new (memory) saved_tag{
+    .tag_name     = this->intern_(tag->tag_name),
+    .local_name   = tag->local_name,
+    .n_attributes = static_cast<uint16_t>(n_attributes),
+  };
+
+  auto *attributes = reinterpret_cast<struct saved_attribute *>(saved + 1);
+
+  for (struct tag_attribute const& attr : tag->attributes)
+    new (attributes++) saved_attribute{
+      .name  = this->intern_(attr.name),
+      .value = this->intern_(attr.value),
+    };
+
+  return saved;
+}
+
+
+void
+SavedTagPool::release(struct saved_tag const *saved)
+{
+  this->unintern_(saved->tag_name);
+
+  for (struct saved_attribute const& attr : saved->attributes()) {
+    this->unintern_(attr.name);
+    this->unintern_(attr.value);
+  }
+
+  this->memory_.deallocate(const_cast<struct saved_tag *>(saved),
+                           sizeof (struct saved_tag)
+                           + saved->n_attributes * sizeof (struct saved_attribute),
+                           alignof (struct saved_tag));
+}
+
+
+std::string_view
+SavedTagPool::intern_(std::string_view sv)
+{
+  if (auto it = this->strings_.find(sv); it != this->strings_.end()) {
+    ++*SavedTagPool::refcount_(*it);
+    return *it;
+  }
+
+  char *memory = static_cast<char *>(this->memory_.allocate(sizeof (uint32_t) + sv.size(),
+                                                            alignof (uint32_t)));
+  std::string_view interned{ memory + sizeof (uint32_t), sv.size() };
+
+  *reinterpret_cast<uint32_t *>(memory) = 1;
+  std::ranges::copy(sv, memory + sizeof (uint32_t));
+
+  this->strings_.insert(interned);
+
+  return interned;
+}
+
+
+void
+SavedTagPool::unintern_(std::string_view interned)
+{
+  uint32_t *refcount = SavedTagPool::refcount_(interned);
+
+  if (--*refcount > 0)
+    return;
+
+  this->strings_.erase(interned);
+  this->memory_.deallocate(refcount, sizeof (uint32_t) + interned.size(), alignof (uint32_t));
+}
+
+
+void
+ActiveFormattingList::move_after(size_t index, DOM::Element const *bookmark,
+                                 DOM::Element *replacement)
+{
+  struct formatting_entry entry = this->entries_[index];
+
+  entry.element->parser_index.formatting = k_none;
+  entry.element = replacement;
+
+  this->entries_.erase(this->entries_.begin() + index);
+  this->reindex_from_(index);
+
+  size_t new_index = this->index_of(bookmark) + 1;
+
+  this->entries_.insert(this->entries_.begin() + new_index, entry);
+  this->reindex_from_(std::min(index, new_index));
 }
 
 
@@ -92,31 +422,27 @@ TreeBuilder::reset_insertion_mode_appropriately(void)
     const int elem_idx = i;
     const int node_idx = elem_idx;
 
-    std::shared_ptr< DOM::Element> elem = this->open_elements[elem_idx];
-    /*
-     * Separate pointer copy for the fragment case
-     */
-    std::shared_ptr< DOM::Element> node = elem;
+    struct open_element node = this->open_elements[elem_idx];
 
-    if (node == this->open_elements.front())
+    if (elem_idx == 0)
       last = true;
 
+    /* fragment case */
     if (this->flags.fragment_parse)
-      node = this->context;
+      node = open_element::of(this->context.get());
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_SELECT)) {
+    if (node.has_html_element_index(HTML_ELEMENT_SELECT)) {
       if (! last) {
         int ancestor_idx = node_idx;
-        std::shared_ptr< DOM::Element> ancestor = this->open_elements[ancestor_idx];
 
         while (ancestor_idx > 0) {
-          ancestor = this->open_elements[--ancestor_idx];
+          struct open_element const& ancestor = this->open_elements[--ancestor_idx];
 
-          if (ancestor->has_html_element_index(HTML_ELEMENT_TEMPLATE))
+          if (ancestor.has_html_element_index(HTML_ELEMENT_TEMPLATE))
             break;
 
-          if (ancestor->has_html_element_index(HTML_ELEMENT_TABLE)) {
+          if (ancestor.has_html_element_index(HTML_ELEMENT_TABLE)) {
             this->mode = IN_SELECT_IN_TABLE_MODE;
             return;
           }
@@ -130,73 +456,73 @@ TreeBuilder::reset_insertion_mode_appropriately(void)
     }
 
 
-    if ((node->has_html_element_index(HTML_ELEMENT_TD)
-      || node->has_html_element_index(HTML_ELEMENT_TH))
+    if ((node.has_html_element_index(HTML_ELEMENT_TD)
+      || node.has_html_element_index(HTML_ELEMENT_TH))
      && !last) {
       this->mode = IN_CELL_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_TR)) {
+    if (node.has_html_element_index(HTML_ELEMENT_TR)) {
       this->mode = IN_ROW_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_TBODY)
-     || node->has_html_element_index(HTML_ELEMENT_THEAD)
-     || node->has_html_element_index(HTML_ELEMENT_TFOOT)) {
+    if (node.has_html_element_index(HTML_ELEMENT_TBODY)
+     || node.has_html_element_index(HTML_ELEMENT_THEAD)
+     || node.has_html_element_index(HTML_ELEMENT_TFOOT)) {
       this->mode = IN_TABLE_BODY_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_CAPTION)) {
+    if (node.has_html_element_index(HTML_ELEMENT_CAPTION)) {
       this->mode = IN_CAPTION_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_COLGROUP)) {
+    if (node.has_html_element_index(HTML_ELEMENT_COLGROUP)) {
       this->mode = IN_COLUMN_GROUP_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_TABLE)) {
+    if (node.has_html_element_index(HTML_ELEMENT_TABLE)) {
       this->mode = IN_TABLE_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_TEMPLATE)) {
+    if (node.has_html_element_index(HTML_ELEMENT_TEMPLATE)) {
       this->mode = this->template_modes.back();
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_HEAD)
+    if (node.has_html_element_index(HTML_ELEMENT_HEAD)
      && !last) {
       this->mode = IN_HEAD_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_BODY)) {
+    if (node.has_html_element_index(HTML_ELEMENT_BODY)) {
       this->mode = IN_BODY_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_FRAMESET)) {
+    if (node.has_html_element_index(HTML_ELEMENT_FRAMESET)) {
       /* fragment case */
       this->mode = IN_FRAMESET_MODE;
       return;
     }
 
 
-    if (node->has_html_element_index(HTML_ELEMENT_HTML)) {
+    if (node.has_html_element_index(HTML_ELEMENT_HTML)) {
       if (this->head == nullptr) {
         this->mode = BEFORE_HEAD_MODE;
         return;
@@ -221,369 +547,119 @@ TreeBuilder::reset_insertion_mode_appropriately(void)
 }
 
 
-static const std::set<uint16_t> k_special_html_elements_set_ = {
-  HTML_ELEMENT_ADDRESS,
-  HTML_ELEMENT_APPLET,
-  HTML_ELEMENT_AREA,
-  HTML_ELEMENT_ARTICLE,
-  HTML_ELEMENT_ASIDE,
-  HTML_ELEMENT_BASE,
-  HTML_ELEMENT_BASEFONT,
-  HTML_ELEMENT_BGSOUND,
-  HTML_ELEMENT_BLOCKQUOTE,
-  HTML_ELEMENT_BODY,
-  HTML_ELEMENT_BR,
-  HTML_ELEMENT_BUTTON,
-  HTML_ELEMENT_CAPTION,
-  HTML_ELEMENT_CENTER,
-  HTML_ELEMENT_COL,
-  HTML_ELEMENT_COLGROUP,
-  HTML_ELEMENT_DD,
-  HTML_ELEMENT_DETAILS,
-  HTML_ELEMENT_DIR,
-  HTML_ELEMENT_DIV,
-  HTML_ELEMENT_DL,
-  HTML_ELEMENT_DT,
-  HTML_ELEMENT_EMBED,
-  HTML_ELEMENT_FIELDSET,
-  HTML_ELEMENT_FIGCAPTION,
-  HTML_ELEMENT_FIGURE,
-  HTML_ELEMENT_FOOTER,
-  HTML_ELEMENT_FORM,
-  HTML_ELEMENT_FRAME,
-  HTML_ELEMENT_FRAMESET,
-  HTML_ELEMENT_H1,
-  HTML_ELEMENT_H2,
-  HTML_ELEMENT_H3,
-  HTML_ELEMENT_H4,
-  HTML_ELEMENT_H5,
-  HTML_ELEMENT_H6,
-  HTML_ELEMENT_HEAD,
-  HTML_ELEMENT_HEADER,
-  HTML_ELEMENT_HGROUP,
-  HTML_ELEMENT_HR,
-  HTML_ELEMENT_HTML,
-  HTML_ELEMENT_IFRAME,
-  HTML_ELEMENT_IMG,
-  HTML_ELEMENT_INPUT,
-  HTML_ELEMENT_KEYGEN,
-  HTML_ELEMENT_LI,
-  HTML_ELEMENT_LINK,
-  HTML_ELEMENT_LISTING,
-  HTML_ELEMENT_MAIN,
-  HTML_ELEMENT_MARQUEE,
-  HTML_ELEMENT_MENU,
-  HTML_ELEMENT_META,
-  HTML_ELEMENT_NAV,
-  HTML_ELEMENT_NOEMBED,
-  HTML_ELEMENT_NOFRAMES,
-  HTML_ELEMENT_OBJECT,
-  HTML_ELEMENT_OL,
-  HTML_ELEMENT_P,
-  HTML_ELEMENT_PARAM,
-  HTML_ELEMENT_PLAINTEXT,
-  HTML_ELEMENT_PRE,
-  HTML_ELEMENT_SCRIPT,
-  HTML_ELEMENT_SEARCH,
-  HTML_ELEMENT_SECTION,
-  HTML_ELEMENT_SELECT,
-  HTML_ELEMENT_SOURCE,
-  HTML_ELEMENT_STYLE,
-  HTML_ELEMENT_SUMMARY,
-  HTML_ELEMENT_TABLE,
-  HTML_ELEMENT_TBODY,
-  HTML_ELEMENT_TD,
-  HTML_ELEMENT_TEMPLATE,
-  HTML_ELEMENT_TEXTAREA,
-  HTML_ELEMENT_TFOOT,
-  HTML_ELEMENT_TH,
-  HTML_ELEMENT_THEAD,
-  HTML_ELEMENT_TITLE,
-  HTML_ELEMENT_TR,
-  HTML_ELEMENT_TRACK,
-  HTML_ELEMENT_UL,
-  HTML_ELEMENT_WBR,
-  HTML_ELEMENT_XMP,
-};
-
-
-bool
-TreeBuilder::is_special_element(std::shared_ptr< DOM::Element> element) const
-{
-  /* XXX: other namespaces */
-
-  if (element->name_space == INFRA_NAMESPACE_HTML)
-    return k_special_html_elements_set_.contains(element->local_name);
-
-
-  return false;
-}
-
-
-/*
- * This is used to determine whether we allocate a copy of the tag_token or
- * not when creating the element.
- */
-bool
-TreeBuilder::is_formatting_element(std::shared_ptr< DOM::Element> element) const
+void
+TreeBuilder::push_formatting_marker(void)
 {
-  if (element->name_space != INFRA_NAMESPACE_HTML)
-    return false;
-
-  switch (element->local_name)
-  {
-    case HTML_ELEMENT_A:     case HTML_ELEMENT_B:      case HTML_ELEMENT_BIG:
-    case HTML_ELEMENT_CODE:  case HTML_ELEMENT_EM:     case HTML_ELEMENT_FONT:
-    case HTML_ELEMENT_I:     case HTML_ELEMENT_NOBR:   case HTML_ELEMENT_S:
-    case HTML_ELEMENT_SMALL: case HTML_ELEMENT_STRIKE: case HTML_ELEMENT_STRONG:
-    case HTML_ELEMENT_TT:    case HTML_ELEMENT_U:
-      return true;
-
-    default:
-      return false;
-  }
-
+  this->formatting_elements.push_marker();
 }
 
 
 /*
- * "in scope" algorithms; see 'html_parser/common.h' for details
+ * Compares the snapshots of the elements' tokens; their strings are interned,
+ * so equal strings are the same string_view.
  */
 bool
-TreeBuilder::scope_node_equals_(std::shared_ptr< DOM::Element> node,
-                                std::shared_ptr< DOM::Element> target) const
+TreeBuilder::same_parsed_elements(struct formatting_entry const& lhs,
+                                  struct formatting_entry const& rhs) const
 {
-  return (node == target);
-}
-
-
-bool
-TreeBuilder::scope_node_equals_(std::shared_ptr< DOM::Element> node,
-                                std::initializer_list< enum html_element_index> html_local_names) const
-{
-  if (node->name_space != INFRA_NAMESPACE_HTML)
+  if (! (lhs.element->name_space == rhs.element->name_space
+      && lhs.tag->local_name == rhs.tag->local_name
+      && lhs.tag->n_attributes == rhs.tag->n_attributes))
     return false;
 
-  for (uint16_t local_name : html_local_names)
-    if (node->local_name == local_name)
-      return true;
-
-  return false;
-}
-
-
-/*
- * XXX: check if only HTML namespace
- */
-bool
-TreeBuilder::scope_batch_contains_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                                   std::shared_ptr< DOM::Element> elem) const
-{
-  for (const auto& [name_space, local_name] : *list)
-    if ((name_space == INFRA_NAMESPACE_HTML)
-     && elem->has_html_element_index(local_name))
-      return true;
-
-  return false;
-}
-
-
-bool
-TreeBuilder::scope_batch_contains_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                                   std::initializer_list< enum html_element_index> html_local_names) const
-{
-  for (const auto& [name_space, local_name] : *list)
-  for (const uint16_t cur_html_element : html_local_names)
-    if (name_space == INFRA_NAMESPACE_HTML
-     && local_name == cur_html_element)
-      return false;
-
-  return false;
-}
-
+  auto same_attribute = [](struct saved_attribute const& a, struct saved_attribute const& b) {
+    return (a.name.data() == b.name.data() && a.value.data() == b.value.data());
+  };
 
-template< ScopeTargetable T>
-bool
-TreeBuilder::have_target_node_in_scope_(std::vector< std::pair< uint16_t, uint16_t>> const *list,
-                                        T targets) const
-{
-
-  for (const auto& node : std::ranges::views::reverse(this->open_elements))
-  {
-    if (this->scope_node_equals_(node, targets))
-      return true;
-
-    if (this->scope_batch_contains_(list, targets))
+  /* duplicate attributes were dropped by the tokenizer */
+  for (struct saved_attribute const& attr : lhs.tag->attributes())
+    if (std::ranges::none_of(rhs.tag->attributes(),
+                             [&](auto const& other){ return same_attribute(attr, other); }))
       return false;
-  }
 
-  // std::unreachable();
-  return false;
+  return true;
 }
 
 
-/*
- * Only these can be instantiated
- */
-template
-bool TreeBuilder::have_target_node_in_scope_< std::shared_ptr< DOM::Element>>(
-      std::vector< std::pair< uint16_t, uint16_t>> const *list,
-      std::shared_ptr< DOM::Element> elem) const;
-template
-bool TreeBuilder::have_target_node_in_scope_< std::initializer_list< enum html_element_index>>(
-      std::vector< std::pair< uint16_t, uint16_t>> const *list,
-      std::initializer_list< enum html_element_index> html_local_names) const;
-template
-bool TreeBuilder::have_target_node_in_scope_< enum html_element_index>(
-      std::vector< std::pair< uint16_t, uint16_t>> const *list,
-      enum html_element_index html_local_name) const;
-
-
-#define PARTICULAR_ELEMENT_SCOPE_DEF \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_APPLET           }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_CAPTION          }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_HTML             }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_TABLE            }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_TD               }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_TH               }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_MARQUEE          }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_OBJECT           }, \
-  { INFRA_NAMESPACE_HTML,   HTML_ELEMENT_TEMPLATE         }
-
-  // { INFRA_NAMESPACE_MATHML, MATHML_ELEMENT_MI             },
-  // { INFRA_NAMESPACE_MATHML, MATHML_ELEMENT_MO             },
-  // { INFRA_NAMESPACE_MATHML, MATHML_ELEMENT_MN             },
-  // { INFRA_NAMESPACE_MATHML, MATHML_ELEMENT_MS             },
-  // { INFRA_NAMESPACE_MATHML, MATHML_ELEMENT_MTEXT          },
-  // { INFRA_NAMESPACE_MATHML, MATHML_ELEMENT_ANNOTATION_XML },
-  // { INFRA_NAMESPACE_SVG,    SVG_ELEMENT_FOREIGN_OBJECT    },
-  // { INFRA_NAMESPACE_SVG,    SVG_ELEMENT_DESC              },
-  // { INFRA_NAMESPACE_SVG,    SVG_ELEMENT_TITLE             } 
-
-const std::vector< std::pair< uint16_t, uint16_t>> TreeBuilder::k_particular_scope_def_ = {
-  PARTICULAR_ELEMENT_SCOPE_DEF,
-};
-
-const std::vector< std::pair< uint16_t, uint16_t>> TreeBuilder::k_list_scope_def_ = {
-  PARTICULAR_ELEMENT_SCOPE_DEF,
-  { INFRA_NAMESPACE_HTML, HTML_ELEMENT_OL },
-  { INFRA_NAMESPACE_HTML, HTML_ELEMENT_UL },
-};
-
-const std::vector< std::pair< uint16_t, uint16_t>> TreeBuilder::k_button_scope_def_ = {
-  PARTICULAR_ELEMENT_SCOPE_DEF,
-  { INFRA_NAMESPACE_HTML, HTML_ELEMENT_BUTTON },
-};
-
-const std::vector< std::pair< uint16_t, uint16_t>> TreeBuilder::k_table_scope_def_ = {
-  { INFRA_NAMESPACE_HTML, HTML_ELEMENT_HTML     },
-  { INFRA_NAMESPACE_HTML, HTML_ELEMENT_TABLE    },
-  { INFRA_NAMESPACE_HTML, HTML_ELEMENT_TEMPLATE },
-};
-
-const std::vector< std::pair< uint16_t, uint16_t>> TreeBuilder::k_select_scope_def_ = {
- { INFRA_NAMESPACE_HTML, HTML_ELEMENT_OPTGROUP },
- { INFRA_NAMESPACE_HTML, HTML_ELEMENT_OPTION   },
-};
-
-#undef PARTICULAR_ELEMENT_SCOPE_DEF
-
-
 void
-TreeBuilder::push_formatting_marker(void)
+TreeBuilder::push_to_active_formatting_elements(DOM::Element *element,
+                                                struct tag_token const *tag)
 {
-  this->formatting_elements.push_back(this->FORMATTING_MARKER);
-}
-
-
-bool
-TreeBuilder::same_parsed_elements(std::shared_ptr< DOM::Element> lhs,
-                                  std::shared_ptr< DOM::Element> rhs) const
-{
-  if (! (lhs->name_space == rhs->name_space
-      && lhs->local_name == rhs->local_name))
-    return false;
-
-  /* XXX: compare attributes */
-
-  return true;
-}
+  auto& afe = this->formatting_elements;
 
+  /*
+   * Step 2. comes first, so that there is a snapshot of the token to compare
+   * against; it doesn't change which entry step 1. removes.
+   */
+  afe.push_back(element, tag);
 
-void
-TreeBuilder::push_to_active_formatting_elements(std::shared_ptr< DOM::Element> element)
-{
   /* Step 1. */
-  std::shared_ptr< DOM::Element> fitting_entry = nullptr;
+  int fitting_entry = ActiveFormattingList::k_none;
   int n_fitting_entries = 0;
 
-  for (const auto &entry : std::ranges::views::reverse(this->formatting_elements))
+  for (int i = static_cast<int>(afe.size()) - 2; i >= 0; i--)
   {
-    if (entry == this->FORMATTING_MARKER)
+    if (afe[i].is_marker())
       break;
 
-    if (this->same_parsed_elements(entry, element)) {
+    if (this->same_parsed_elements(afe[i], afe.back())) {
       n_fitting_entries++;
-      fitting_entry = entry;
+      fitting_entry = i;
     }
 
   }
 
   if (n_fitting_entries >= 3)
-    this->formatting_elements.remove(fitting_entry);
-
-  /* Step 2. */
-  this->formatting_elements.push_back(element);
+    afe.erase(fitting_entry);
 }
 
 
 void
 TreeBuilder::reconstruct_active_formatting_elements(void)
 {
+  auto& afe = this->formatting_elements;
+
   /* Step 1. */
-  if (this->formatting_elements.empty())
+  if (afe.empty())
     return;
 
   /* Step 2. */
   auto& stack = this->open_elements;
 
-  if (this->formatting_elements.back() == this->FORMATTING_MARKER
-   || std::find(stack.begin(), stack.end(), this->formatting_elements.back()) != stack.end())
+  if (afe.back().is_marker()
+   || stack.contains(afe.back().element))
     return;
 
   /* Step 3. */
-  auto entry_it = std::prev(this->formatting_elements.end());
+  size_t entry_idx = afe.size() - 1;
 
   /* Step 4. */
 rewind:
-  if (entry_it == this->formatting_elements.begin())
+  if (entry_idx == 0)
     goto create;
 
   /* Step 5. */
-  entry_it--;
+  entry_idx--;
 
   /* Step 6. */
-  if (*entry_it != this->FORMATTING_MARKER
-   && std::find(stack.begin(), stack.end(), *entry_it) == stack.end())
+  if (! afe[entry_idx].is_marker()
+   && ! stack.contains(afe[entry_idx].element))
     goto rewind;
 
   /* Step 7. */
 advance:
-  entry_it++;
+  entry_idx++;
 
   /* Step 8. */
 create:
-  struct tag_token *tag = &this->saved_tags.at( *entry_it );
-  std::shared_ptr< DOM::Element> new_element = std::dynamic_pointer_cast<DOM::Element>(
-   this->insert_html_element(tag));
+  struct tag_token tag = afe[entry_idx].tag->to_token();
+  DOM::Element *new_element = this->insert_html_element(&tag).get();
 
   /* Step 9. */
-  *entry_it = new_element;
-  auto new_element_it = entry_it;
-
+  afe.replace(entry_idx, new_element);
 
   /* Step 10. */
-  if (new_element_it != std::prev(this->formatting_elements.end()))
+  if (entry_idx != afe.size() - 1)
     goto advance;
 }
 
@@ -594,13 +670,13 @@ TreeBuilder::clear_active_formatting_elements_to_marker(void)
 
   while (true)  {
     /* Step 1. */
-    auto entry_it = std::prev(this->formatting_elements.end());
+    bool marker = this->formatting_elements.back().is_marker();
 
     /* Step 2. */
-    this->formatting_elements.erase(entry_it);
+    this->formatting_elements.pop_back();
 
     /* Step 3. */
-    if (*entry_it == this->FORMATTING_MARKER)
+    if (marker)
       return;
 
     /* Step 4. LOOP */
@@ -618,13 +694,13 @@ TreeBuilder::acknowledge_self_closing_flag(struct tag_token *tag) const
 
 
 InsertionLocation
-TreeBuilder::appropriate_insertion_place(std::shared_ptr< DOM::Element> override_target)
+TreeBuilder::appropriate_insertion_place(DOM::Element *override_target)
 {
   InsertionLocation location = { nullptr, nullptr };
 
-  std::shared_ptr< DOM::Element> target = override_target != nullptr
-                                       ? override_target
-                                       : this->current_node();
+  DOM::Element *target = override_target != nullptr
+                       ? override_target
+                       : this->current_node();
 
   if (this->flags.foster_parenting
    && (target->has_html_element_index(HTML_ELEMENT_TABLE)
@@ -632,23 +708,23 @@ TreeBuilder::appropriate_insertion_place(std::shared_ptr< DOM::Element> override
     || target->has_html_element_index(HTML_ELEMENT_TFOOT)
     || target->has_html_element_index(HTML_ELEMENT_THEAD)
     || target->has_html_element_index(HTML_ELEMENT_TR))) {
-    std::shared_ptr< DOM::Element> last_template = nullptr;
-    std::shared_ptr< DOM::Element> last_table    = nullptr;
+    DOM::Element *last_template = nullptr;
+    DOM::Element *last_table    = nullptr;
     int last_template_idx = -1;
     int last_table_idx    = -1;
 
     for (int i = 0; i < static_cast<long int>(this->open_elements.size()); i++) {
-      auto node = this->open_elements[i];
+      struct open_element const& node = this->open_elements[i];
 
-      if (node->has_html_element_index(HTML_ELEMENT_TEMPLATE)) {
-        last_template     = node;
+      if (node.has_html_element_index(HTML_ELEMENT_TEMPLATE)) {
+        last_template     = node.element;
         last_template_idx = i;
         continue;
       }
 
 
-      if (node->has_html_element_index(HTML_ELEMENT_TABLE)) {
-        last_table     = node;
+      if (node.has_html_element_index(HTML_ELEMENT_TABLE)) {
+        last_table     = node.element;
         last_table_idx = i;
         continue;
       }
@@ -666,26 +742,26 @@ TreeBuilder::appropriate_insertion_place(std::shared_ptr< DOM::Element> override
 
     if (last_table == nullptr) {
       /* fragment case */
-      location.parent = std::dynamic_pointer_cast<DOM::Node>(this->open_elements.front());
+      location.parent = TreeBuilder::share_element(this->open_elements.front().element);
       location.child  = nullptr;
       goto sanitize;
     }
 
 
-    std::shared_ptr< DOM::Element> prev_elem = this->open_elements[last_table_idx + 1];
+    DOM::Element *prev_elem = this->open_elements[last_table_idx + 1].element;
 
-    location.parent = std::dynamic_pointer_cast<DOM::Node>(prev_elem);
+    location.parent = TreeBuilder::share_element(prev_elem);
     location.child  = nullptr;
 
   } else {
-    location.parent = target;
+    location.parent = TreeBuilder::share_element(target);
     location.child  = nullptr;
   }
 
 
 sanitize:
   if (location.parent->is_element()
-   && std::dynamic_pointer_cast<DOM::Element>(location.parent)->has_html_element_index(HTML_ELEMENT_TEMPLATE)) {
+   && static_cast<DOM::Element const *>(location.parent.get())->has_html_element_index(HTML_ELEMENT_TEMPLATE)) {
     /* XXX: template contents */
   }
 
@@ -708,8 +784,8 @@ TreeBuilder::create_element_for_token(struct tag_token const *tag,
   bool exec_script = (definition != nullptr && this->context == nullptr);
 
   assert( name_space == INFRA_NAMESPACE_HTML );
-  fprintf(stderr, "tag_name: %s\n", tag->tag_name.c_str());
-  local_name = HTML::k_local_names_table.at(tag->tag_name);
+  /* resolved once by the tokenizer (or set on the dummy tokens) */
+  local_name = tag->local_name;
   /* ... */
 
   std::shared_ptr< DOM::Element> element =
@@ -717,54 +793,60 @@ TreeBuilder::create_element_for_token(struct tag_token const *tag,
 
   /* ... */
 
-
-  /*
-   * Needed for the list of active formatting elements
-   */
-  if (this->is_formatting_element(element))
-    this->saved_tags.emplace(element, *tag);
-
   return element;
 }
 
 
-std::shared_ptr< DOM::Node>
-TreeBuilder::node_before(InsertionLocation location)
+DOM::Node *
+TreeBuilder::node_before(InsertionLocation const& location)
 {
-  /*
-   * XXX: very sus function
-   */
+  if (location.parent == nullptr)
+    return nullptr;
 
-  if (location.parent != nullptr
-   && location.child != nullptr)
+  if (location.child != nullptr)
     return location.child->get_previous_sibling();
 
-  if (location.parent != nullptr
-   && location.child == nullptr)
-    return location.parent->get_previous_sibling();
-
-  return nullptr;
+  return location.parent->get_last_child();
 }
 
 
+/*
+ * The location's child is always nullptr with events; see
+ * html_parser/tree_events.hh
+ */
 void
 TreeBuilder::insert_element_at_location(InsertionLocation location,
-                                        std::shared_ptr< DOM::Element> element) const
+                                        std::shared_ptr< DOM::Element> element,
+                                        struct tag_token const *tag)
 {
+  if (this->events != nullptr) {
+    this->events->open_element(element.get(), location.parent.get(), tag);
+    this->keep_element_(element);
+    return;
+  }
+
   location.parent->insert_node(std::dynamic_pointer_cast<DOM::Node>(element),
    location.child);
 }
 
 
+std::shared_ptr< DOM::Element>
+TreeBuilder::share_element(DOM::Element *element)
+{
+  return std::static_pointer_cast<DOM::Element>(element->shared_from_this());
+}
+
+
 void
-TreeBuilder::insert_element_at_adjusted_insertion_location(std::shared_ptr< DOM::Element> element)
+TreeBuilder::insert_element_at_adjusted_insertion_location(std::shared_ptr< DOM::Element> element,
+                                                           struct tag_token const *tag)
 {
   InsertionLocation location = this->appropriate_insertion_place();
   /* XXX: check if can insert */
 
   /* XXX: custom element reactions */
 
-  this->insert_element_at_location(location, element);
+  this->insert_element_at_location(location, element, tag);
 
   /* XXX: invoke custom element reactions */
 }
@@ -781,9 +863,9 @@ TreeBuilder::insert_foreign_element(struct tag_token const *tag,
    this->create_element_for_token(tag, name_space, location.parent);
 
   if (! only_add_to_element_stack )
-    this->insert_element_at_adjusted_insertion_location(element);
+    this->insert_element_at_adjusted_insertion_location(element, tag);
 
-  this->open_elements.push_back(element);
+  this->open_elements.push_back(element.get());
 
   return element;
 }
@@ -797,14 +879,31 @@ TreeBuilder::insert_html_element(struct tag_token const *tag)
 
 
 void
-TreeBuilder::insert_character_array_(char32_t const *arr, size_t arr_len)
+TreeBuilder::insert_characters(std::string_view data)
 {
+  auto& pending = this->pending_text_;
+
+  if (pending.text != nullptr
+   && ! this->flags.foster_parenting
+   && pending.target == this->current_node()
+   && pending.parent->get_last_child() == pending.text) {
+    pending.data.append(data);
+    return;
+  }
+
+  this->flush_pending_text();
+
   InsertionLocation location = this->appropriate_insertion_place();
 
   if (location.parent->is_document())
     return;
 
-  std::shared_ptr< DOM::Node> prev_sibling = TreeBuilder::node_before(location);
+  if (this->events != nullptr) {
+    this->events->text(location.parent.get(), data);
+    return;
+  }
+
+  DOM::Node *prev_sibling = TreeBuilder::node_before(location);
 
 #if 0
   LOGF("{ %p, %p }\n",
@@ -812,43 +911,59 @@ TreeBuilder::insert_character_array_(char32_t const *arr, size_t arr_len)
     reinterpret_cast<void *>(location.child.get()));
 #endif
 
-  std::shared_ptr< DOM::Text> text = nullptr;
+  DOM::Text *text = nullptr;
 
   if ((prev_sibling != nullptr) && prev_sibling->is_text()) {
-    text = std::dynamic_pointer_cast<DOM::Text>(prev_sibling);
+    text = static_cast<DOM::Text *>(prev_sibling);
   } else {
-    text = std::make_shared<DOM::Text>(this->document);
-    location.parent->insert_node(std::dynamic_pointer_cast<DOM::Node>(text),
-     location.child);
+    std::shared_ptr< DOM::Text> new_text = this->document->create_node<DOM::Text>(this->document);
+    text = new_text.get();
+    location.parent->insert_node(new_text, location.child);
   }
 
-  for (int i = 0; i < static_cast<long int>(arr_len); i++)
-    QueequegLib::append_c32_as_utf8(&text->data, arr[i]);
-
+  pending.target = this->current_node();
+  pending.parent = location.parent.get();
+  pending.text = text;
+  pending.data.append(data);
 }
 
 
 void
-TreeBuilder::insert_characters(std::vector< char32_t> const *vch)
+TreeBuilder::flush_pending_text(void)
 {
-  this->insert_character_array_(vch->data(), vch->size());
+  auto& pending = this->pending_text_;
+
+  if (pending.text == nullptr)
+    return;
+
+  pending.text->data.append(pending.data);
+
+  pending.text = nullptr;
+  pending.data.clear();
 }
 
 
 void
 TreeBuilder::insert_character(char32_t ch)
 {
-  this->insert_character_array_(&ch, 1);
+  char utf8[4];
+  size_t len = grapheme_encode_utf8(ch, utf8, sizeof (utf8));
+
+  this->insert_characters(std::string_view{ utf8, len });
 }
 
 
 void
-TreeBuilder::insert_comment(std::string *data,
+TreeBuilder::insert_comment(QueequegLib::BorrowedString const *data,
                             InsertionLocation location)
 {
+  if (this->events != nullptr) {
+    this->events->comment(location.parent.get(), data->view());
+    return;
+  }
+
   std::shared_ptr< DOM::Comment> comment =
-   std::make_shared<DOM::Comment>(location.parent->node_document.lock(),
-                                 *data);
+   this->document->create_node<DOM::Comment>(this->document, data->view());
 
   location.parent->insert_node(std::dynamic_pointer_cast<DOM::Node>(comment),
    location.child);
@@ -856,13 +971,109 @@ TreeBuilder::insert_comment(std::string *data,
 }
 
 
+void
+TreeBuilder::insert_doctype(struct doctype_token const *token)
+{
+  if (this->events != nullptr) {
+    this->events->doctype(token);
+    return;
+  }
+
+  std::shared_ptr< DOM::DocumentType> doctype =
+   this->document->create_node<DOM::DocumentType>(this->document);
+
+  doctype->name = token->name;
+
+  if (! token->public_id_missing)
+    doctype->public_id = token->public_id;
+
+  if (! token->system_id_missing)
+    doctype->system_id = token->system_id;
+
+  this->document->append_node(doctype);
+
+  /* XXX: ... */
+  LOGF("doctype node_document: %p\n", static_cast<void *>(doctype->node_document.lock().get()));
+}
+
+
+[[nodiscard]]
+std::shared_ptr< DOM::Element>
+TreeBuilder::create_element_for_adoption(struct tag_token const *tag,
+                                         DOM::Element *intended_parent)
+{
+  std::shared_ptr< DOM::Element> element =
+   this->create_element_for_token(tag, INFRA_NAMESPACE_HTML,
+                                  TreeBuilder::share_element(intended_parent));
+
+  if (this->events != nullptr) {
+    this->events->open_element(element.get(), nullptr, tag);
+    this->keep_element_(element);
+  }
+
+  return element;
+}
+
+
+/*
+ * Appends element to the location's parent, taking it out of where it was
+ */
+void
+TreeBuilder::move_element(std::shared_ptr< DOM::Element> element, InsertionLocation location)
+{
+  if (this->events != nullptr) {
+    this->events->move_element(element.get(), location.parent.get());
+    return;
+  }
+
+  location.parent->insert_node(std::dynamic_pointer_cast<DOM::Node>(element),
+   location.child);
+}
+
+
+void
+TreeBuilder::move_children(DOM::Element *from, DOM::Element *to)
+{
+  if (this->events != nullptr) {
+    this->events->move_children(from, to);
+    return;
+  }
+
+  while (DOM::Node *child = from->get_first_child())
+    to->append_node(child->share_node());
+}
+
+
+void
+TreeBuilder::keep_element_(std::shared_ptr< DOM::Element> element)
+{
+  this->live_elements_.push_back(std::move(element));
+}
+
+
+/*
+ * Only in between tokens, when the stack of open elements and the list of
+ * active formatting elements are all that points to elements
+ */
+void
+TreeBuilder::release_dead_elements_(void)
+{
+  std::erase_if(this->live_elements_, [](std::shared_ptr< DOM::Element> const& element) {
+    return (element->parser_index.open_element < 0 && element->parser_index.formatting < 0);
+  });
+
+  this->release_at_ = std::max(TreeBuilder::k_min_live_elements_,
+                               2 * this->live_elements_.size());
+}
+
+
 [[nodiscard]]
 enum treebuilder_status
 TreeBuilder::generic_raw_text_parse(struct tag_token *tag)
 {
   this->insert_html_element(tag);
 
-  this->tokenizer->state = RAWTEXT_STATE;
+  this->switch_tokenizer_state(RAWTEXT_STATE);
 
   this->original_mode = this->mode;
   this->mode = TEXT_MODE;
@@ -877,7 +1088,7 @@ TreeBuilder::generic_rcdata_parse(struct tag_token *tag)
 {
   this->insert_html_element(tag);
 
-  this->tokenizer->state = RCDATA_STATE;
+  this->switch_tokenizer_state(RCDATA_STATE);
 
   this->original_mode = this->mode;
   this->mode = TEXT_MODE;
@@ -891,26 +1102,16 @@ TreeBuilder::generate_implied_end_tags(uint16_t exclude_html)
 {
 
   while (true) {
-    const std::shared_ptr< DOM::Element> cur_node = this->current_node();
+    struct open_element const& cur_node = this->open_elements.back();
 
 
     if (exclude_html != 0
-     && cur_node->name_space == INFRA_NAMESPACE_HTML
-     && cur_node->local_name == exclude_html)
+     && cur_node.name_space == INFRA_NAMESPACE_HTML
+     && cur_node.local_name == exclude_html)
       break;
 
 
-    if ((cur_node->name_space == INFRA_NAMESPACE_HTML)
-     && (cur_node->local_name == HTML_ELEMENT_DD
-      || cur_node->local_name == HTML_ELEMENT_DT
-      || cur_node->local_name == HTML_ELEMENT_LI
-      || cur_node->local_name == HTML_ELEMENT_OPTGROUP
-      || cur_node->local_name == HTML_ELEMENT_OPTION
-      || cur_node->local_name == HTML_ELEMENT_P
-      || cur_node->local_name == HTML_ELEMENT_RB
-      || cur_node->local_name == HTML_ELEMENT_RP
-      || cur_node->local_name == HTML_ELEMENT_RT
-      || cur_node->local_name == HTML_ELEMENT_RTC)) {
+    if (cur_node.has_category(ELEMENT_IMPLIED_END_TAG)) {
       this->open_elements.pop_back();
       continue;
     }
@@ -920,3 +1121,11 @@ TreeBuilder::generate_implied_end_tags(uint16_t exclude_html)
 
 }
 
+
+void
+TreeBuilder::generate_all_implied_end_tags_thoroughly(void)
+{
+  while (this->open_elements.back().has_category(ELEMENT_THOROUGHLY_IMPLIED_END_TAG))
+    this->open_elements.pop_back();
+}
+
@@ -0,0 +1,180 @@
+#ifndef _queequeg_qglib_borrowed_string_hh_
+#define _queequeg_qglib_borrowed_string_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: qglib/borrowed_string.hh
+ *
+ * Description:
+ * A string that starts out as a view into a buffer owned by somebody else
+ * (typically the parser input) and only copies its contents into a buffer of
+ * its own once it stops being a verbatim slice of it.
+ */
+
+#include <compare>
+#include <string>
+#include <string_view>
+
+#include <stddef.h>
+
+#include "qglib/unicode.hh"
+
+
+namespace QueequegLib {
+
+
+class BorrowedString final {
+  public:
+    BorrowedString(void) = default;
+
+    BorrowedString(std::string_view sv)
+    : borrowed_(sv.data()), size_(sv.size()) { }
+
+    BorrowedString(char const *c_str)
+    : BorrowedString(std::string_view{ c_str }) { }
+
+    BorrowedString(BorrowedString const& other) = default;
+    BorrowedString(BorrowedString&& other) = default;
+    BorrowedString& operator=(BorrowedString const& other) = default;
+    BorrowedString& operator=(BorrowedString&& other) = default;
+
+    ~BorrowedString() = default;
+
+
+  public:
+    [[nodiscard]]
+    inline std::string_view
+    view(void) const
+    {
+      if (this->owned_flag_)
+        return this->owned_;
+
+      return std::string_view{ this->borrowed_, this->size_ };
+    }
+
+    inline operator std::string_view() const { return this->view(); }
+
+    [[nodiscard]] inline char const *data(void) const { return this->view().data(); }
+    [[nodiscard]] inline size_t size(void) const { return this->view().size(); }
+    [[nodiscard]] inline bool empty(void) const { return this->size() == 0; }
+
+    [[nodiscard]] inline bool is_borrowed(void) const { return ! this->owned_flag_; }
+
+
+    /*
+     * Keeps the owned buffer's capacity around for the next token
+     */
+    inline void
+    clear(void)
+    {
+      this->borrowed_ = nullptr;
+      this->size_ = 0;
+      this->owned_.clear();
+      this->owned_flag_ = false;
+    }
+
+
+    /*
+     * Extends the view by [s, s + n) if that range directly follows it in the
+     * same buffer; copies otherwise.
+     */
+    inline void
+    append_borrowed(char const *s, size_t n)
+    {
+      if (! this->owned_flag_) {
+        if (this->size_ == 0)
+          this->borrowed_ = s;
+
+        if (this->borrowed_ + this->size_ == s) {
+          this->size_ += n;
+          return;
+        }
+      }
+
+      this->append(s, n);
+    }
+
+
+    inline void
+    append(char const *s, size_t n)
+    {
+      this->own();
+      this->owned_.append(s, n);
+    }
+
+    inline void
+    append(std::string_view sv)
+    {
+      this->append(sv.data(), sv.size());
+    }
+
+    inline void
+    append_c32(char32_t ch)
+    {
+      this->own();
+      QueequegLib::append_c32_as_utf8(&this->owned_, ch);
+    }
+
+
+    /*
+     * Detaches the string from the buffer it borrows from, e.g. before that
+     * buffer goes away.
+     */
+    inline void
+    own(void)
+    {
+      if (this->owned_flag_)
+        return;
+
+      this->owned_.assign(this->borrowed_, this->size_);
+      this->owned_flag_ = true;
+    }
+
+
+    friend inline bool
+    operator==(BorrowedString const& lhs, std::string_view rhs)
+    {
+      return lhs.view() == rhs;
+    }
+
+    friend inline std::strong_ordering
+    operator<=>(BorrowedString const& lhs, std::string_view rhs)
+    {
+      return lhs.view() <=> rhs;
+    }
+
+    friend inline bool
+    operator==(BorrowedString const& lhs, char const *rhs)
+    {
+      return lhs.view() == rhs;
+    }
+
+    friend inline bool
+    operator==(BorrowedString const& lhs, BorrowedString const& rhs)
+    {
+      return lhs.view() == rhs.view();
+    }
+
+    friend inline std::strong_ordering
+    operator<=>(BorrowedString const& lhs, BorrowedString const& rhs)
+    {
+      return lhs.view() <=> rhs.view();
+    }
+
+
+  private:
+    char const *borrowed_ = nullptr;
+    size_t size_ = 0;
+
+    std::string owned_;
+    bool owned_flag_ = false;
+};
+
+
+}; /* namespace QueequegLib */
+
+
+#endif /* !defined(_queequeg_qglib_borrowed_string_hh_) */
@@ -0,0 +1,178 @@
+#ifndef _queequeg_qglib_perfect_hash_hh_
+#define _queequeg_qglib_perfect_hash_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: qglib/perfect_hash.hh
+ *
+ * Description:
+ * Compile-time perfect hashing over a fixed set of short strings, on top of
+ * FNV-1a so that callers can hash incrementally as the bytes come in (e.g.
+ * while tokenizing a tag name) and only resolve the slot at the end.
+ *
+ * Tables are built with "hash and displace": keys are spread over buckets by
+ * their hash, and every bucket gets the smallest displacement that sends all
+ * of its keys to free slots. Lookups cost one hash mix, two loads and a
+ * final comparison against the candidate key.
+ */
+
+#include <array>
+#include <string_view>
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+namespace QueequegLib {
+
+
+inline constexpr uint32_t k_fnv1a_basis = 2166136261u;
+
+
+[[nodiscard]]
+constexpr uint32_t
+fnv1a_step(uint32_t hash, unsigned char byte)
+{
+  return (hash ^ byte) * 16777619u;
+}
+
+
+[[nodiscard]]
+constexpr uint32_t
+fnv1a(std::string_view s)
+{
+  uint32_t hash = k_fnv1a_basis;
+
+  for (char c : s)
+    hash = fnv1a_step(hash, static_cast<unsigned char>(c));
+
+  return hash;
+}
+
+
+/*
+ * murmur3's finalizer; FNV-1a alone is too weak in the low bits for short keys
+ */
+[[nodiscard]]
+constexpr uint32_t
+hash_mix(uint32_t h)
+{
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+
+  return h;
+}
+
+
+template< size_t NumBuckets, size_t NumSlots>
+struct PerfectHashTable {
+  std::array<uint16_t, NumBuckets> displacement;
+  /*
+   * key index + 1, or 0 for an empty slot
+   */
+  std::array<uint16_t, NumSlots> slots;
+
+
+  [[nodiscard]]
+  static constexpr size_t
+  bucket_of(uint32_t hash)
+  {
+    return hash % NumBuckets;
+  }
+
+  [[nodiscard]]
+  static constexpr size_t
+  slot_of(uint32_t hash, uint16_t displacement)
+  {
+    return hash_mix(hash + displacement) % NumSlots;
+  }
+
+  /*
+   * Returns the index of the only key that may hash to hash, or -1 if there
+   * is none; the caller must still compare the key itself.
+   */
+  [[nodiscard]]
+  constexpr int
+  find(uint32_t hash) const
+  {
+    uint16_t displacement = this->displacement[bucket_of(hash)];
+
+    return static_cast<int>(this->slots[slot_of(hash, displacement)]) - 1;
+  }
+};
+
+
+/*
+ * Meant for constexpr/consteval contexts only; a key set that can't be placed
+ * (duplicate keys, too few slots) fails to compile through the throw.
+ */
+template< size_t NumBuckets, size_t NumSlots, size_t NumKeys>
+[[nodiscard]]
+constexpr PerfectHashTable<NumBuckets, NumSlots>
+make_perfect_hash(std::array<std::string_view, NumKeys> const& keys)
+{
+  static_assert(NumKeys < NumSlots && NumSlots < 0xFFFF);
+
+  PerfectHashTable<NumBuckets, NumSlots> table = { };
+  std::array<size_t, NumBuckets> bucket_size = { };
+  std::array<bool, NumBuckets> placed = { };
+
+  for (size_t i = 0; i < NumKeys; i++)
+    bucket_size[table.bucket_of(fnv1a(keys[i]))]++;
+
+  /* biggest buckets first, while there is still room */
+  for (size_t round = 0; round < NumBuckets; round++) {
+    size_t bucket = NumBuckets;
+
+    for (size_t b = 0; b < NumBuckets; b++)
+      if (! placed[b] && (bucket == NumBuckets || bucket_size[b] > bucket_size[bucket]))
+        bucket = b;
+
+    placed[bucket] = true;
+
+    if (bucket_size[bucket] == 0)
+      continue;
+
+    for (uint32_t d = 0; ; d++) {
+      if (d == 0xFFFF)
+        throw "make_perfect_hash: no displacement found";
+
+      std::array<uint16_t, NumSlots> slots = table.slots;
+      bool ok = true;
+
+      for (size_t i = 0; ok && i < NumKeys; i++) {
+        uint32_t hash = fnv1a(keys[i]);
+
+        if (table.bucket_of(hash) != bucket)
+          continue;
+
+        size_t slot = table.slot_of(hash, static_cast<uint16_t>(d));
+
+        if (slots[slot] != 0)
+          ok = false;
+        else
+          slots[slot] = static_cast<uint16_t>(i + 1);
+      }
+
+      if (ok) {
+        table.displacement[bucket] = static_cast<uint16_t>(d);
+        table.slots = slots;
+        break;
+      }
+    }
+  }
+
+  return table;
+}
+
+
+}; /* namespace QueequegLib */
+
+
+#endif /* !defined(_queequeg_qglib_perfect_hash_hh_) */
@@ -0,0 +1,85 @@
+#ifndef _queequeg_qglib_scan_hh_
+#define _queequeg_qglib_scan_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: qglib/scan.hh
+ *
+ * Description:
+ * Byte scanners for hot loops that only care about a handful of ASCII
+ * delimiters. The SIMD variants are picked at compile time (-march=native
+ * in config.mk); every target gets the scalar loop for the tail.
+ */
+
+#include <bit>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+# include <immintrin.h>
+#endif
+
+
+namespace QueequegLib {
+
+
+/*
+ * Returns a pointer to the first byte in [p, end) which is either non-ASCII
+ * or equal to one of Delims, or end if the whole range is "safe".
+ */
+template< char... Delims>
+[[nodiscard]] inline char const *
+find_ascii_run_end(char const *p, char const *end)
+{
+#if defined(__AVX2__)
+  while (end - p >= 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+    __m256i hit = _mm256_setzero_si256();
+
+    ((hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(Delims)))), ...);
+
+    /* the sign bit of each byte doubles as the non-ASCII test */
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(hit, v)));
+
+    if (mask != 0)
+      return p + std::countr_zero(mask);
+
+    p += 32;
+  }
+#endif
+
+#if defined(__SSE2__)
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+    __m128i hit = _mm_setzero_si128();
+
+    ((hit = _mm_or_si128(hit, _mm_cmpeq_epi8(v, _mm_set1_epi8(Delims)))), ...);
+
+    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(hit, v)));
+
+    if (mask != 0)
+      return p + std::countr_zero(mask);
+
+    p += 16;
+  }
+#endif
+
+  for (; p < end; ++p) {
+    unsigned char c = static_cast<unsigned char>(*p);
+
+    if (c >= 0x80 || ((*p == Delims) || ...))
+      return p;
+  }
+
+  return end;
+}
+
+
+}; /* namespace QueequegLib */
+
+
+#endif /* !defined(_queequeg_qglib_scan_hh_) */
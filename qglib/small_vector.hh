@@ -0,0 +1,144 @@
+#ifndef _queequeg_qglib_small_vector_hh_
+#define _queequeg_qglib_small_vector_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: qglib/small_vector.hh
+ *
+ * Description:
+ * A vector that keeps its first N elements inline and only goes to the heap
+ * past that. Meant for short, frequently rebuilt lists; elements in the
+ * inline storage are reused (assigned to) rather than destroyed on clear().
+ */
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <stddef.h>
+
+
+namespace QueequegLib {
+
+
+template< typename T, size_t N>
+class SmallVector final {
+  public:
+    SmallVector(void) = default;
+
+    SmallVector(SmallVector const& other) { *this = other; }
+    SmallVector(SmallVector&& other) { *this = std::move(other); }
+
+    /*
+     * Only the elements in use are copied (or moved), not whatever clear()
+     * left behind in the inline storage
+     */
+    SmallVector&
+    operator=(SmallVector const& other)
+    {
+      if (this == &other)
+        return *this;
+
+      this->clear();
+
+      if (other.spilled_) {
+        this->heap_ = other.heap_;
+        this->spilled_ = true;
+      } else {
+        std::copy(other.inline_, other.inline_ + other.size_, this->inline_);
+        this->size_ = other.size_;
+      }
+
+      return *this;
+    }
+
+    SmallVector&
+    operator=(SmallVector&& other)
+    {
+      if (this == &other)
+        return *this;
+
+      this->clear();
+
+      if (other.spilled_) {
+        this->heap_ = std::move(other.heap_);
+        this->spilled_ = true;
+      } else {
+        std::move(other.inline_, other.inline_ + other.size_, this->inline_);
+        this->size_ = other.size_;
+      }
+
+      other.clear();
+
+      return *this;
+    }
+
+
+  public:
+    [[nodiscard]] inline T *data(void) { return this->spilled_ ? this->heap_.data() : this->inline_; }
+    [[nodiscard]] inline T const *data(void) const { return this->spilled_ ? this->heap_.data() : this->inline_; }
+
+    [[nodiscard]] inline size_t size(void) const { return this->spilled_ ? this->heap_.size() : this->size_; }
+    [[nodiscard]] inline bool empty(void) const { return this->size() == 0; }
+
+    [[nodiscard]] inline T *begin(void) { return this->data(); }
+    [[nodiscard]] inline T *end(void) { return this->data() + this->size(); }
+    [[nodiscard]] inline T const *begin(void) const { return this->data(); }
+    [[nodiscard]] inline T const *end(void) const { return this->data() + this->size(); }
+
+    [[nodiscard]] inline T& operator[](size_t i) { return this->data()[i]; }
+    [[nodiscard]] inline T const& operator[](size_t i) const { return this->data()[i]; }
+
+    [[nodiscard]] inline T& back(void) { return this->data()[this->size() - 1]; }
+
+
+    /*
+     * References to elements stay valid until the next push_back()
+     */
+    inline T&
+    push_back(T value)
+    {
+      if (! this->spilled_) {
+        if (this->size_ < N) {
+          this->inline_[this->size_] = std::move(value);
+          return this->inline_[this->size_++];
+        }
+
+        this->heap_.reserve(2 * N);
+
+        for (size_t i = 0; i < this->size_; i++)
+          this->heap_.push_back(std::move(this->inline_[i]));
+
+        this->spilled_ = true;
+      }
+
+      this->heap_.push_back(std::move(value));
+      return this->heap_.back();
+    }
+
+
+    inline void
+    clear(void)
+    {
+      this->size_ = 0;
+      this->heap_.clear();
+      this->spilled_ = false;
+    }
+
+
+  private:
+    T inline_[N] = { };
+    size_t size_ = 0;
+
+    std::vector<T> heap_;
+    bool spilled_ = false;
+};
+
+
+} /* namespace QueequegLib */
+
+
+#endif /* !defined(_queequeg_qglib_small_vector_hh_) */
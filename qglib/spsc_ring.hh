@@ -0,0 +1,195 @@
+#ifndef _queequeg_qglib_spsc_ring_hh_
+#define _queequeg_qglib_spsc_ring_hh_
+
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: qglib/spsc_ring.hh
+ *
+ * Description:
+ * Bounded lock-free queue between exactly one producer thread and one
+ * consumer thread. Slots are constructed once and then reused in place:
+ * the producer reserves the next free slot, fills it in and commits it, the
+ * consumer reads the oldest committed slot and pops it. Either side only
+ * looks at the other's index when its own cached copy says the ring is full
+ * (or empty), so they rarely contend for the same cache line.
+ *
+ * reserve() and front() wait for room (or for a slot) instead of failing:
+ * they yield to the other side a few times, which usually gives it the time
+ * to catch up, then sleep on its index until its pop() (or commit()) moves
+ * it.
+ */
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <stddef.h>
+
+
+namespace QueequegLib {
+
+
+template< typename T, size_t N>
+class SPSCRing final {
+  static_assert((N & (N - 1)) == 0, "capacity must be a power of two");
+
+  public:
+    SPSCRing(void)
+    : slots_(std::make_unique< T[]>(N)) { }
+
+    SPSCRing(SPSCRing const& other) = delete;
+    SPSCRing& operator=(SPSCRing const& other) = delete;
+
+
+  public:
+    static constexpr size_t k_capacity = N;
+
+    /*
+     * Producer side; nullptr if the ring is full
+     */
+    [[nodiscard]]
+    inline T *
+    try_reserve(void)
+    {
+      size_t tail = this->producer_.tail;
+
+      if (tail - this->producer_.cached_head == N) {
+        this->producer_.cached_head = this->head_.load(std::memory_order_acquire);
+
+        if (tail - this->producer_.cached_head == N)
+          return nullptr;
+      }
+
+      return &this->slots_[tail & (N - 1)];
+    }
+
+    [[nodiscard]]
+    inline T *
+    reserve(void)
+    {
+      for (size_t spins = 0; ; spins++) {
+        if (T *slot = this->try_reserve(); slot != nullptr)
+          return slot;
+
+        if (spins < k_spin_limit_)
+          std::this_thread::yield();
+        else
+          this->head_.wait(this->producer_.cached_head, std::memory_order_acquire);
+      }
+    }
+
+    /*
+     * Publishes the slot returned by the last try_reserve() (or reserve())
+     */
+    inline void
+    commit(void)
+    {
+      this->tail_.store(++this->producer_.tail, std::memory_order_release);
+      this->tail_.notify_one();
+    }
+
+
+    /*
+     * Consumer side; nullptr if the ring is empty
+     */
+    [[nodiscard]]
+    inline T *
+    try_front(void)
+    {
+      size_t head = this->consumer_.head;
+
+      if (head == this->consumer_.cached_tail) {
+        this->consumer_.cached_tail = this->tail_.load(std::memory_order_acquire);
+
+        if (head == this->consumer_.cached_tail)
+          return nullptr;
+      }
+
+      return &this->slots_[head & (N - 1)];
+    }
+
+    [[nodiscard]]
+    inline T *
+    front(void)
+    {
+      for (size_t spins = 0; ; spins++) {
+        if (T *slot = this->try_front(); slot != nullptr)
+          return slot;
+
+        if (spins < k_spin_limit_)
+          std::this_thread::yield();
+        else
+          this->tail_.wait(this->consumer_.cached_tail, std::memory_order_acquire);
+      }
+    }
+
+    inline void
+    pop(void)
+    {
+      this->head_.store(++this->consumer_.head, std::memory_order_release);
+      this->head_.notify_one();
+    }
+
+    /*
+     * Pops everything committed so far, which also wakes a producer waiting
+     * in reserve() (the ring being full then)
+     */
+    inline void
+    pop_all(void)
+    {
+      size_t tail = this->tail_.load(std::memory_order_acquire);
+
+      this->consumer_.head = tail;
+      this->consumer_.cached_tail = tail;
+
+      this->head_.store(tail, std::memory_order_release);
+      this->head_.notify_one();
+    }
+
+
+    /*
+     * Drops whatever is left; only while no producer is running
+     */
+    inline void
+    clear(void)
+    {
+      size_t tail = this->tail_.load(std::memory_order_acquire);
+
+      this->head_.store(tail, std::memory_order_release);
+
+      this->consumer_.head = tail;
+      this->consumer_.cached_tail = tail;
+      this->producer_.tail = tail;
+      this->producer_.cached_head = tail;
+    }
+
+
+  private:
+    static constexpr size_t k_cache_line_ = 64;
+    /* yields before reserve() and front() go to sleep */
+    static constexpr size_t k_spin_limit_ = 64;
+
+    std::unique_ptr< T[]> slots_;
+
+    alignas(k_cache_line_) std::atomic< size_t> head_ = 0;
+    alignas(k_cache_line_) std::atomic< size_t> tail_ = 0;
+
+    alignas(k_cache_line_) struct {
+      size_t tail = 0;
+      size_t cached_head = 0;
+    } producer_;
+
+    alignas(k_cache_line_) struct {
+      size_t head = 0;
+      size_t cached_tail = 0;
+    } consumer_;
+};
+
+
+} /* namespace QueequegLib */
+
+
+#endif /* !defined(_queequeg_qglib_spsc_ring_hh_) */
@@ -1,7 +1,14 @@
+
 #include <string>
 
+#include <stdint.h>
+
 #include <grapheme.h>
 
+#if defined(__SSSE3__)
+# include <immintrin.h>
+#endif
+
 #include "qglib/unicode.hh"
 
 
@@ -20,5 +27,199 @@ append_c32_as_utf8(std::string *s, char32_t ch)
 }
 
 
-} /* namespace QueequegLib */
+static inline bool
+is_cont(unsigned char b)
+{
+  return (b & 0xC0) == 0x80;
+}
+
+
+/*
+ * p must point to the start of a sequence (or of garbage)
+ */
+static char const *
+find_invalid_utf8_scalar(char const *p, char const *end)
+{
+  while (p < end) {
+    unsigned char const *s = reinterpret_cast<unsigned char const *>(p);
+    size_t left = end - p;
+    unsigned char lo = 0x80, hi = 0xBF;
+    size_t len;
+
+    if (s[0] < 0x80) {
+      ++p;
+      continue;
+    }
+
+    if (s[0] >= 0xC2 && s[0] <= 0xDF) {
+      len = 2;
+    } else if (s[0] >= 0xE0 && s[0] <= 0xEF) {
+      len = 3;
+      if (s[0] == 0xE0) lo = 0xA0; /* overlong */
+      if (s[0] == 0xED) hi = 0x9F; /* surrogates */
+    } else if (s[0] >= 0xF0 && s[0] <= 0xF4) {
+      len = 4;
+      if (s[0] == 0xF0) lo = 0x90; /* overlong */
+      if (s[0] == 0xF4) hi = 0x8F; /* > U+10FFFF */
+    } else {
+      return p;
+    }
+
+    if (left < len || s[1] < lo || s[1] > hi)
+      return p;
+
+    for (size_t i = 2; i < len; i++)
+      if (! is_cont(s[i]))
+        return p;
 
+    p += len;
+  }
+
+  return end;
+}
+
+
+#if defined(__SSSE3__)
+/*
+ * Lookup-table validation after Keiser & Lemire, "Validating UTF-8 In Less
+ * Than One Instruction Per Byte" (2021): every byte pair is classified by the
+ * high nibble of the first byte, its low nibble and the high nibble of the
+ * second one, and the three lookups are and-ed together. What remains flags an
+ * error, except for the third/fourth bytes of 3/4-byte sequences which are
+ * checked separately.
+ */
+
+enum : uint8_t {
+  TOO_SHORT   = 1 << 0, /* 11______ 0_______ / 11______ 11______ */
+  TOO_LONG    = 1 << 1, /* 0_______ 10______ */
+  OVERLONG_3  = 1 << 2, /* 11100000 100_____ */
+  TOO_LARGE   = 1 << 3, /* 11110100 1001____ and up */
+  SURROGATE   = 1 << 4, /* 11101101 101_____ */
+  OVERLONG_2  = 1 << 5, /* 1100000_ 10______ */
+  TOO_LARGE_1000 = 1 << 6, /* 11110101+ 1000____ */
+  OVERLONG_4  = 1 << 6, /* 11110000 1000____ */
+  TWO_CONTS   = 1 << 7, /* 10______ 10______ */
+  CARRY       = TOO_SHORT | TOO_LONG | TWO_CONTS,
+};
+
+
+static constexpr uint8_t k_byte_1_high_table[16] = {
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+  TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+  TOO_SHORT | OVERLONG_2,
+  TOO_SHORT,
+  TOO_SHORT | OVERLONG_3 | SURROGATE,
+  TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+
+static constexpr uint8_t k_byte_1_low_table[16] = {
+  CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+  CARRY | OVERLONG_2,
+  CARRY,
+  CARRY,
+  CARRY | TOO_LARGE,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+  CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+
+static constexpr uint8_t k_byte_2_high_table[16] = {
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+
+
+static inline __m128i
+load_table(uint8_t const table[16])
+{
+  return _mm_loadu_si128(reinterpret_cast<__m128i const *>(table));
+}
+
+
+static inline __m128i
+utf8_block_errors(__m128i input, __m128i prev_input)
+{
+  const __m128i nibble = _mm_set1_epi8(0x0F);
+
+  __m128i prev1 = _mm_alignr_epi8(input, prev_input, 16 - 1);
+  __m128i prev2 = _mm_alignr_epi8(input, prev_input, 16 - 2);
+  __m128i prev3 = _mm_alignr_epi8(input, prev_input, 16 - 3);
+
+  __m128i byte_1_high = _mm_shuffle_epi8(load_table(k_byte_1_high_table),
+                         _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  __m128i byte_1_low  = _mm_shuffle_epi8(load_table(k_byte_1_low_table),
+                         _mm_and_si128(prev1, nibble));
+  __m128i byte_2_high = _mm_shuffle_epi8(load_table(k_byte_2_high_table),
+                         _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+
+  __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+  /* the third and fourth bytes of 3- and 4-byte sequences must be continuations */
+  __m128i is_third_byte  = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+  __m128i is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+  __m128i must_be_2_3_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte),
+                                                   _mm_set1_epi8(static_cast<char>(0x80)));
+
+  return _mm_xor_si128(must_be_2_3_continuation, special_cases);
+}
+#endif /* defined(__SSSE3__) */
+
+
+[[nodiscard]]
+char const *
+find_invalid_utf8(char const *p, char const *end)
+{
+#if defined(__SSSE3__)
+  char const *start = p;
+  __m128i prev_input = _mm_setzero_si128();
+
+  while (end - p >= 16) {
+    __m128i input = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+
+    /*
+     * Pure ASCII blocks can only be invalid if the previous block ended in the
+     * middle of a sequence, i.e. with a non-ASCII byte among its last three.
+     */
+    if (_mm_movemask_epi8(input) != 0
+     || (_mm_movemask_epi8(prev_input) & 0xE000) != 0) {
+      __m128i errors = utf8_block_errors(input, prev_input);
+
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) != 0xFFFF)
+        break;
+    }
+
+    prev_input = input;
+    p += 16;
+  }
+
+  /*
+   * Pinpoint the error (or check the tail) from the start of the sequence
+   * straddling p; everything before it has been validated.
+   */
+  for (int i = 0; i < 3 && p > start
+       && is_cont(static_cast<unsigned char>(p[-1])); i++)
+    --p;
+
+  if (p > start && static_cast<unsigned char>(p[-1]) >= 0xC0)
+    --p;
+#endif
+
+  return find_invalid_utf8_scalar(p, end);
+}
+
+
+} /* namespace QueequegLib */
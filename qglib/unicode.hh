@@ -9,6 +9,14 @@ namespace QueequegLib {
 
   void append_c32_as_utf8(std::string *str, char32_t ch);
 
+  /*
+   * Returns a pointer to the first byte in [p, end) that does not start a
+   * well-formed UTF-8 sequence (as per Table 3-7 of the Unicode Standard:
+   * no overlongs, surrogates or codepoints above U+10FFFF, and no sequence
+   * cut short by end), or end if the whole range is valid.
+   */
+  [[nodiscard]] char const *find_invalid_utf8(char const *p, char const *end);
+
 };
 
 
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: tests/deep_tree.cc
+ *
+ * Description:
+ * Builds deep trees and drops them: one chain of nested elements, a million
+ * deep unless told otherwise, and documents parsed from markup that nests
+ * as deep, unclosed <div>s and <b><p> soup for the adoption agency algorithm
+ * (a fifth of the depth, each). Tearing a subtree down recursively would
+ * overflow the stack long before that (see DOM::Node::~Node()).
+ *
+ * Each tree is also made and dropped at twice its depth, and the driver fails
+ * if teardown then takes well over twice as long, i.e. isn't linear anymore.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "dom/core/document.hh"
+#include "dom/core/element.hh"
+
+#include "html/elements.hh"
+#include "html_parser/parser.hh"
+
+
+static size_t k_default_depth = 1000000;
+/* the parsed documents nest this many times less deep */
+static size_t k_parsed_depth_divisor = 5;
+
+/* teardown at twice the depth may take this many times longer */
+static double k_max_teardown_ratio = 3.0;
+/* below this, teardown is too quick to time reliably */
+static double k_min_timed_teardown = 0.010;
+static int k_runs = 3;
+
+
+struct tree_times {
+  double build;
+  double teardown;
+};
+
+
+typedef std::shared_ptr< DOM::Document> (*tree_builder_t) (enum dom_node_allocation node_allocation,
+                                                           size_t depth);
+
+
+[[noreturn]]
+static void
+usage(char const *argv0)
+{
+  fprintf(stderr, "usage: %s [-a] [depth]\n", argv0);
+  exit(1);
+}
+
+
+static double
+seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+static std::shared_ptr< DOM::Document>
+new_document(enum dom_node_allocation node_allocation)
+{
+  std::shared_ptr< DOM::Document> document =
+   std::make_shared<DOM::Document>(DOM_DOCUMENT_FORMAT_HTML, node_allocation);
+  document->node_document = std::static_pointer_cast<DOM::Document>(document->shared_from_this());
+
+  return document;
+}
+
+
+static std::shared_ptr< DOM::Document>
+build_chain(enum dom_node_allocation node_allocation, size_t depth)
+{
+  std::shared_ptr< DOM::Document> document = new_document(node_allocation);
+
+  /* only the tree holds on to the elements */
+  DOM::Node *parent = document.get();
+
+  for (size_t i = 0; i < depth; i++) {
+    std::shared_ptr< DOM::Element> element =
+     document->create_element(HTML_ELEMENT_DIV, INFRA_NAMESPACE_HTML);
+
+    parent->append_node(element);
+    parent = element.get();
+  }
+
+  return document;
+}
+
+
+static std::shared_ptr< DOM::Document>
+parse_repeated(enum dom_node_allocation node_allocation, char const *markup, size_t times)
+{
+  std::shared_ptr< DOM::Document> document = new_document(node_allocation);
+  std::string input;
+
+  input.reserve(strlen(markup) * times);
+
+  for (size_t i = 0; i < times; i++)
+    input.append(markup);
+
+  html_parse_document(document, input.data(), input.size());
+
+  return document;
+}
+
+
+static std::shared_ptr< DOM::Document>
+parse_unclosed_divs(enum dom_node_allocation node_allocation, size_t depth)
+{
+  return parse_repeated(node_allocation, "<div>", depth);
+}
+
+
+static std::shared_ptr< DOM::Document>
+parse_formatting_soup(enum dom_node_allocation node_allocation, size_t depth)
+{
+  return parse_repeated(node_allocation, "<b><p>", depth);
+}
+
+
+/*
+ * Best of k_runs
+ */
+static struct tree_times
+time_tree(tree_builder_t build, enum dom_node_allocation node_allocation, size_t depth)
+{
+  struct tree_times best = { 1e9, 1e9 };
+
+  for (int run = 0; run < k_runs; run++) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::shared_ptr< DOM::Document> document = build(node_allocation, depth);
+    best.build = std::min(best.build, seconds_since(start));
+
+    start = std::chrono::steady_clock::now();
+    document = nullptr;
+    best.teardown = std::min(best.teardown, seconds_since(start));
+  }
+
+  return best;
+}
+
+
+/*
+ * Returns whether teardown stayed linear
+ */
+static bool
+check_tree(char const *name, tree_builder_t build,
+           enum dom_node_allocation node_allocation, size_t depth)
+{
+  struct tree_times once  = time_tree(build, node_allocation, depth);
+  struct tree_times twice = time_tree(build, node_allocation, 2 * depth);
+
+  printf("%s: build %.3fs/%.3fs, teardown %.3fs/%.3fs (depth %zu/%zu)\n", name,
+         once.build, twice.build, once.teardown, twice.teardown, depth, 2 * depth);
+
+  if (twice.teardown >= k_min_timed_teardown
+   && twice.teardown > k_max_teardown_ratio * once.teardown) {
+    fprintf(stderr, "%s: teardown at twice the depth took %.1f times longer\n",
+            name, twice.teardown / once.teardown);
+    return false;
+  }
+
+  return true;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  enum dom_node_allocation node_allocation = DOM_NODE_ALLOCATION_HEAP;
+  size_t depth = k_default_depth;
+  int argi = 1;
+
+  if (argi < argc && !strcmp(argv[argi], "-a")) {
+    node_allocation = DOM_NODE_ALLOCATION_ARENA;
+    argi++;
+  }
+
+  if (argi < argc) {
+    char *end;
+
+    depth = strtoul(argv[argi++], &end, 10);
+    if (*end != '\0' || depth == 0)
+      usage(argv[0]);
+  }
+
+  if (argi != argc)
+    usage(argv[0]);
+
+
+  bool linear = true;
+
+  linear &= check_tree("chain", build_chain, node_allocation, depth);
+  linear &= check_tree("unclosed <div>s", parse_unclosed_divs, node_allocation,
+                       depth / k_parsed_depth_divisor);
+  linear &= check_tree("<b><p> soup", parse_formatting_soup, node_allocation,
+                       depth / k_parsed_depth_divisor);
+
+  return linear ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2024 Adrien Ricciardi
+ * This file is part of the queequeg distribution (https://github.com/rshadr/queequeg)
+ * See LICENSE for details
+ *
+ * File: tests/parse_modes.cc
+ *
+ * Description:
+ * Parses a few fixtures with html_parse_document() and again fed one byte
+ * at a time, pipelined and chunked, and fails unless every mode builds the
+ * same tree and reports the same parse errors at the same offsets. One of
+ * the fixtures is large enough for the chunked mode to actually cut it up.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "dom/core/comment.hh"
+#include "dom/core/document.hh"
+#include "dom/core/document_type.hh"
+#include "dom/core/element.hh"
+#include "dom/core/text.hh"
+
+#include "html_parser/parse_error.hh"
+#include "html_parser/parser.hh"
+
+
+enum parse_mode {
+  PARSE_SERIAL,
+  PARSE_BYTEWISE,
+  PARSE_PIPELINED,
+  PARSE_CHUNKED,
+
+  NUM_PARSE_MODES,
+};
+
+
+static char const * const k_parse_mode_names[NUM_PARSE_MODES] = {
+  "serial", "bytewise", "pipelined", "chunked",
+};
+
+
+static unsigned k_chunked_workers = 2;
+
+
+static char const * const k_fixtures[] = {
+  "<!DOCTYPE html><html><head><title>t &amp; t</title></head>"
+  "<body><p>one<p>two &notin; &notit; &#x41;&#65;&#0;</body></html>",
+
+  "<b>1<p>2</b>3</p><i><b><u>x</i>y</u></b> z",
+
+  "<div><custom-el a=1 a=2>c</custom-el><foo><bar>x</foo></bar></div>",
+
+  "<table><tr></tr>fé b\xc3\xa9\xe2\x82\xac<tr><td>x</td></tr> stray</table>",
+
+  "<html><frameset> x\xc3\xa9 <frame><noframes>n</noframes> y</frameset> z</html> after",
+
+  "</html> after <!-- c -->",
+
+  "<textarea>\nkept\r\nlines</textarea><pre>\n\nx</pre>",
+
+  "<script>if (a < b && c) document.write('</p>');</script>"
+  "<style>p { }</style><title>a<b</title>",
+
+  "<p>\xff\xfe broken \xc3 \xe2\x82 utf-8 \xed\xa0\x80 \xf4\x90\x80\x80</p>",
+
+  "<plaintext>everything <b>is</b> text &amp; stays",
+
+  "<!doctype html><![CDATA[x]]><!-- a -- b --!><?pi x?></p>",
+};
+
+
+/*
+ * Big enough to be cut into chunks, with text states running over chunk
+ * boundaries and start tags whose state the tokenizers have to guess
+ */
+static std::string
+make_large_fixture(void)
+{
+  static char const k_unit[] =
+    "<div class=a><p>para &amp; \xc3\xa9 <b>bold <i>both</b> italic</i>"
+    "<script>var s = '<p>' + 1 < 2;</script><!-- <p> -->"
+    "<textarea>\n<b>not bold</b></textarea><custom-el>c</custom-el>"
+    "<title>t<p></title></p></div>\n";
+
+  std::string input = "<!DOCTYPE html><html><body>";
+
+  while (input.size() < 2 * 1024 * 1024)
+    input.append(k_unit);
+
+  return input;
+}
+
+
+static void
+dump_node(std::string *out, DOM::Document const *document, DOM::Node const *node, int depth)
+{
+  out->append(2 * depth, ' ');
+
+  switch (node->node_type) {
+    case DOM_NODETYPE_ELEMENT: {
+      DOM::Element const *element = static_cast<DOM::Element const *>(node);
+      out->append("<");
+      out->append(document->local_name_string(element->local_name));
+      out->append(">");
+      break;
+    }
+
+    case DOM_NODETYPE_TEXT:
+      out->append("\"");
+      out->append(static_cast<DOM::Text const *>(node)->data);
+      out->append("\"");
+      break;
+
+    case DOM_NODETYPE_COMMENT:
+      out->append("<!-- ");
+      out->append(static_cast<DOM::Comment const *>(node)->data);
+      out->append(" -->");
+      break;
+
+    case DOM_NODETYPE_DOCUMENT_TYPE:
+      out->append("<!DOCTYPE ");
+      out->append(static_cast<DOM::DocumentType const *>(node)->name);
+      out->append(">");
+      break;
+
+    default:
+      out->append("?");
+      break;
+  }
+
+  out->append("\n");
+
+  for (DOM::Node *child = node->get_first_child(); child != nullptr; child = child->get_next_sibling())
+    dump_node(out, document, child, depth + 1);
+}
+
+
+static std::string
+parse_and_dump(std::string const& input, enum parse_mode mode)
+{
+  std::shared_ptr< DOM::Document> document = std::make_shared<DOM::Document>();
+  ParseErrorSink errors(PARSE_ERRORS_COLLECT);
+  std::string dump;
+
+  switch (mode) {
+    case PARSE_SERIAL:
+      html_parse_document(document, input.data(), input.size(), &errors);
+      break;
+
+    case PARSE_BYTEWISE: {
+      HTMLParser *parser = html_parser_open(document, &errors);
+
+      for (char const& c : input)
+        html_parser_feed(parser, &c, 1);
+
+      html_parser_finish(parser);
+      break;
+    }
+
+    case PARSE_PIPELINED:
+      html_parse_document_pipelined(document, input.data(), input.size(), &errors);
+      break;
+
+    case PARSE_CHUNKED:
+      html_parse_document_chunked(document, input.data(), input.size(),
+                                  k_chunked_workers, &errors);
+      break;
+
+    default:
+      abort();
+  }
+
+  for (DOM::Node *child = document->get_first_child(); child != nullptr; child = child->get_next_sibling())
+    dump_node(&dump, document.get(), child, 0);
+
+  for (auto const& error : errors.errors())
+    dump += std::to_string(error.offset) + ": " + parse_error_name(error.code) + "\n";
+
+  dump += "(" + std::to_string(errors.total()) + " parse errors)\n";
+
+  return dump;
+}
+
+
+/*
+ * Points at the first line the dumps disagree on
+ */
+static void
+report_difference(char const *name, enum parse_mode mode,
+                  std::string const& expected, std::string const& got)
+{
+  size_t at = 0;
+
+  while (at < expected.size() && at < got.size() && expected[at] == got[at])
+    at++;
+
+  size_t line_start = expected.rfind('\n', at);
+  line_start = (line_start == std::string::npos || line_start == at) ? 0 : line_start + 1;
+
+  size_t line_no = 1 + std::count(expected.begin(), expected.begin() + line_start, '\n');
+
+  fprintf(stderr, "%s: %s parse differs from serial at line %zu:\n", name,
+          k_parse_mode_names[mode], line_no);
+  fprintf(stderr, "  serial: %.*s\n", static_cast<int>(expected.find('\n', line_start) - line_start),
+          expected.c_str() + line_start);
+  fprintf(stderr, "  %s: %.*s\n", k_parse_mode_names[mode],
+          static_cast<int>(got.find('\n', line_start) - line_start), got.c_str() + line_start);
+}
+
+
+static bool
+check_fixture(char const *name, std::string const& input)
+{
+  std::string expected = parse_and_dump(input, PARSE_SERIAL);
+  bool same = true;
+
+  for (int mode = PARSE_SERIAL + 1; mode < NUM_PARSE_MODES; mode++) {
+    std::string got = parse_and_dump(input, static_cast<enum parse_mode>(mode));
+
+    if (got != expected) {
+      report_difference(name, static_cast<enum parse_mode>(mode), expected, got);
+      same = false;
+    }
+  }
+
+  return same;
+}
+
+
+int
+main(void)
+{
+  size_t n_fixtures = sizeof (k_fixtures) / sizeof (k_fixtures[0]);
+  size_t n_failed = 0;
+  char name[32];
+
+  for (size_t i = 0; i < n_fixtures; i++) {
+    snprintf(name, sizeof (name), "fixture %zu", i);
+
+    if (! check_fixture(name, k_fixtures[i]))
+      n_failed++;
+  }
+
+  if (! check_fixture("large fixture", make_large_fixture()))
+    n_failed++;
+
+  printf("parse modes: %zu of %zu fixtures agree\n", n_fixtures + 1 - n_failed, n_fixtures + 1);
+
+  return (n_failed == 0) ? 0 : 1;
+}